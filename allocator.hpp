@@ -0,0 +1,280 @@
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <stdlib.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "type_traits.hpp"
+
+/*
+* Allocators for the containers of this library, with the interface of
+* std::allocator.
+*
+* ft::realloc_allocator<T> gets its memory from malloc, or from mmap for the
+* blocks of mmap_threshold bytes and more, and adds the reallocate() member
+* that ft::vector tries before allocate + copy when its elements are
+* trivially copyable (see has_reallocate). A large block then grows with
+* mremap: the kernel moves page table entries instead of the bytes, and the
+* old and new buffers never both exist, so the peak RSS of a growing vector
+* stays at its capacity instead of 1.5 or 2 times it. Small blocks go
+* through realloc, which extends them in place when the heap allows.
+* Outside Linux every block comes from malloc.
+*
+* ft::aligned_allocator<T, Alignment, Options> aligns every block on
+* Alignment bytes (64 by default: a cache line, an AVX-512 register), for
+* SIMD loops over a vector's data(). Options, or-ed together:
+*	- alloc_huge_pages: blocks of huge_page_size bytes and more are aligned
+*	  and rounded to huge_page_size, and advised MADV_HUGEPAGE so that
+*	  transparent huge pages back them: one TLB entry per 2 MB instead of
+*	  512, for large tables read at random;
+*	- alloc_prefault: every page of a new block is written once at
+*	  allocation, which moves the page faults out of the first pass over it.
+* With ft::map the alignment applies to each node.
+*/
+
+namespace ft {
+
+template <typename T>
+class realloc_allocator
+{
+	public:
+		typedef T					value_type;
+		typedef T*					pointer;
+		typedef const T*			const_pointer;
+		typedef T&					reference;
+		typedef const T&			const_reference;
+		typedef std::size_t			size_type;
+		typedef std::ptrdiff_t		difference_type;
+
+		template <typename U>
+		struct rebind { typedef realloc_allocator<U> other; };
+
+		/* blocks from this size up are mappings of their own */
+		static const size_type		mmap_threshold = 1 << 20;
+
+		realloc_allocator() {}
+		template <typename U>
+		realloc_allocator(const realloc_allocator<U>&) {}
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		size_type max_size() const
+		{
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		pointer allocate(size_type n, const void* = 0)
+		{
+			if (n > max_size())
+				throw std::bad_alloc();
+			void* p = allocate_bytes(n * sizeof(T));
+			if (!p)
+				throw std::bad_alloc();
+			return static_cast<pointer>(p);
+		}
+
+		void deallocate(pointer p, size_type n)
+		{
+			if (!p)
+				return;
+			size_type bytes = n * sizeof(T);
+			if (mapped(bytes))
+				unmap(p, bytes);
+			else
+				std::free(p);
+		}
+
+		/*
+		* @brief -> resizes the block of p, from old_n to new_n elements, keeping
+		* the bytes of the first min(old_n, new_n). Only for T that can be moved
+		* as raw bytes.
+		* @return -> the block, which may have moved, or NULL when it cannot be
+		* resized without a copy by the caller: p is then still valid.
+		*/
+		pointer reallocate(pointer p, size_type old_n, size_type new_n)
+		{
+			if (new_n > max_size())
+				return NULL;
+			size_type old_bytes = old_n * sizeof(T);
+			size_type new_bytes = new_n * sizeof(T);
+			if (mapped(old_bytes) != mapped(new_bytes))
+				return NULL;
+			if (!mapped(new_bytes))
+				return static_cast<pointer>(std::realloc(p, new_bytes ? new_bytes : 1));
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+			void* q = mremap(p, page_round(old_bytes), page_round(new_bytes), MREMAP_MAYMOVE);
+			return q == MAP_FAILED ? NULL : static_cast<pointer>(q);
+#else
+			return NULL;
+#endif
+		}
+
+		void construct(pointer p, const T& value) { new (static_cast<void*>(p)) T(value); }
+		void destroy(pointer p) { p->~T(); }
+
+	private:
+		static size_type page_round(size_type bytes)
+		{
+			static const size_type page = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+			return (bytes + page - 1) / page * page;
+		}
+
+		/* the size of a block decides where it comes from, deallocate
+		* finds it back from n */
+		static bool mapped(size_type bytes)
+		{
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+			return bytes >= mmap_threshold;
+#else
+			(void)bytes;
+			return false;
+#endif
+		}
+
+		static void* allocate_bytes(size_type bytes)
+		{
+			if (!mapped(bytes))
+				return std::malloc(bytes ? bytes : 1);
+#if defined(__linux__)
+			void* p = mmap(NULL, page_round(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return p == MAP_FAILED ? NULL : p;
+#else
+			return NULL;
+#endif
+		}
+
+		static void unmap(pointer p, size_type bytes)
+		{
+#if defined(__linux__)
+			munmap(p, page_round(bytes));
+#else
+			(void)p;
+			(void)bytes;
+#endif
+		}
+};
+
+template <typename T, typename U>
+inline bool operator==(const realloc_allocator<T>&, const realloc_allocator<U>&) { return true; }
+
+template <typename T, typename U>
+inline bool operator!=(const realloc_allocator<T>&, const realloc_allocator<U>&) { return false; }
+
+/* construct and destroy are the copy constructor and the destructor */
+template <class T>
+struct is_plain_allocator<realloc_allocator<T> > : public true_type {};
+
+/* the Options of aligned_allocator */
+enum allocator_options
+{
+	alloc_huge_pages = 1,
+	alloc_prefault = 2
+};
+
+template <typename T, std::size_t Alignment = 64, unsigned Options = 0>
+class aligned_allocator
+{
+	public:
+		typedef T					value_type;
+		typedef T*					pointer;
+		typedef const T*			const_pointer;
+		typedef T&					reference;
+		typedef const T&			const_reference;
+		typedef std::size_t			size_type;
+		typedef std::ptrdiff_t		difference_type;
+
+		template <typename U>
+		struct rebind { typedef aligned_allocator<U, Alignment, Options> other; };
+
+		static const size_type		alignment = Alignment;
+		static const size_type		huge_page_size = 2 << 20;
+
+		aligned_allocator() {}
+		template <typename U>
+		aligned_allocator(const aligned_allocator<U, Alignment, Options>&) {}
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		size_type max_size() const
+		{
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		pointer allocate(size_type n, const void* = 0)
+		{
+			if (n > max_size())
+				throw std::bad_alloc();
+			size_type bytes = n * sizeof(T);
+			size_type align = block_alignment();
+			bool huge = (Options & alloc_huge_pages) && bytes >= huge_page_size;
+			if (huge)
+			{
+				align = huge_page_size;
+				bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+			}
+			void* p = NULL;
+			if (posix_memalign(&p, align, bytes ? bytes : 1) != 0)
+				throw std::bad_alloc();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+			if (huge)
+				madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+			if (Options & alloc_prefault)
+				prefault(static_cast<char*>(p), bytes);
+			return static_cast<pointer>(p);
+		}
+
+		void deallocate(pointer p, size_type)
+		{
+			std::free(p);
+		}
+
+		void construct(pointer p, const T& value) { new (static_cast<void*>(p)) T(value); }
+		void destroy(pointer p) { p->~T(); }
+
+	private:
+		/* posix_memalign takes powers of two only: fails to compile otherwise */
+		typedef char	alignment_must_be_a_power_of_two[
+			Alignment != 0 && (Alignment & (Alignment - 1)) == 0 ? 1 : -1];
+
+		/* Alignment, but never less than T's own or than posix_memalign accepts */
+		static size_type block_alignment()
+		{
+			size_type align = Alignment;
+			if (align < __alignof__(T))
+				align = __alignof__(T);
+			if (align < sizeof(void*))
+				align = sizeof(void*);
+			return align;
+		}
+
+		/* the memory is not initialized yet: writing zeros changes nothing */
+		static void prefault(char* p, size_type bytes)
+		{
+			static const size_type page = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+			for (size_type offset = 0; offset < bytes; offset += page)
+				static_cast<volatile char*>(p)[offset] = 0;
+		}
+};
+
+template <typename T, typename U, std::size_t A, unsigned O>
+inline bool operator==(const aligned_allocator<T, A, O>&, const aligned_allocator<U, A, O>&) { return true; }
+
+template <typename T, typename U, std::size_t A, unsigned O>
+inline bool operator!=(const aligned_allocator<T, A, O>&, const aligned_allocator<U, A, O>&) { return false; }
+
+template <class T, std::size_t A, unsigned O>
+struct is_plain_allocator<aligned_allocator<T, A, O> > : public true_type {};
+
+} //namespace
+
+#endif
@@ -0,0 +1,308 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include "type_traits.hpp"
+
+/*
+* Monotonic memory for the containers of one request.
+*
+* ft::arena hands out memory by bumping a pointer through chunks taken from
+* malloc, chunk_size bytes each (larger requests get a chunk of their own).
+* Nothing is freed one block at a time: reset() makes all of it available
+* again at once, keeping the chunks for the next request, and release() or
+* the destructor give the chunks back to malloc. The one exception is the
+* last block handed out, which can be given back or grown in place.
+*
+* ft::arena_allocator<T> is the Allocator parameter for ft::vector, ft::map
+* (or the std containers) on an arena:
+*	- deallocate() does nothing, except for the last block;
+*	- reallocate() grows the last block in place, so an ft::vector of
+*	  trivially copyable elements being filled does not leave its old
+*	  buffers behind (see has_reallocate);
+*	- the allocator stays with its container on assignment and swap, and a
+*	  copy of a container lives in the same arena. Allocators on different
+*	  arenas are unequal: swapping their containers copies the elements.
+* The containers must be gone, or cleared, before reset(). An arena is not
+* locked: one per thread, or per request.
+*/
+
+namespace ft {
+
+class arena
+{
+	public:
+		typedef std::size_t		size_type;
+
+		static const size_type	default_chunk_size = 64 * 1024;
+
+		explicit arena(size_type chunk_size = default_chunk_size) :
+			_chunk_size(chunk_size),
+			_first(NULL),
+			_current(NULL),
+			_cursor(NULL),
+			_end(NULL),
+			_allocated(0),
+			_reserved(0),
+			_chunks(0)
+		{}
+
+		~arena()
+		{
+			release();
+		}
+
+		/*
+		* @brief -> bytes of memory aligned on align, a power of two, valid
+		* until reset() or release().
+		* @throw -> std::bad_alloc when malloc fails.
+		*/
+		void* allocate(size_type bytes, size_type align = sizeof(void*) * 2)
+		{
+			/* the padding alone can pass the end of the chunk */
+			char* p = align_up(_cursor, align);
+			if (!_cursor || p > _end || bytes > static_cast<size_type>(_end - p))
+				p = refill(bytes, align);
+			_cursor = p + bytes;
+			_allocated += bytes;
+			return p;
+		}
+
+		/* gives the block back if it is the last one handed out, else nothing */
+		void deallocate(void* p, size_type bytes)
+		{
+			if (p && static_cast<char*>(p) + bytes == _cursor)
+			{
+				_cursor = static_cast<char*>(p);
+				_allocated -= bytes;
+			}
+		}
+
+		/*
+		* @brief -> resizes the block p of old_bytes to new_bytes, in place.
+		* @return -> false if p is not the last block handed out or its chunk
+		* lacks the room: p is then unchanged.
+		*/
+		bool extend(void* p, size_type old_bytes, size_type new_bytes)
+		{
+			char* block = static_cast<char*>(p);
+			if (!p || block + old_bytes != _cursor)
+				return false;
+			if (new_bytes > old_bytes && new_bytes - old_bytes > static_cast<size_type>(_end - _cursor))
+				return false;
+			_cursor = block + new_bytes;
+			_allocated = _allocated - old_bytes + new_bytes;
+			return true;
+		}
+
+		/* everything handed out is free again; the chunks of chunk_size bytes
+		* are kept for what comes next, the larger ones go back to malloc */
+		void reset()
+		{
+			chunk* kept = NULL;
+			chunk* c = _first;
+			_first = NULL;
+			while (c)
+			{
+				chunk* next = c->next;
+				if (c->size > _chunk_size)
+					free_chunk(c);
+				else
+				{
+					if (kept)
+						kept->next = c;
+					else
+						_first = c;
+					kept = c;
+					c->next = NULL;
+				}
+				c = next;
+			}
+			_current = NULL;
+			_cursor = _end = NULL;
+			_allocated = 0;
+		}
+
+		/* gives every chunk back to malloc */
+		void release()
+		{
+			while (_first)
+			{
+				chunk* next = _first->next;
+				free_chunk(_first);
+				_first = next;
+			}
+			_current = NULL;
+			_cursor = _end = NULL;
+			_allocated = 0;
+		}
+
+		/* bytes handed out since the last reset(), alignment padding excluded */
+		size_type bytes_allocated() const { return _allocated; }
+
+		/* bytes of the chunks held, their headers included */
+		size_type bytes_reserved() const { return _reserved; }
+
+		size_type chunks() const { return _chunks; }
+
+		size_type chunk_size() const { return _chunk_size; }
+
+	private:
+		/* the header of a chunk, its memory follows */
+		struct chunk
+		{
+			chunk*		next;
+			size_type	size;			/* header included */
+		};
+
+		static const size_type	header_size = (sizeof(chunk) + 15) & ~static_cast<size_type>(15);
+
+		size_type	_chunk_size;
+		chunk*		_first;
+		chunk*		_current;
+		char*		_cursor;
+		char*		_end;
+		size_type	_allocated;
+		size_type	_reserved;
+		size_type	_chunks;
+
+		arena(const arena&);
+		arena& operator=(const arena&);
+
+		static char* align_up(char* p, size_type align)
+		{
+			std::size_t address = reinterpret_cast<std::size_t>(p);
+			return p + ((align - address % align) % align);
+		}
+
+		static char* data(chunk* c) { return reinterpret_cast<char*>(c) + header_size; }
+
+		/* moves to the next kept chunk, or links a new one after the current */
+		char* refill(size_type bytes, size_type align)
+		{
+			chunk* next = _current ? _current->next : _first;
+			if (next && fits(next, bytes, align))
+				return enter(next, align);
+
+			size_type size = _chunk_size;
+			if (bytes > std::numeric_limits<size_type>::max() - header_size - align)
+				throw std::bad_alloc();
+			if (header_size + bytes + align > size)
+				size = header_size + bytes + align;
+			chunk* c = static_cast<chunk*>(std::malloc(size));
+			if (!c)
+				throw std::bad_alloc();
+			c->size = size;
+			c->next = next;
+			if (_current)
+				_current->next = c;
+			else
+				_first = c;
+			_reserved += size;
+			++_chunks;
+			return enter(c, align);
+		}
+
+		static bool fits(chunk* c, size_type bytes, size_type align)
+		{
+			char* end = reinterpret_cast<char*>(c) + c->size;
+			char* p = align_up(data(c), align);
+			return p <= end && bytes <= static_cast<size_type>(end - p);
+		}
+
+		char* enter(chunk* c, size_type align)
+		{
+			_current = c;
+			_end = reinterpret_cast<char*>(c) + c->size;
+			return align_up(data(c), align);
+		}
+
+		void free_chunk(chunk* c)
+		{
+			_reserved -= c->size;
+			--_chunks;
+			std::free(c);
+		}
+};
+
+template <typename T>
+class arena_allocator
+{
+	public:
+		typedef T					value_type;
+		typedef T*					pointer;
+		typedef const T*			const_pointer;
+		typedef T&					reference;
+		typedef const T&			const_reference;
+		typedef std::size_t			size_type;
+		typedef std::ptrdiff_t		difference_type;
+
+		template <typename U>
+		struct rebind { typedef arena_allocator<U> other; };
+
+		/* without an arena, allocate() throws std::bad_alloc */
+		arena_allocator() : _arena(NULL) {}
+		arena_allocator(arena& a) : _arena(&a) {}
+		template <typename U>
+		arena_allocator(const arena_allocator<U>& other) : _arena(other.get_arena()) {}
+
+		arena* get_arena() const { return _arena; }
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		size_type max_size() const
+		{
+			return std::numeric_limits<size_type>::max() / 2 / sizeof(T);
+		}
+
+		pointer allocate(size_type n, const void* = 0)
+		{
+			if (!_arena || n > max_size())
+				throw std::bad_alloc();
+			return static_cast<pointer>(_arena->allocate(n * sizeof(T), __alignof__(T)));
+		}
+
+		void deallocate(pointer p, size_type n)
+		{
+			if (_arena)
+				_arena->deallocate(p, n * sizeof(T));
+		}
+
+		/* the last block grows or shrinks in place, NULL otherwise */
+		pointer reallocate(pointer p, size_type old_n, size_type new_n)
+		{
+			if (!_arena || new_n > max_size() || !_arena->extend(p, old_n * sizeof(T), new_n * sizeof(T)))
+				return NULL;
+			return p;
+		}
+
+		void construct(pointer p, const T& value) { new (static_cast<void*>(p)) T(value); }
+		void destroy(pointer p) { p->~T(); }
+
+	private:
+		arena*		_arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs)
+{
+	return lhs.get_arena() == rhs.get_arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs)
+{
+	return lhs.get_arena() != rhs.get_arena();
+}
+
+template <class T>
+struct is_plain_allocator<arena_allocator<T> > : public true_type {};
+
+} //namespace
+
+#endif
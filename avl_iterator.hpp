@@ -5,6 +5,35 @@
 #include <cstddef>
 
 namespace ft {
+
+/* Links of a tree node. The end() sentinel of a map is a bare map_node_base
+* embedded in the map: it holds no value, so it costs no allocation and does
+* not need a default constructible key or mapped type.
+*	header.parent -> root (NULL when empty), root->parent -> header
+*	header.left() -> leftmost node, header.right() -> rightmost node
+*	(both -> header when empty); missing children are NULL.
+* The children are an array so that a descent can index it with the result
+* of a comparison instead of branching on it. */
+struct map_node_base
+{
+	typedef map_node_base*	base_pointer;
+
+	base_pointer	parent;
+	base_pointer	child[2]; /*[0] left, [1] right*/
+	int				rank; /*balancing policy data, see map_balance.hpp*/
+
+	base_pointer& left() { return child[0]; }
+	base_pointer left() const { return child[0]; }
+	base_pointer& right() { return child[1]; }
+	base_pointer right() const { return child[1]; }
+};
+
+template <typename Value>
+struct map_node : public map_node_base
+{
+	Value			value; /*holds the key in first*/
+};
+
 template <typename Key, typename T, typename Compare, typename Node>
 	class map_iterator;
 
@@ -25,18 +54,19 @@ template <typename Key, typename T, typename Compare, typename Node>
 			typedef value_type&											reference;
 			typedef value_type*											pointer;
 			
-			typedef const_map_iterator<const Key, T, Compare, Node>		const_iterator;
+			typedef const_map_iterator<Key, T, Compare, Node>			const_iterator;
 			typedef Node*												node_pointer;
+			typedef map_node_base*										base_pointer;
 
 		private:
-			node_pointer												_current_ptr;
-			node_pointer												_end;
+			base_pointer												_current_ptr;
+			base_pointer												_end;
 			key_compare													_comp;
 
 
 		public:
 			/* -- CONSTRUCTORS - DESTRUCTORS -- */	
-			map_iterator(node_pointer node = NULL, node_pointer end = NULL, const key_compare& comp = key_compare()):
+			map_iterator(base_pointer node = NULL, base_pointer end = NULL, const key_compare& comp = key_compare()):
 			_current_ptr(node), 
 			_end(end), 
 			_comp(comp) 
@@ -69,16 +99,15 @@ template <typename Key, typename T, typename Compare, typename Node>
 				return *this;
 			}
 			
-			node_pointer getNode() const { return _current_ptr; }
-			node_pointer getEnd() const { return _end; }
+			base_pointer getNode() const { return _current_ptr; }
+			base_pointer getEnd() const { return _end; }
 			key_compare getComp() const { return _comp; }
 
 
-			node_pointer base() { return _current_ptr; }
-			const node_pointer base() const { return _current_ptr; }
+			base_pointer base() const { return _current_ptr; }
 
-			reference operator*() const { return _current_ptr->value; }
-			pointer operator->() const { return &_current_ptr->value; }
+			reference operator*() const { return static_cast<node_pointer>(_current_ptr)->value; }
+			pointer operator->() const { return &static_cast<node_pointer>(_current_ptr)->value; }
 
 			map_iterator& operator++()
 			{
@@ -109,54 +138,65 @@ template <typename Key, typename T, typename Compare, typename Node>
 			}
 
 			bool operator==(const map_iterator& x) const { return x._current_ptr == _current_ptr; }
-			bool operator==(const const_iterator& x) const { return _current_ptr != x._current_ptr; }
+			bool operator==(const const_iterator& x) const { return _current_ptr == x.base(); }
 
 			bool operator!=(const map_iterator& x) const { return !(*this == x); }
 			bool operator!=(const const_iterator& x) const { return !(*this == x); }
 
 		private:
 			/*find the node with the maximum key*/
-		node_pointer maximum(node_pointer node)
+		static base_pointer maximum(base_pointer node)
 		{
-			if (node && node != _end && node->right && node->right != _end)
-				return maximum(node->right);
+			while (node->right())
+				node = node->right();
 			return node;
 		}
 
 		/*find the node with the minimum key*/
-		node_pointer minimum(node_pointer node)
+		static base_pointer minimum(base_pointer node)
 		{
-			if (node && node != _end && node->left && node->left != _end)
-				return minimum(node->left);
+			while (node->left())
+				node = node->left();
 			return node;
 		}
 
 		/* find the successor of a given node : if the right subtree != null
  		 * the successor is the leftmost node in the right subtree;
- 		 * else it is the lowest ancestor of the node;
+ 		 * else it is the lowest ancestor of the node whose left subtree holds it.
+ 		 * The root and the sentinel are each other's parent, which stops the climb
+ 		 * after the last node on the sentinel: it is remembered as _end, so an
+ 		 * iterator that followed its element through swap() still finds its way
+ 		 * back from end(). end() wraps around to begin().
  		*/
- 		node_pointer successor(node_pointer node)
+ 		base_pointer successor(base_pointer node)
  		{
- 			if(node->right != NULL)
- 				return minimum(node->right);
- 			node_pointer parent = node->parent;
- 			while (parent != NULL && node == parent->right)
+ 			if (node == _end)
+ 				return _end->left();
+ 			if(node->right() != NULL)
+ 				return minimum(node->right());
+ 			base_pointer parent = node->parent;
+ 			while (parent->parent != node && node == parent->right())
  			{
  				node = parent;
  				parent = parent->parent;
  			}
+ 			if (parent->parent == node)
+ 				_end = parent;
  			return parent;
  		}
 
- 		/* find the predecessor of a given node: if the left subtree != null
- 		 * the predecessor is the rightmost node in the left subtree
+		/* find the predecessor of a given node: if the left subtree != null
+ 		 * the predecessor is the rightmost node in the left subtree;
+ 		 * end() leads to the last node.
  		*/
- 		node_pointer predecessor(node_pointer node)
+ 		base_pointer predecessor(base_pointer node) const
  		{
- 			if(node->left != NULL)
- 				return maximum(node->left);
- 			node_pointer parent = node->parent;
- 			while(parent != NULL && node == parent->left)
+ 			if (node == _end)
+ 				return _end->right();
+ 			if(node->left() != NULL)
+ 				return maximum(node->left());
+ 			base_pointer parent = node->parent;
+ 			while(parent->parent != node && node == parent->left())
  			{
  				node = parent;
  				parent = parent->parent;
@@ -182,16 +222,17 @@ template <typename Key, typename T, typename Compare, typename Node>
 			typedef value_type*										pointer;
 			
 			typedef Node*											node_pointer;
+			typedef map_node_base*									base_pointer;
 
 		private:
-			node_pointer											_current_ptr;
-			node_pointer											_end;
+			base_pointer											_current_ptr;
+			base_pointer											_end;
 			key_compare												_comp;
 
 
 		public:
 			/* -- CONSTRUCTORS - DESTRUCTORS -- */	
-			const_map_iterator(node_pointer node = NULL, node_pointer end = NULL, const key_compare& comp = key_compare()):
+			const_map_iterator(base_pointer node = NULL, base_pointer end = NULL, const key_compare& comp = key_compare()):
 			_current_ptr(node), 
 			_end(end), 
 			_comp(comp) 
@@ -213,16 +254,15 @@ template <typename Key, typename T, typename Compare, typename Node>
 			
 			~const_map_iterator() {}
 			
-			node_pointer getNode() const { return _current_ptr; }
-			node_pointer getEnd() const { return _end; }
+			base_pointer getNode() const { return _current_ptr; }
+			base_pointer getEnd() const { return _end; }
 			key_compare getComp() const { return _comp; }
 
 
-			node_pointer base() { return _current_ptr; }
-			node_pointer base() const { return _current_ptr; }
+			base_pointer base() const { return _current_ptr; }
 
-			reference operator*() const { return _current_ptr->value; }
-			pointer operator->() const { return &_current_ptr->value; }
+			reference operator*() const { return static_cast<node_pointer>(_current_ptr)->value; }
+			pointer operator->() const { return &static_cast<node_pointer>(_current_ptr)->value; }
 
 			const_map_iterator& operator++()
 			{
@@ -264,47 +304,58 @@ template <typename Key, typename T, typename Compare, typename Node>
 
 		private:
 			/*find the node with the maximum key*/
-		node_pointer maximum(node_pointer node)
+		static base_pointer maximum(base_pointer node)
 		{
-			if (node && node != _end && node->right && node->right != _end)
-				return maximum(node->right);
+			while (node->right())
+				node = node->right();
 			return node;
 		}
 
 		/*find the node with the minimum key*/
-		node_pointer minimum(node_pointer node)
+		static base_pointer minimum(base_pointer node)
 		{
-			if (node && node != _end && node->left && node->left != _end)
-				return minimum(node->left);
+			while (node->left())
+				node = node->left();
 			return node;
 		}
 
 		/* find the successor of a given node : if the right subtree != null
  		 * the successor is the leftmost node in the right subtree;
- 		 * else it is the lowest ancestor of the node;
+ 		 * else it is the lowest ancestor of the node whose left subtree holds it.
+ 		 * The root and the sentinel are each other's parent, which stops the climb
+ 		 * after the last node on the sentinel: it is remembered as _end, so an
+ 		 * iterator that followed its element through swap() still finds its way
+ 		 * back from end(). end() wraps around to begin().
  		*/
- 		node_pointer successor(node_pointer node)
+ 		base_pointer successor(base_pointer node)
  		{
- 			if(node->right != NULL)
- 				return minimum(node->right);
- 			node_pointer parent = node->parent;
- 			while (parent != NULL && node == parent->right)
+ 			if (node == _end)
+ 				return _end->left();
+ 			if(node->right() != NULL)
+ 				return minimum(node->right());
+ 			base_pointer parent = node->parent;
+ 			while (parent->parent != node && node == parent->right())
  			{
  				node = parent;
  				parent = parent->parent;
  			}
+ 			if (parent->parent == node)
+ 				_end = parent;
  			return parent;
  		}
 
- 		/* find the predecessor of a given node: if the left subtree != null
- 		 * the predecessor is the rightmost node in the left subtree
+		/* find the predecessor of a given node: if the left subtree != null
+ 		 * the predecessor is the rightmost node in the left subtree;
+ 		 * end() leads to the last node.
  		*/
- 		node_pointer predecessor(node_pointer node)
+ 		base_pointer predecessor(base_pointer node) const
  		{
- 			if(node->left != NULL)
- 				return maximum(node->left);
- 			node_pointer parent = node->parent;
- 			while(parent != NULL && node == parent->left)
+ 			if (node == _end)
+ 				return _end->right();
+ 			if(node->left() != NULL)
+ 				return maximum(node->left());
+ 			base_pointer parent = node->parent;
+ 			while(parent->parent != node && node == parent->left())
  			{
  				node = parent;
  				parent = parent->parent;
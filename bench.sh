@@ -0,0 +1,30 @@
+#!/bin/bash
+
+# Builds the benchmarks of bench/ with optimizations and runs them.
+# usage: ./bench.sh <name> [arguments passed to the benchmark]
+# CXX overrides the compiler (clang++ by default, like test.sh).
+
+bench_dir="bench"
+output_dir="bench/output"
+
+cxx="${CXX:-clang++}"
+flags="-O2 -DNDEBUG -Wall -Wextra -pthread"
+
+mkdir -p "$output_dir"
+
+if [ $# -lt 1 ]; then
+	echo "choose one benchmark:" $(ls "$bench_dir"/*.cpp | xargs -n1 basename | sed 's/\.cpp$//')
+	exit 1
+fi
+
+name="$1"
+shift
+src="$bench_dir/$name.cpp"
+
+if [ ! -f "$src" ]; then
+	echo "no such benchmark: $name"
+	exit 1
+fi
+
+$cxx $flags "$src" -o "$output_dir/$name.out" || exit 1
+./"$output_dir/$name.out" "$@"
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "bench.hpp"
+#include "../allocator.hpp"
+#include "../vector.hpp"
+
+/*
+* ft::aligned_allocator on a large table of longs read at random: huge pages
+* against the 4 KB pages of std::allocator, and where alloc_prefault moves
+* the page faults.
+* usage: ./bench.sh aligned_allocator [megabytes] [random reads]
+* "allocate" is resize_default_init alone, "first pass" the write of every
+* element after it, "random" the ns per read of random elements, "THP" the
+* anonymous huge pages of the process with the table alive, read from
+* /proc/self/smaps_rollup (transparent_hugepage must be madvise or always).
+*/
+
+static long huge_pages_mb()
+{
+	FILE* f = std::fopen("/proc/self/smaps_rollup", "r");
+	char line[256];
+	long kb = -1024;
+
+	if (!f)
+		return -1;
+	while (std::fgets(line, sizeof(line), f))
+		if (std::sscanf(line, "AnonHugePages: %ld kB", &kb) == 1)
+			break;
+	std::fclose(f);
+	return kb / 1024;
+}
+
+template <typename Vector>
+static void run(const char* name, long megabytes, long reads)
+{
+	const std::size_t n = static_cast<std::size_t>(megabytes) * (1 << 20) / sizeof(long);
+	Vector table;
+
+	double start = bench::now();
+	table.resize_default_init(n);
+	double allocated = bench::now();
+	for (std::size_t i = 0; i < n; ++i)
+		table[i] = static_cast<long>(i);
+	double written = bench::now();
+
+	bench::rng random(3);
+	long sum = 0;
+	double read_start = bench::now();
+	for (long i = 0; i < reads; ++i)
+		sum += table[random() % n];
+	double read_end = bench::now();
+	bench::do_not_optimize(sum);
+	std::printf("%-40s %10.1f %12.1f %10.1f %8ld\n", name, (allocated - start) * 1e3, (written - allocated) * 1e3,
+		(read_end - read_start) / reads * 1e9, huge_pages_mb());
+}
+
+int main(int argc, char** argv)
+{
+	long megabytes = bench::arg(argc, argv, 1, 1024);
+	long reads = bench::arg(argc, argv, 2, 20000000);
+
+	std::printf("a table of %ld MB of longs, %ld random reads; ms, ns per read, MB\n\n", megabytes, reads);
+	std::printf("%-40s %10s %12s %10s %8s\n", "", "allocate", "first pass", "random", "THP");
+	run<ft::vector<long> >("std::allocator", megabytes, reads);
+	run<ft::vector<long, ft::aligned_allocator<long, 64> > >("aligned_allocator 64", megabytes, reads);
+	run<ft::vector<long, ft::aligned_allocator<long, 64, ft::alloc_huge_pages> > >("aligned_allocator huge pages",
+		megabytes, reads);
+	run<ft::vector<long, ft::aligned_allocator<long, 64, ft::alloc_prefault> > >("aligned_allocator prefault",
+		megabytes, reads);
+	run<ft::vector<long, ft::aligned_allocator<long, 64, ft::alloc_huge_pages | ft::alloc_prefault> > >(
+		"aligned_allocator huge pages + prefault", megabytes, reads);
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "bench.hpp"
+#include "../arena.hpp"
+#include "../map.hpp"
+#include "../vector.hpp"
+
+/*
+* A request handler's temporaries on std::allocator and on ft::arena: per
+* request, a map of 24 headers, a vector of 64 to 2048 tokens, 6 scratch
+* vectors of 16 to 256 doubles and a map indexing an eighth of the tokens,
+* all destroyed at the end of the request; the arena is reset then.
+* usage: ./bench.sh arena [requests] [chunk size]
+* "new / request" counts the calls to operator new, "chunks" the mallocs of
+* the arena over the whole run.
+*/
+
+static unsigned long	g_news = 0;
+
+void* operator new(std::size_t size)
+{
+	++g_news;
+	void* p = std::malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) throw()
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) throw()
+{
+	std::free(p);
+}
+
+template <typename T>
+struct heap
+{
+	typedef std::allocator<T>		type;
+	static type make(ft::arena&) { return type(); }
+};
+
+template <typename T>
+struct on_arena
+{
+	typedef ft::arena_allocator<T>	type;
+	static type make(ft::arena& a) { return type(a); }
+};
+
+template <template <typename> class Alloc>
+static long handle(ft::arena& arena, bench::rng& random)
+{
+	typedef typename Alloc<ft::pair<const int, long> >::type		header_alloc;
+	typedef typename Alloc<ft::pair<const int, int> >::type			index_alloc;
+	typedef typename Alloc<int>::type								int_alloc;
+	typedef typename Alloc<double>::type							double_alloc;
+
+	long sum = 0;
+	ft::map<int, long, std::less<int>, header_alloc> headers(std::less<int>(),
+		Alloc<ft::pair<const int, long> >::make(arena));
+	for (int i = 0; i < 24; ++i)
+		headers[static_cast<int>(random() % 1000)] = i;
+
+	ft::vector<int, int_alloc> tokens(Alloc<int>::make(arena));
+	int count = 64 + static_cast<int>(random() % 1985);
+	for (int i = 0; i < count; ++i)
+		tokens.push_back(static_cast<int>(random() % 100000));
+
+	for (int s = 0; s < 6; ++s)
+	{
+		ft::vector<double, double_alloc> scratch(Alloc<double>::make(arena));
+		int n = 16 + static_cast<int>(random() % 241);
+		for (int i = 0; i < n; ++i)
+			scratch.push_back(i * 0.5);
+		sum += static_cast<long>(scratch.back());
+	}
+
+	ft::map<int, int, std::less<int>, index_alloc> index(std::less<int>(),
+		Alloc<ft::pair<const int, int> >::make(arena));
+	for (std::size_t i = 0; i < tokens.size(); i += 8)
+		index.insert(ft::make_pair(tokens[i], static_cast<int>(i)));
+
+	sum += static_cast<long>(headers.size() + index.size()) + tokens.back();
+	return sum;
+}
+
+template <template <typename> class Alloc>
+static void run(const char* name, long requests, std::size_t chunk_size)
+{
+	ft::arena arena(chunk_size);
+	bench::rng random(11);
+	long sum = 0;
+	std::size_t peak = 0;
+
+	unsigned long news = g_news;
+	double start = bench::now();
+	for (long r = 0; r < requests; ++r)
+	{
+		sum += handle<Alloc>(arena, random);
+		if (arena.bytes_allocated() > peak)
+			peak = arena.bytes_allocated();
+		arena.reset();
+	}
+	double end = bench::now();
+	news = g_news - news;
+	bench::do_not_optimize(sum);
+	std::printf("%-20s %12.0f %14.1f %8lu %12lu\n", name, (end - start) / requests * 1e9,
+		static_cast<double>(news) / requests, static_cast<unsigned long>(arena.chunks()),
+		static_cast<unsigned long>(peak / 1024));
+}
+
+int main(int argc, char** argv)
+{
+	long requests = bench::arg(argc, argv, 1, 200000);
+	std::size_t chunk_size = static_cast<std::size_t>(bench::arg(argc, argv, 2, 64 * 1024));
+
+	std::printf("%ld requests, chunks of %lu bytes\n\n", requests, static_cast<unsigned long>(chunk_size));
+	std::printf("%-20s %12s %14s %8s %12s\n", "", "ns / request", "new / request", "chunks", "peak KB");
+	run<heap>("std::allocator", requests, chunk_size);
+	run<on_arena>("ft::arena", requests, chunk_size);
+	return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <time.h>
+
+/* Small helpers shared by the benchmarks of this directory. */
+
+namespace bench {
+
+	/* monotonic wall clock, in seconds */
+	inline double now()
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec + ts.tv_nsec * 1e-9;
+	}
+
+	/* argv[index] as a number, or fallback when absent */
+	inline long arg(int argc, char** argv, int index, long fallback)
+	{
+		if (index < argc)
+			return std::atol(argv[index]);
+		return fallback;
+	}
+
+	/* keeps the optimizer from dropping a computed result */
+	template <typename T>
+	inline void do_not_optimize(const T& value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	/* cheap deterministic pseudo random sequence (xorshift64) */
+	struct rng
+	{
+		unsigned long long	state;
+
+		explicit rng(unsigned long long seed = 88172645463325252ULL) : state(seed) {}
+
+		unsigned long long operator()()
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <map>
+
+#include "bench.hpp"
+#include "../compact_map.hpp"
+#include "../map.hpp"
+
+/*
+* ft::compact_map against ft::map and std::map, map<int, int>.
+* usage: ./bench.sh compact_map [elements] [look-ups]
+* Bytes per element are what the map asks from its allocator (std::map: the
+* libstdc++ node size) divided by the number of elements.
+*/
+
+template <typename Map>
+static std::size_t heap_bytes(const Map& map) { return map.memory_usage() - sizeof(map); }
+
+static std::size_t heap_bytes(const std::map<int, int>& map)
+{
+	return map.size() * (4 * sizeof(void*) + sizeof(std::pair<const int, int>));
+}
+
+template <typename Map>
+static void run(const char* name, long elements, long lookups)
+{
+	Map map;
+	bench::rng random;
+
+	double start = bench::now();
+	for (long i = 0; i < elements; ++i)
+		map[static_cast<int>(random() % (elements * 2))] = static_cast<int>(i);
+	double insert_time = bench::now() - start;
+
+	long found = 0;
+	start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.count(static_cast<int>(random() % (elements * 2)));
+	double find_time = bench::now() - start;
+
+	long sum = 0;
+	start = bench::now();
+	for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it)
+		sum += it->second;
+	double scan_time = bench::now() - start;
+
+	bench::do_not_optimize(found + sum);
+	std::printf("%-16s %12.2f %12.2f %12.1f %12.1f\n", name,
+		elements / insert_time / 1e6, lookups / find_time / 1e6,
+		map.size() / scan_time / 1e6, static_cast<double>(heap_bytes(map)) / map.size());
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 1000000);
+	long lookups = bench::arg(argc, argv, 2, 2000000);
+
+	std::printf("%ld random inserts, %ld look-ups, then one in-order scan\n\n", elements, lookups);
+	std::printf("%-16s %12s %12s %12s %12s\n", "map<int, int>", "Minserts/s", "Mfinds/s", "Mscan/s", "bytes/elem");
+	run<ft::map<int, int> >("ft::map", elements, lookups);
+	run<ft::compact_map<int, int> >("ft::compact_map", elements, lookups);
+	run<std::map<int, int> >("std::map", elements, lookups);
+	return 0;
+}
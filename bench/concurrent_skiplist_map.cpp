@@ -0,0 +1,173 @@
+#include <cstdio>
+#include <pthread.h>
+
+#include "bench.hpp"
+#include "../concurrent_skiplist_map.hpp"
+#include "../map.hpp"
+
+/*
+* Write scalability of ft::concurrent_skiplist_map against an ft::map behind
+* a mutex, map<long, long>.
+* usage: ./bench.sh concurrent_skiplist_map [inserts] [max writers] [readers]
+* The inserts (random keys) are split between 1, 2, 4... max writers while
+* the readers run range scans: a lower_bound at random and the 100 next
+* elements. Both rates are totals over all threads, in millions per second.
+* The scaling needs as many cores as threads.
+*/
+
+/* the locked ft::map, with the interface the threads use */
+class locked_map
+{
+	private:
+		ft::map<long, long>		_map;
+		pthread_mutex_t			_mutex;
+
+	public:
+		locked_map() { pthread_mutex_init(&_mutex, NULL); }
+		~locked_map() { pthread_mutex_destroy(&_mutex); }
+
+		void insert(long key)
+		{
+			pthread_mutex_lock(&_mutex);
+			_map.insert(ft::make_pair(key, key));
+			pthread_mutex_unlock(&_mutex);
+		}
+
+		long scan(long from, long count)
+		{
+			long sum = 0;
+			pthread_mutex_lock(&_mutex);
+			ft::map<long, long>::const_iterator it = _map.lower_bound(from);
+			for (long i = 0; i < count && it != _map.end(); ++i, ++it)
+				sum += it->second;
+			pthread_mutex_unlock(&_mutex);
+			return sum;
+		}
+};
+
+class skiplist_map
+{
+	private:
+		typedef ft::concurrent_skiplist_map<long, long>	map_type;
+
+		map_type				_map;
+
+	public:
+		void insert(long key)
+		{
+			_map.insert(ft::make_pair(key, key));
+		}
+
+		long scan(long from, long count)
+		{
+			long sum = 0;
+			map_type::guard pin(_map);
+			map_type::const_iterator it = _map.lower_bound(from);
+			for (long i = 0; i < count && it != _map.end(); ++i, ++it)
+				sum += it->second;
+			return sum;
+		}
+};
+
+template <typename Map>
+struct shared
+{
+	Map*			map;
+	long			inserts;
+	volatile int	stop;
+	long			scanned[64];
+};
+
+template <typename Map>
+struct thread_arg
+{
+	shared<Map>*	state;
+	long			id;
+};
+
+template <typename Map>
+static void* writer(void* p)
+{
+	thread_arg<Map>* arg = static_cast<thread_arg<Map>*>(p);
+	bench::rng random(arg->id * 7919 + 1);
+
+	for (long i = 0; i < arg->state->inserts; ++i)
+		arg->state->map->insert(static_cast<long>(random() >> 1));
+	return NULL;
+}
+
+template <typename Map>
+static void* reader(void* p)
+{
+	thread_arg<Map>* arg = static_cast<thread_arg<Map>*>(p);
+	bench::rng random(arg->id * 104729 + 1);
+	long scanned = 0;
+	long sum = 0;
+
+	while (!__atomic_load_n(&arg->state->stop, __ATOMIC_RELAXED))
+	{
+		sum += arg->state->map->scan(static_cast<long>(random() >> 1), 100);
+		scanned += 100;
+	}
+	bench::do_not_optimize(sum);
+	arg->state->scanned[arg->id] = scanned;
+	return NULL;
+}
+
+template <typename Map>
+static void run(const char* name, long inserts, long writers, long readers)
+{
+	Map map;
+	shared<Map> state;
+	pthread_t threads[128];
+	thread_arg<Map> args[128];
+
+	state.map = &map;
+	state.inserts = inserts / writers;
+	state.stop = 0;
+	for (long r = 0; r < readers; ++r)
+	{
+		args[r].state = &state;
+		args[r].id = r;
+		pthread_create(&threads[r], NULL, reader<Map>, &args[r]);
+	}
+	double start = bench::now();
+	for (long w = 0; w < writers; ++w)
+	{
+		args[readers + w].state = &state;
+		args[readers + w].id = w;
+		pthread_create(&threads[readers + w], NULL, writer<Map>, &args[readers + w]);
+	}
+	for (long w = 0; w < writers; ++w)
+		pthread_join(threads[readers + w], NULL);
+	double elapsed = bench::now() - start;
+	__atomic_store_n(&state.stop, 1, __ATOMIC_RELAXED);
+	long scanned = 0;
+	for (long r = 0; r < readers; ++r)
+	{
+		pthread_join(threads[r], NULL);
+		scanned += state.scanned[r];
+	}
+	std::printf("%-28s %8ld %12.2f %12.2f\n", name, writers,
+		state.inserts * writers / elapsed / 1e6, scanned / elapsed / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+	long inserts = bench::arg(argc, argv, 1, 1000000);
+	long max_writers = bench::arg(argc, argv, 2, 64);
+	long readers = bench::arg(argc, argv, 3, 2);
+
+	if (max_writers > 64)
+		max_writers = 64;
+	if (readers > 64)
+		readers = 64;
+	std::printf("%ld random inserts split between the writers, %ld range readers\n\n", inserts, readers);
+	std::printf("%-28s %8s %12s %12s\n", "", "writers", "Minserts/s", "Mscanned/s");
+	for (long writers = 1; writers <= max_writers; writers *= 2)
+	{
+		run<skiplist_map>("ft::concurrent_skiplist_map", inserts, writers, readers);
+		run<locked_map>("ft::map + mutex", inserts, writers, readers);
+	}
+	return 0;
+}
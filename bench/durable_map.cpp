@@ -0,0 +1,58 @@
+#include <cstdio>
+#include <string>
+
+#include "bench.hpp"
+#include "../durable_map.hpp"
+
+/*
+* Write throughput of ft::durable_map for several group commit sizes.
+* usage: ./bench.sh durable_map [writes] [path prefix]
+* sync_every = 0 never fsyncs on its own: upper bound of the log path.
+*/
+
+typedef ft::durable_map<long, long>	store_type;
+
+static void remove_files(const std::string& path)
+{
+	std::remove((path + ".wal").c_str());
+	std::remove((path + ".snap").c_str());
+}
+
+int main(int argc, char** argv)
+{
+	long writes = bench::arg(argc, argv, 1, 20000);
+	std::string path = argc > 2 ? argv[2] : "/tmp/ft_bench_durable_map";
+	const std::size_t batches[] = { 1, 8, 64, 512, 4096, 0 };
+
+	std::printf("%-12s %12s %14s %12s\n", "sync_every", "writes", "writes/s", "seconds");
+	for (std::size_t b = 0; b < sizeof(batches) / sizeof(*batches); ++b)
+	{
+		remove_files(path);
+		bench::rng random;
+		double start = bench::now();
+		{
+			store_type store(path, ft::durable_options(batches[b], 0));
+			for (long i = 0; i < writes; ++i)
+				store[random() % (writes / 2 + 1)] = i;
+			store.sync();
+		}
+		double elapsed = bench::now() - start;
+		std::printf("%-12lu %12ld %14.0f %12.3f\n", static_cast<unsigned long>(batches[b]),
+			writes, writes / elapsed, elapsed);
+	}
+
+	/* checkpoint + recovery cost for the last store */
+	double start = bench::now();
+	{
+		store_type store(path, ft::durable_options(0, 0));
+		store.checkpoint();
+	}
+	double checkpoint = bench::now() - start;
+	start = bench::now();
+	store_type store(path);
+	double recovery = bench::now() - start;
+	std::printf("\ncheckpoint of %lu elements: %.3f s, reopen from snapshot: %.3f s\n",
+		static_cast<unsigned long>(store.size()), checkpoint, recovery);
+	remove_files(path);
+	return 0;
+}
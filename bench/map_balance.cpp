@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <map>
+
+#include "bench.hpp"
+#include "../map.hpp"
+
+/*
+* Balancing policies of ft::map across read / write mixes.
+* usage: ./bench.sh map_balance [elements] [operations]
+* Keys are drawn from [0, 2 * elements): a write is an insert or an erase
+* with equal odds, so the map stays around its initial size. std::map (a
+* red-black tree) is given as a reference.
+*/
+
+typedef ft::map<long, long>																		avl_map;
+typedef ft::map<long, long, std::less<long>, std::allocator<ft::pair<const long, long> >, ft::rb_balance>	rb_map;
+typedef std::map<long, long>																	std_map;
+
+template <typename Map>
+static double run(long elements, long operations, int read_percent)
+{
+	Map map;
+	bench::rng random;
+	long key_range = 2 * elements;
+
+	for (long i = 0; i < elements; ++i)
+		map[random() % key_range] = i;
+
+	long found = 0;
+	double start = bench::now();
+	for (long i = 0; i < operations; ++i)
+	{
+		unsigned long long draw = random();
+		long key = draw % key_range;
+		if (static_cast<int>((draw >> 40) % 100) < read_percent)
+			found += map.find(key) != map.end();
+		else if ((draw >> 32) & 1)
+			map[key] = i;
+		else
+			map.erase(key);
+	}
+	double elapsed = bench::now() - start;
+	bench::do_not_optimize(found);
+	return operations / elapsed / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 100000);
+	long operations = bench::arg(argc, argv, 2, 2000000);
+	const int reads[] = { 0, 50, 90, 99 };
+
+	std::printf("%ld elements, %ld operations, Mops/s\n\n", elements, operations);
+	std::printf("%-8s %12s %12s %12s\n", "reads %", "avl", "red-black", "std::map");
+	for (std::size_t r = 0; r < sizeof(reads) / sizeof(*reads); ++r)
+	{
+		std::printf("%-8d %12.2f %12.2f %12.2f\n", reads[r],
+			run<avl_map>(elements, operations, reads[r]),
+			run<rb_map>(elements, operations, reads[r]),
+			run<std_map>(elements, operations, reads[r]));
+	}
+	return 0;
+}
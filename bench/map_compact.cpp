@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <vector>
+
+#include "bench.hpp"
+#include "../map.hpp"
+
+/*
+* In-order scans and random look-ups on a ft::map<int, int> scattered by
+* insert / erase churn, then after compact() and compact(true).
+* usage: ./bench.sh map_compact [elements] [churn rounds] [look-ups]
+* Each churn round erases and re-inserts a tenth of the keys while other
+* blocks of the same size come and go, as in a long-lived process.
+*/
+
+typedef ft::map<int, int>	map_type;
+
+static void measure(const char* name, const map_type& map, long lookups, long key_range)
+{
+	long sum = 0;
+	double start = bench::now();
+	for (int pass = 0; pass < 10; ++pass)
+		for (map_type::const_iterator it = map.begin(); it != map.end(); ++it)
+			sum += it->second;
+	double scan_time = bench::now() - start;
+
+	bench::rng probes(7);
+	start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		sum += map.count(static_cast<int>(probes() % key_range));
+	double find_time = bench::now() - start;
+
+	bench::do_not_optimize(sum);
+	std::printf("%-24s %12.1f %12.2f %8lu\n", name, 10.0 * map.size() / scan_time / 1e6,
+		lookups / find_time / 1e6, static_cast<unsigned long>(map.stats().height));
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 1000000);
+	long rounds = bench::arg(argc, argv, 2, 20);
+	long lookups = bench::arg(argc, argv, 3, 2000000);
+	long key_range = elements * 2;
+	bench::rng random;
+
+	map_type fresh;
+	for (long i = 0; i < elements; ++i)
+		fresh[static_cast<int>(random() % key_range)] = static_cast<int>(i);
+
+	map_type map(fresh);
+	std::vector<char*> noise;
+	for (long round = 0; round < rounds; ++round)
+	{
+		for (long i = 0; i < elements / 10; ++i)
+		{
+			map.erase(static_cast<int>(random() % key_range));
+			noise.push_back(new char[sizeof(int) * 12]);
+		}
+		for (long i = 0; i < elements / 10; ++i)
+			map[static_cast<int>(random() % key_range)] = static_cast<int>(i);
+		for (std::size_t i = 0; i < noise.size(); i += 2)
+			delete[] noise[i];
+		std::vector<char*> kept;
+		for (std::size_t i = 1; i < noise.size(); i += 2)
+			kept.push_back(noise[i]);
+		noise.swap(kept);
+	}
+
+	std::printf("%lu elements, %ld churn rounds, %ld look-ups\n\n", static_cast<unsigned long>(map.size()), rounds, lookups);
+	std::printf("%-24s %12s %12s %8s\n", "ft::map<int, int>", "Mscan/s", "Mfinds/s", "height");
+	measure("freshly inserted", fresh, lookups, key_range);
+	measure("after churn", map, lookups, key_range);
+	double start = bench::now();
+	map.compact();
+	double compact_time = bench::now() - start;
+	measure("compact()", map, lookups, key_range);
+	start = bench::now();
+	map.compact(true);
+	double rebalance_time = bench::now() - start;
+	measure("compact(true)", map, lookups, key_range);
+	std::printf("\ncompact() %.1f ms, compact(true) %.1f ms\n", compact_time * 1e3, rebalance_time * 1e3);
+
+	for (std::size_t i = 0; i < noise.size(); ++i)
+		delete[] noise[i];
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <stdint.h>
+
+#include "bench.hpp"
+#include "../map.hpp"
+
+/*
+* Look-ups in maps of integers: branchless descent (std::less on an integral
+* key) against the generic descent (the same order through a comparator the
+* map does not recognize) and std::map.
+* usage: ./bench.sh map_integral [elements] [look-ups]
+* Half of the probed keys are absent; lower_bound is timed separately.
+*/
+
+/* std::less under another name: keeps the generic, branching descent */
+template <typename T>
+struct opaque_less
+{
+	bool operator()(const T& a, const T& b) const { return a < b; }
+};
+
+template <typename Map, typename Key>
+static void run(const char* name, long elements, long lookups)
+{
+	Map map;
+	bench::rng random;
+
+	for (long i = 0; i < elements; ++i)
+		map[static_cast<Key>(random() % (elements * 2))] = static_cast<typename Map::mapped_type>(i);
+
+	long found = 0;
+	bench::rng probes(7);
+	double start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.find(static_cast<Key>(probes() % (elements * 2))) != map.end();
+	double find_time = bench::now() - start;
+
+	start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.lower_bound(static_cast<Key>(probes() % (elements * 2))) != map.end();
+	double lower_bound_time = bench::now() - start;
+
+	bench::do_not_optimize(found);
+	std::printf("%-40s %12.2f %14.2f\n", name, lookups / find_time / 1e6, lookups / lower_bound_time / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 1000000);
+	long lookups = bench::arg(argc, argv, 2, 4000000);
+
+	std::printf("%ld elements, %ld look-ups, M/s\n\n", elements, lookups);
+	std::printf("%-40s %12s %14s\n", "map", "find", "lower_bound");
+	run<ft::map<int, int>, int>("ft::map<int, int> branchless", elements, lookups);
+	run<ft::map<int, int, opaque_less<int> >, int>("ft::map<int, int> generic", elements, lookups);
+	run<std::map<int, int>, int>("std::map<int, int>", elements, lookups);
+	run<ft::map<uint64_t, uint64_t>, uint64_t>("ft::map<uint64_t, uint64_t> branchless", elements, lookups);
+	run<ft::map<uint64_t, uint64_t, opaque_less<uint64_t> >, uint64_t>("ft::map<uint64_t, uint64_t> generic", elements, lookups);
+	run<std::map<uint64_t, uint64_t>, uint64_t>("std::map<uint64_t, uint64_t>", elements, lookups);
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../map.hpp"
+
+/*
+* String key look-ups with and without the prefix node layout (ft::prefix_less).
+* usage: ./bench.sh map_prefix [elements] [look-ups] [shared prefix length]
+* Keys are 24 random hex digits after an optional shared prefix: with a
+* shared prefix of 8 or more bytes every prefix ties and the layout can only
+* cost; with a short one nearly every comparison is settled by the prefix.
+*/
+
+static std::string make_key(unsigned long long value, long shared)
+{
+	char digits[32];
+	std::sprintf(digits, "%024llx", value * 0x9E3779B97F4A7C15ULL);
+	return std::string(shared, '/') + digits;
+}
+
+template <typename Map>
+static double run(long elements, long lookups, long shared)
+{
+	Map map;
+	std::vector<std::string> keys;
+
+	for (long i = 0; i < elements; ++i)
+	{
+		keys.push_back(make_key(i, shared));
+		map[keys.back()] = i;
+	}
+
+	bench::rng random;
+	long found = 0;
+	double start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.find(keys[random() % elements]) != map.end();
+	double elapsed = bench::now() - start;
+	bench::do_not_optimize(found);
+	return lookups / elapsed / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 1000000);
+	long lookups = bench::arg(argc, argv, 2, 2000000);
+	long shared = bench::arg(argc, argv, 3, 0);
+
+	std::printf("%ld elements, %ld look-ups, %ld shared prefix bytes, Mlookups/s\n\n", elements, lookups, shared);
+	std::printf("%-24s %10.2f\n", "ft::map std::less", run<ft::map<std::string, long> >(elements, lookups, shared));
+	std::printf("%-24s %10.2f\n", "ft::map ft::prefix_less", run<ft::map<std::string, long, ft::prefix_less> >(elements, lookups, shared));
+	std::printf("%-24s %10.2f\n", "std::map", run<std::map<std::string, long> >(elements, lookups, shared));
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "bench.hpp"
+#include "../map.hpp"
+
+/*
+* Look-ups from const char* in string keyed maps, with the default
+* comparator (a std::string is built for each look-up, on the heap when the
+* key is longer than the small string buffer) and with ft::transparent_less.
+* usage: ./bench.sh map_transparent [elements] [look-ups]
+*/
+
+static unsigned long	allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	void* block = std::malloc(size ? size : 1);
+	if (!block)
+		throw std::bad_alloc();
+	return block;
+}
+
+void operator delete(void* block) throw()
+{
+	std::free(block);
+}
+
+void operator delete(void* block, std::size_t) throw()
+{
+	std::free(block);
+}
+
+/* keys long enough to defeat the small string optimization */
+static void make_key(char* buffer, unsigned long long value)
+{
+	std::sprintf(buffer, "customer/%020llu", value);
+}
+
+template <typename Map>
+static void run(const char* name, long elements, long lookups)
+{
+	Map map;
+	char buffer[64];
+
+	for (long i = 0; i < elements; ++i)
+	{
+		make_key(buffer, i * 2);
+		map[buffer] = i;
+	}
+
+	/* the keys are formatted up front: only the look-ups are measured */
+	std::string keys(lookups * 32, '\0');
+	bench::rng random;
+	for (long i = 0; i < lookups; ++i)
+		make_key(&keys[i * 32], random() % (elements * 2));
+
+	long found = 0;
+	unsigned long allocations_before = allocations;
+	double start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.count(keys.c_str() + i * 32);
+	double elapsed = bench::now() - start;
+	unsigned long spent = allocations - allocations_before;
+
+	bench::do_not_optimize(found);
+	std::printf("%-20s %12.2f %16.2f %10ld\n", name, lookups / elapsed / 1e6,
+		static_cast<double>(spent) / lookups, found);
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 100000);
+	long lookups = bench::arg(argc, argv, 2, 1000000);
+
+	std::printf("%ld elements, %ld look-ups from const char*\n\n", elements, lookups);
+	std::printf("%-20s %12s %16s %10s\n", "comparator", "Mlookups/s", "allocs/lookup", "found");
+	run<ft::map<std::string, long> >("std::less", elements, lookups);
+	run<ft::map<std::string, long, ft::transparent_less> >("ft::transparent_less", elements, lookups);
+	return 0;
+}
@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../radix_map.hpp"
+#include "../map.hpp"
+
+/*
+* ft::radix_map against ft::map.
+* usage: ./bench.sh radix_map [elements] [look-ups]
+* Three key sets: random 64-bit integers, dense integers (0, 1, 2...) and
+* strings sharing long prefixes, like paths. Keys are inserted in random
+* order, looked up at random, bounded with lower_bound at random, then
+* scanned in order. The default of 1e6 elements fits in a few hundred MB
+* for every set; 1e7 and 1e8 are arguments away, memory allowing.
+*/
+
+template <typename Map>
+static std::size_t heap_bytes(const Map& map) { return map.memory_usage() - sizeof(map); }
+
+static std::vector<unsigned long long> random_keys(long elements)
+{
+	std::vector<unsigned long long> keys;
+	bench::rng random(7);
+
+	for (long i = 0; i < elements; ++i)
+		keys.push_back(random());
+	return keys;
+}
+
+/* 0 .. elements - 1, shuffled */
+static std::vector<unsigned long long> dense_keys(long elements)
+{
+	std::vector<unsigned long long> keys;
+	bench::rng random(11);
+
+	for (long i = 0; i < elements; ++i)
+		keys.push_back(i);
+	for (long i = elements - 1; i > 0; --i)
+		std::swap(keys[i], keys[random() % (i + 1)]);
+	return keys;
+}
+
+static std::vector<std::string> path_keys(long elements)
+{
+	std::vector<std::string> keys;
+	bench::rng random(13);
+	char buffer[96];
+
+	for (long i = 0; i < elements; ++i)
+	{
+		unsigned long long r = random();
+		std::sprintf(buffer, "/srv/data/users/%04llu/files/%06llu.dat", r % 1000, (r >> 10) % 1000000);
+		keys.push_back(buffer);
+	}
+	return keys;
+}
+
+template <typename Map, typename Key>
+static void run(const char* name, const std::vector<Key>& keys, long lookups)
+{
+	Map map;
+	long elements = static_cast<long>(keys.size());
+
+	double start = bench::now();
+	for (long i = 0; i < elements; ++i)
+		map[keys[i]] = i;
+	double insert_time = bench::now() - start;
+
+	bench::rng random(3);
+	long found = 0;
+	start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.count(keys[random() % elements]);
+	double find_time = bench::now() - start;
+
+	long bounded = 0;
+	start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+	{
+		typename Map::const_iterator it = map.lower_bound(keys[random() % elements]);
+		bounded += it != map.end() ? it->second : 0;
+	}
+	double bound_time = bench::now() - start;
+
+	long sum = 0;
+	start = bench::now();
+	for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it)
+		sum += it->second;
+	double scan_time = bench::now() - start;
+
+	bench::do_not_optimize(found + bounded + sum);
+	std::printf("%-24s %10.2f %10.2f %10.2f %10.1f %10.1f\n", name,
+		elements / insert_time / 1e6, lookups / find_time / 1e6, lookups / bound_time / 1e6,
+		map.size() / scan_time / 1e6, static_cast<double>(heap_bytes(map)) / map.size());
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 1000000);
+	long lookups = bench::arg(argc, argv, 2, 2000000);
+
+	std::printf("%ld keys in random order, %ld look-ups and lower_bounds, then one in-order scan\n\n", elements, lookups);
+	std::printf("%-24s %10s %10s %10s %10s %10s\n", "", "Minsert/s", "Mfind/s", "Mlower/s", "Mscan/s", "bytes/elem");
+	{
+		std::vector<unsigned long long> keys = random_keys(elements);
+		run<ft::radix_map<unsigned long long, long> >("random u64 radix_map", keys, lookups);
+		run<ft::map<unsigned long long, long> >("random u64 map", keys, lookups);
+	}
+	{
+		std::vector<unsigned long long> keys = dense_keys(elements);
+		run<ft::radix_map<unsigned long long, long> >("dense u64 radix_map", keys, lookups);
+		run<ft::map<unsigned long long, long> >("dense u64 map", keys, lookups);
+	}
+	{
+		std::vector<std::string> keys = path_keys(elements);
+		run<ft::radix_map<std::string, long> >("paths radix_map", keys, lookups);
+		run<ft::map<std::string, long> >("paths map", keys, lookups);
+	}
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include <cstdio>
+#include <map>
+
+#include "bench.hpp"
+#include "../small_map.hpp"
+#include "../map.hpp"
+
+/*
+* Many short-lived small maps: ft::small_map (8 and 16 inline elements)
+* against ft::map and std::map, map<int, int>, sizes 0 to 64.
+* usage: ./bench.sh small_map [element inserts per size]
+* build: construct, insert size random keys, destroy, ns per element (per
+* map for size 0); find: ns per look-up in a built map, half the keys absent.
+*/
+
+template <typename Map>
+static void run(const char* name, long total)
+{
+	static const long sizes[] = { 0, 1, 2, 4, 8, 12, 16, 32, 64 };
+
+	std::printf("%-24s", name);
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		long size = sizes[s];
+		long maps = total / (size ? size : 1);
+		bench::rng random;
+		long sum = 0;
+
+		double start = bench::now();
+		for (long m = 0; m < maps; ++m)
+		{
+			Map map;
+			for (long i = 0; i < size; ++i)
+				map[static_cast<int>(random() % (size * 2))] = static_cast<int>(i);
+			sum += map.size();
+		}
+		double build_time = bench::now() - start;
+
+		Map map;
+		for (long i = 0; i < size; ++i)
+			map[static_cast<int>(i * 2)] = static_cast<int>(i);
+		start = bench::now();
+		for (long i = 0; i < total; ++i)
+			sum += map.count(static_cast<int>(random() % (size * 2 + 1)));
+		double find_time = bench::now() - start;
+
+		bench::do_not_optimize(sum);
+		std::printf(" %5.1f/%-5.1f", build_time * 1e9 / (maps * (size ? size : 1)), find_time * 1e9 / total);
+	}
+	std::printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+	long total = bench::arg(argc, argv, 1, 2000000);
+
+	std::printf("ns per element build / per find, by map size\n\n");
+	std::printf("%-24s %11s %11s %11s %11s %11s %11s %11s %11s %11s\n", "map<int, int>",
+		"0", "1", "2", "4", "8", "12", "16", "32", "64");
+	run<ft::small_map<int, int, 8> >("ft::small_map<.., 8>", total);
+	run<ft::small_map<int, int, 16> >("ft::small_map<.., 16>", total);
+	run<ft::map<int, int> >("ft::map", total);
+	run<std::map<int, int> >("std::map", total);
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+#include "../small_vector.hpp"
+#include "../vector.hpp"
+
+/*
+* Short-lived vectors of a few elements, as built per request: ft::vector
+* and std::vector allocate on the first push_back, ft::small_vector<T, 16>
+* does not until element 17.
+* usage: ./bench.sh small_vector [vectors] [max size]
+* Each vector gets 0 to max size ints (sizes at random, 90% of them up to
+* 16), is summed and destroyed. Allocations are counted by the allocator
+* of the vector, per vector; time is the best of 5, in ns per vector.
+*/
+
+static long	g_allocations = 0;
+
+template <typename T>
+struct counting_allocator : public std::allocator<T>
+{
+	template <typename U>
+	struct rebind { typedef counting_allocator<U> other; };
+
+	counting_allocator() {}
+	template <typename U>
+	counting_allocator(const counting_allocator<U>&) {}
+
+	T* allocate(std::size_t n, const void* = 0)
+	{
+		++g_allocations;
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+namespace ft {
+	template <typename T>
+	struct is_plain_allocator<counting_allocator<T> > : public true_type {};
+}
+
+template <typename Vector>
+static void run(const char* name, long vectors, long max_size)
+{
+	double best = 1e30;
+	long allocations = 0;
+
+	for (int round = 0; round < 5; ++round)
+	{
+		bench::rng random(7);
+		long sum = 0;
+		g_allocations = 0;
+		double start = bench::now();
+		for (long n = 0; n < vectors; ++n)
+		{
+			unsigned long draw = random();
+			long size = draw % 10 ? static_cast<long>(draw >> 8) % 17 : static_cast<long>(draw >> 8) % (max_size + 1);
+			Vector v;
+			for (long i = 0; i < size; ++i)
+				v.push_back(static_cast<int>(i));
+			for (typename Vector::const_iterator it = v.begin(); it != v.end(); ++it)
+				sum += *it;
+		}
+		best = std::min(best, bench::now() - start);
+		allocations = g_allocations;
+		bench::do_not_optimize(sum);
+	}
+	std::printf("%-36s %12.1f %16.3f\n", name, best / vectors * 1e9, static_cast<double>(allocations) / vectors);
+}
+
+int main(int argc, char** argv)
+{
+	long vectors = bench::arg(argc, argv, 1, 2000000);
+	long max_size = bench::arg(argc, argv, 2, 64);
+
+	std::printf("%ld vectors of 0 to %ld ints, 90%% up to 16\n\n", vectors, max_size);
+	std::printf("%-36s %12s %16s\n", "", "ns/vector", "allocs/vector");
+	run<ft::vector<int, counting_allocator<int> > >("ft::vector<int>", vectors, max_size);
+	run<ft::small_vector<int, 16, counting_allocator<int> > >("ft::small_vector<int, 16>", vectors, max_size);
+	run<ft::small_vector<int, 4, counting_allocator<int> > >("ft::small_vector<int, 4>", vectors, max_size);
+	run<std::vector<int, counting_allocator<int> > >("std::vector<int>", vectors, max_size);
+	return 0;
+}
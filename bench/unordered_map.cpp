@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <map>
+#include <unordered_map>
+
+#include "bench.hpp"
+#include "../unordered_map.hpp"
+#include "../map.hpp"
+
+/*
+* ft::unordered_map against ft::map and std::unordered_map, int -> int.
+* usage: ./bench.sh unordered_map [elements] [look-ups]
+* Inserts start from an empty map (no reserve). The slowest insert is
+* timed on its own: the full rehash of std::unordered_map against the
+* incremental growth of ft::unordered_map.
+*/
+
+template <typename Map>
+static void run(const char* name, long elements, long lookups)
+{
+	Map map;
+	bench::rng random;
+	double slowest = 0;
+
+	double start = bench::now();
+	for (long i = 0; i < elements; ++i)
+	{
+		double one = bench::now();
+		map[static_cast<int>(random() >> 1)] = static_cast<int>(i);
+		one = bench::now() - one;
+		slowest = one > slowest ? one : slowest;
+	}
+	double insert_time = bench::now() - start;
+
+	long found = 0;
+	bench::rng hits;
+	start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.count(static_cast<int>(hits() >> 1));
+	double hit_time = bench::now() - start;
+
+	bench::rng misses(12345);
+	start = bench::now();
+	for (long i = 0; i < lookups; ++i)
+		found += map.count(static_cast<int>(misses() >> 1));
+	double miss_time = bench::now() - start;
+
+	bench::rng erased;
+	start = bench::now();
+	for (long i = 0; i < elements; ++i)
+		found += map.erase(static_cast<int>(erased() >> 1));
+	double erase_time = bench::now() - start;
+
+	bench::do_not_optimize(found);
+	std::printf("%-24s %10.2f %10.2f %10.2f %10.2f %12.2f\n", name, elements / insert_time / 1e6,
+		lookups / hit_time / 1e6, lookups / miss_time / 1e6, elements / erase_time / 1e6, slowest * 1e3);
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 1000000);
+	long lookups = bench::arg(argc, argv, 2, 4000000);
+
+	std::printf("%ld inserts (timed one by one), %ld hits, %ld misses, %ld erases, M/s\n\n",
+		elements, lookups, lookups, elements);
+	std::printf("%-24s %10s %10s %10s %10s %12s\n", "int -> int", "insert", "hit", "miss", "erase", "slowest ms");
+	run<ft::unordered_map<int, int> >("ft::unordered_map", elements, lookups);
+	run<std::unordered_map<int, int> >("std::unordered_map", elements, lookups);
+	run<ft::map<int, int> >("ft::map", elements, lookups);
+	return 0;
+}
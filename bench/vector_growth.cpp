@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench.hpp"
+#include "../allocator.hpp"
+#include "../vector.hpp"
+
+/*
+* Growth of a large vector<long> by push_back, with ft::realloc_allocator
+* (realloc, then mremap past a megabyte) against the allocate + copy + free
+* of std::allocator.
+* usage: ./bench.sh vector_growth [max megabytes]
+* Each run ends one element past the size, right after a growth of the
+* whole buffer. The sizes double from 64 MB up to the maximum (1024 by
+* default; several GB need as much free memory, twice as much for the
+* std::allocator rows). Each run is a child process, so that its peak RSS
+* is its own.
+*/
+
+template <typename Vector>
+static double grow(long elements)
+{
+	double start = bench::now();
+	Vector v;
+	for (long i = 0; i < elements; ++i)
+		v.push_back(i);
+	double elapsed = bench::now() - start;
+	bench::do_not_optimize(v[elements / 2]);
+	return elapsed;
+}
+
+template <typename Vector>
+static void run(const char* name, long megabytes)
+{
+	/* one past a power of two: the last growth copies the whole buffer */
+	long elements = megabytes * (1 << 20) / static_cast<long>(sizeof(long)) + 1;
+	int fds[2];
+	double elapsed = -1;
+
+	if (pipe(fds) != 0)
+		return;
+	std::fflush(stdout);
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		elapsed = grow<Vector>(elements);
+		if (write(fds[1], &elapsed, sizeof(elapsed)) != sizeof(elapsed))
+			_exit(1);
+		_exit(0);
+	}
+	close(fds[1]);
+	if (pid < 0 || read(fds[0], &elapsed, sizeof(elapsed)) != sizeof(elapsed))
+		elapsed = -1;
+	close(fds[0]);
+	int status;
+	struct rusage usage;
+	if (pid > 0)
+		wait4(pid, &status, 0, &usage);
+	if (elapsed < 0)
+	{
+		std::printf("%-36s %8ld %10s\n", name, megabytes, "failed");
+		return;
+	}
+	std::printf("%-36s %8ld %10.1f %12.1f %8.2f\n", name, megabytes, elapsed * 1e3,
+		usage.ru_maxrss / 1024.0, usage.ru_maxrss / 1024.0 / megabytes);
+}
+
+int main(int argc, char** argv)
+{
+	long max_megabytes = bench::arg(argc, argv, 1, 1024);
+
+	std::printf("push_back of longs up to one past the size in MB; time in ms, peak RSS in MB and per MB of data\n\n");
+	std::printf("%-36s %8s %10s %12s %8s\n", "", "MB", "ms", "peak RSS", "ratio");
+	for (long megabytes = 64; megabytes <= max_megabytes; megabytes *= 2)
+	{
+		run<ft::vector<long, ft::realloc_allocator<long> > >("ft::vector realloc_allocator", megabytes);
+		run<ft::vector<long> >("ft::vector std::allocator", megabytes);
+		run<std::vector<long> >("std::vector", megabytes);
+	}
+	return 0;
+}
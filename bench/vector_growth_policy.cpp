@@ -0,0 +1,70 @@
+#define FT_VECTOR_COUNTERS
+
+#include <algorithm>
+#include <cstdio>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+
+/*
+* The growth policies of ft::vector: push_backs up to sizes spread between
+* 1 and the maximum, with the counters of vector_stats.
+* usage: ./bench.sh vector_growth_policy [max elements] [vectors]
+* Time is the best of 5 in ms; copied is the bytes copied by the growths per
+* byte of data, slack the unused capacity per byte of data, both averaged
+* over the vectors.
+*/
+
+struct pod32
+{
+	long	v[4];
+};
+
+template <typename T, typename Growth>
+static void run(const char* name, long max_elements, long vectors)
+{
+	typedef ft::vector<T, std::allocator<T>, Growth>	vector_type;
+	double best = 1e30;
+	double copied = 0, slack = 0, reallocations = 0;
+
+	for (int round = 0; round < 5; ++round)
+	{
+		bench::rng random(42);
+		double data = 0;
+		copied = slack = reallocations = 0;
+		double start = bench::now();
+		for (long n = 0; n < vectors; ++n)
+		{
+			long size = 1 + static_cast<long>(random() % static_cast<unsigned long>(max_elements));
+			vector_type v;
+			for (long i = 0; i < size; ++i)
+				v.push_back(T());
+			ft::vector_stats s = v.stats();
+			data += s.bytes_used;
+			copied += s.bytes_copied;
+			slack += s.bytes_slack;
+			reallocations += s.reallocations;
+		}
+		best = std::min(best, bench::now() - start);
+		copied /= data;
+		slack /= data;
+		reallocations /= vectors;
+	}
+	std::printf("%-28s %10.2f %10.2f %10.2f %14.1f\n", name, best * 1e3, copied, slack, reallocations);
+}
+
+int main(int argc, char** argv)
+{
+	long max_elements = bench::arg(argc, argv, 1, 100000);
+	long vectors = bench::arg(argc, argv, 2, 200);
+
+	std::printf("%ld vectors of 1 to %ld elements\n\n", vectors, max_elements);
+	std::printf("%-28s %10s %10s %10s %14s\n", "", "ms", "copied", "slack", "reallocations");
+	run<int, ft::growth_double>("int double", max_elements, vectors);
+	run<int, ft::growth_golden>("int golden", max_elements, vectors);
+	run<int, ft::growth_size_class>("int size class", max_elements, vectors);
+	run<pod32, ft::growth_double>("pod32 double", max_elements, vectors);
+	run<pod32, ft::growth_golden>("pod32 golden", max_elements, vectors);
+	run<pod32, ft::growth_size_class>("pod32 size class", max_elements, vectors);
+	return 0;
+}
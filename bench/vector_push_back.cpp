@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+
+/*
+* Append throughput of push_back, whose full-vector case is an out-of-line
+* slow path, against insert(end(), value): the route push_back used to take
+* through insert(position, n, value).
+* usage: ./bench.sh vector_push_back [appends] [small vector size]
+* "one vector" appends everything to one vector; "small vectors" appends to
+* many vectors of the given size, where the growths weigh more. Best of 5,
+* in millions of appends per second.
+*/
+
+struct push_back_append
+{
+	template <typename Vector>
+	void operator()(Vector& v, const typename Vector::value_type& value) const { v.push_back(value); }
+};
+
+struct insert_append
+{
+	template <typename Vector>
+	void operator()(Vector& v, const typename Vector::value_type& value) const { v.insert(v.end(), value); }
+};
+
+template <typename T>
+static T make(long i);
+
+template <>
+int make<int>(long i) { return static_cast<int>(i); }
+
+template <>
+std::string make<std::string>(long i) { return std::string(1 + i % 8, static_cast<char>('a' + i % 26)); }
+
+template <typename Vector, typename Append>
+static double one_vector(long appends)
+{
+	typedef typename Vector::value_type value_type;
+	const value_type values[4] = { make<value_type>(1), make<value_type>(2), make<value_type>(3), make<value_type>(4) };
+	Append append;
+
+	double start = bench::now();
+	Vector v;
+	for (long i = 0; i < appends; ++i)
+		append(v, values[i & 3]);
+	double elapsed = bench::now() - start;
+	bench::do_not_optimize(v.size());
+	return elapsed;
+}
+
+template <typename Vector, typename Append>
+static double small_vectors(long appends, long size)
+{
+	typedef typename Vector::value_type value_type;
+	const value_type values[4] = { make<value_type>(1), make<value_type>(2), make<value_type>(3), make<value_type>(4) };
+	Append append;
+	long total = 0;
+
+	double start = bench::now();
+	for (long done = 0; done < appends; done += size)
+	{
+		Vector v;
+		for (long i = 0; i < size; ++i)
+			append(v, values[i & 3]);
+		total += v.size();
+	}
+	double elapsed = bench::now() - start;
+	bench::do_not_optimize(total);
+	return elapsed;
+}
+
+template <typename Vector, typename Append>
+static void run(const char* name, long appends, long size)
+{
+	double one = one_vector<Vector, Append>(appends);
+	double small = small_vectors<Vector, Append>(appends, size);
+
+	for (int round = 1; round < 5; ++round)
+	{
+		one = std::min(one, one_vector<Vector, Append>(appends));
+		small = std::min(small, small_vectors<Vector, Append>(appends, size));
+	}
+	std::printf("%-40s %14.1f %14.1f\n", name, appends / one / 1e6, appends / small / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+	long appends = bench::arg(argc, argv, 1, 20000000);
+	long size = bench::arg(argc, argv, 2, 16);
+
+	if (size < 1)
+		size = 1;
+	std::printf("%ld appends; small vectors of %ld elements; Mappends/s\n\n", appends, size);
+	std::printf("%-40s %14s %14s\n", "", "one vector", "small vectors");
+	run<ft::vector<int>, push_back_append>("ft::vector<int> push_back", appends, size);
+	run<ft::vector<int>, insert_append>("ft::vector<int> insert(end())", appends, size);
+	run<std::vector<int>, push_back_append>("std::vector<int> push_back", appends, size);
+	run<ft::vector<std::string>, push_back_append>("ft::vector<string> push_back", appends / 4, size);
+	run<ft::vector<std::string>, insert_append>("ft::vector<string> insert(end())", appends / 4, size);
+	run<std::vector<std::string>, push_back_append>("std::vector<string> push_back", appends / 4, size);
+	return 0;
+}
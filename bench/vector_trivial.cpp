@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+
+/*
+* The memcpy / memmove paths of ft::vector for trivially copyable elements.
+* usage: ./bench.sh vector_trivial [elements] [middle inserts/erases]
+* "element-wise" is ft::vector with an allocator the vector does not know
+* (derived from std::allocator), which keeps the element-by-element loops:
+* the code as it was before the fast paths. Times in ms.
+*/
+
+template <typename T>
+struct elementwise_allocator : public std::allocator<T>
+{
+	template <typename U>
+	struct rebind { typedef elementwise_allocator<U> other; };
+
+	elementwise_allocator() {}
+	template <typename U>
+	elementwise_allocator(const elementwise_allocator<U>&) {}
+};
+
+struct pod64
+{
+	long	v[8];
+};
+
+template <typename T>
+static T make(long i)
+{
+	T value;
+	for (std::size_t k = 0; k < sizeof(T) / sizeof(long); ++k)
+		reinterpret_cast<long*>(&value)[k] = i + k;
+	return value;
+}
+
+template <>
+int make<int>(long i) { return static_cast<int>(i); }
+
+struct timings
+{
+	double	grow, copy, destroy, insert, erase;
+};
+
+template <typename Vector>
+static timings measure(long elements, long edits)
+{
+	typedef typename Vector::value_type value_type;
+	timings t;
+	long checksum = 0;
+
+	double start = bench::now();
+	Vector v;
+	for (long i = 0; i < elements; ++i)
+		v.push_back(make<value_type>(i));
+	t.grow = bench::now() - start;
+
+	start = bench::now();
+	{
+		Vector c(v);
+		checksum += c.size();
+		t.copy = bench::now() - start;
+		start = bench::now();
+	}
+	t.destroy = bench::now() - start;
+
+	start = bench::now();
+	for (long i = 0; i < edits; ++i)
+		v.insert(v.begin() + v.size() / 2, make<value_type>(i));
+	t.insert = bench::now() - start;
+
+	start = bench::now();
+	for (long i = 0; i < edits; ++i)
+		v.erase(v.begin() + v.size() / 3);
+	t.erase = bench::now() - start;
+	checksum += v.size();
+	bench::do_not_optimize(checksum);
+	return t;
+}
+
+/* the best of 5 runs, each column on its own */
+template <typename Vector>
+static void run(const char* name, long elements, long edits)
+{
+	timings best = measure<Vector>(elements, edits);
+
+	for (int round = 1; round < 5; ++round)
+	{
+		timings t = measure<Vector>(elements, edits);
+		best.grow = std::min(best.grow, t.grow);
+		best.copy = std::min(best.copy, t.copy);
+		best.destroy = std::min(best.destroy, t.destroy);
+		best.insert = std::min(best.insert, t.insert);
+		best.erase = std::min(best.erase, t.erase);
+	}
+	std::printf("%-30s %10.2f %10.2f %10.2f %10.2f %10.2f\n", name,
+		best.grow * 1e3, best.copy * 1e3, best.destroy * 1e3, best.insert * 1e3, best.erase * 1e3);
+}
+
+int main(int argc, char** argv)
+{
+	long elements = bench::arg(argc, argv, 1, 4000000);
+	long edits = bench::arg(argc, argv, 2, 200);
+
+	std::printf("%ld push_backs, a copy and its destruction, then %ld inserts and erases in the middle; ms\n\n",
+		elements, edits);
+	std::printf("%-30s %10s %10s %10s %10s %10s\n", "", "grow", "copy", "destroy", "insert", "erase");
+	run<ft::vector<int> >("ft::vector<int>", elements, edits);
+	run<ft::vector<int, elementwise_allocator<int> > >("ft::vector<int> element-wise", elements, edits);
+	run<std::vector<int> >("std::vector<int>", elements, edits);
+	run<ft::vector<pod64> >("ft::vector<pod64>", elements / 4, edits);
+	run<ft::vector<pod64, elementwise_allocator<pod64> > >("ft::vector<pod64> element-wise", elements / 4, edits);
+	run<std::vector<pod64> >("std::vector<pod64>", elements / 4, edits);
+	return 0;
+}
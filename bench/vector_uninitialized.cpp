@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bench.hpp"
+#include "../vector.hpp"
+
+/*
+* An I/O buffer of chars filled by read(2): resize(n) writes n zeros that
+* read() overwrites right after, resize_default_init(n) leaves the memory
+* alone.
+* usage: ./bench.sh vector_uninitialized [megabytes] [source file]
+* The buffer is 1024 MB by default, read in 1 MB calls from /dev/zero (the
+* kernel copy without a disk). Best of 3, in ms; "resize" is the resize call
+* alone, "total" resize plus the reads.
+*/
+
+struct value_resize
+{
+	template <typename Vector>
+	void operator()(Vector& v, std::size_t n) const { v.resize(n); }
+};
+
+struct default_init_resize
+{
+	template <typename Vector>
+	void operator()(Vector& v, std::size_t n) const { v.resize_default_init(n); }
+};
+
+template <typename Vector, typename Resize>
+static void run(const char* name, long megabytes, const char* path)
+{
+	const std::size_t chunk = 1 << 20;
+	const std::size_t n = static_cast<std::size_t>(megabytes) * chunk;
+	double best_resize = 1e30;
+	double best_total = 1e30;
+	Resize resize;
+
+	for (int round = 0; round < 3; ++round)
+	{
+		int fd = open(path, O_RDONLY);
+		if (fd < 0)
+		{
+			std::printf("cannot open %s\n", path);
+			return;
+		}
+		Vector v;
+		double start = bench::now();
+		resize(v, n);
+		double resized = bench::now();
+		for (std::size_t done = 0; done < n; done += chunk)
+		{
+			if (read(fd, &v[done], chunk) <= 0)
+				break;
+		}
+		double end = bench::now();
+		close(fd);
+		bench::do_not_optimize(v[n / 2]);
+		best_resize = std::min(best_resize, resized - start);
+		best_total = std::min(best_total, end - start);
+	}
+	std::printf("%-36s %10.1f %10.1f\n", name, best_resize * 1e3, best_total * 1e3);
+}
+
+int main(int argc, char** argv)
+{
+	long megabytes = bench::arg(argc, argv, 1, 1024);
+	const char* path = argc > 2 ? argv[2] : "/dev/zero";
+
+	std::printf("%ld MB of chars read from %s in 1 MB calls; ms\n\n", megabytes, path);
+	std::printf("%-36s %10s %10s\n", "", "resize", "total");
+	run<ft::vector<char>, default_init_resize>("ft::vector resize_default_init", megabytes, path);
+	run<ft::vector<char>, value_resize>("ft::vector resize", megabytes, path);
+	run<std::vector<char>, value_resize>("std::vector resize", megabytes, path);
+	return 0;
+}
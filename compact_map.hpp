@@ -0,0 +1,798 @@
+#ifndef COMPACT_MAP_HPP
+#define COMPACT_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <stdint.h>
+
+#include "utility.hpp"
+#include "iterator.hpp"
+
+/*
+* ft::compact_map: the interface of ft::map, with its nodes stored in one
+* growable array and linked by 32-bit indices instead of pointers.
+*
+*	ft::map<int, int>			3 pointers + balancing data + value = 40 bytes
+*	ft::compact_map<int, int>	3 indices + height + value = 24 bytes
+*
+* Erased slots go to a free list threaded through their parent index and
+* are reused first, so the array only grows to the peak number of
+* elements. Up to 2^32 - 1 elements; clear() keeps the array.
+*
+* Differences with ft::map, all coming from the array:
+*	- growing the array moves the elements: pointers and references to them
+*	  are invalidated, like in a vector (iterators hold an index and stay valid);
+*	- iterators refer to their map: swap() invalidates them.
+* Balancing is AVL, like the default ft::map.
+*/
+
+namespace ft {
+
+template <typename Value>
+struct compact_map_node
+{
+	uint32_t	parent;		/* next free slot when the slot is free */
+	uint32_t	child[2];	/* [0] left, [1] right */
+	uint32_t	height;		/* AVL height of the subtree, 0 marks a free slot */
+	Value		value;
+};
+
+/* Value is the map's value_type or its const version */
+template <typename Map, typename Value>
+class compact_map_iterator
+{
+	public:
+		typedef typename Map::value_type				value_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef std::bidirectional_iterator_tag			iterator_category;
+		typedef Value*									pointer;
+		typedef Value&									reference;
+
+	private:
+		const Map*										_map;
+		uint32_t										_index;
+
+	public:
+		compact_map_iterator() : _map(NULL), _index(Map::nil) {}
+
+		compact_map_iterator(const Map* map, uint32_t index) : _map(map), _index(index) {}
+
+		template <typename V>
+		compact_map_iterator(const compact_map_iterator<Map, V>& other) : _map(other.map()), _index(other.index()) {}
+
+		const Map* map() const { return _map; }
+		uint32_t index() const { return _index; }
+
+		reference operator*() const { return _map->_nodes[_index].value; }
+		pointer operator->() const { return &_map->_nodes[_index].value; }
+
+		compact_map_iterator& operator++()
+		{
+			_index = _map->successor(_index);
+			return *this;
+		}
+
+		compact_map_iterator operator++(int)
+		{
+			compact_map_iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		compact_map_iterator& operator--()
+		{
+			_index = _map->predecessor(_index);
+			return *this;
+		}
+
+		compact_map_iterator operator--(int)
+		{
+			compact_map_iterator tmp(*this);
+			--(*this);
+			return tmp;
+		}
+
+		template <typename V>
+		bool operator==(const compact_map_iterator<Map, V>& x) const { return _index == x.index(); }
+
+		template <typename V>
+		bool operator!=(const compact_map_iterator<Map, V>& x) const { return _index != x.index(); }
+};
+
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+class compact_map {
+
+	/*MEMBER TYPES*/
+	public:
+		typedef Key																key_type;
+		typedef T																mapped_type;
+		typedef Compare															key_compare;
+		typedef Allocator 														allocator_type;
+
+		typedef ft::pair<const key_type, mapped_type>							value_type;
+		typedef std::ptrdiff_t 													difference_type;
+		typedef std::size_t 													size_type;
+
+		typedef value_type& 													reference;
+		typedef const value_type& 												const_reference;
+		typedef typename Allocator::pointer										pointer;
+		typedef typename Allocator::const_pointer								const_pointer;
+
+		typedef compact_map_iterator<compact_map, value_type>					iterator;
+		typedef compact_map_iterator<compact_map, const value_type>				const_iterator;
+
+		typedef ft::reverse_iterator<iterator>									reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> 							const_reverse_iterator;
+
+		/* the index of no node, also end() */
+		static const uint32_t													nil = 0xffffffffu;
+
+	private:
+		typedef compact_map_node<value_type>									Node;
+		typedef typename Allocator::template rebind<Node>::other 				node_alloc;
+
+		friend class compact_map_iterator<compact_map, value_type>;
+		friend class compact_map_iterator<compact_map, const value_type>;
+
+	public:
+		class value_compare : public std::binary_function<value_type, value_type, bool>
+		{
+			public:
+			friend class compact_map<Key, T, Compare, Allocator>;
+			bool operator()(const value_type& lhs, const value_type& rhs) const
+			{
+				return comp(lhs.first, rhs.first);
+			}
+
+			protected:
+			key_compare comp;
+			value_compare(key_compare c) : comp(c){}
+		}; // value_compare
+
+		/* -- CONSTRUCTORS - DESTUCTORS -- */
+
+		/**
+		*  @brief  Creates a %compact_map with no elements, without allocating.
+		*/
+		explicit compact_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+			_nodes(NULL),
+			_capacity(0),
+			_used(0),
+			_free(nil),
+			_root(nil),
+			_first(nil),
+			_last(nil),
+			_node_count(0),
+			_alloc(alloc),
+			_node_alloc(alloc),
+			_comp(comp)
+		{}
+
+		template<typename InputIt>
+		compact_map(InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+			_nodes(NULL),
+			_capacity(0),
+			_used(0),
+			_free(nil),
+			_root(nil),
+			_first(nil),
+			_last(nil),
+			_node_count(0),
+			_alloc(alloc),
+			_node_alloc(alloc),
+			_comp(comp)
+		{
+			insert(first, last);
+		}
+
+		compact_map(const compact_map& other):
+			_nodes(NULL),
+			_capacity(0),
+			_used(0),
+			_free(nil),
+			_root(nil),
+			_first(nil),
+			_last(nil),
+			_node_count(0),
+			_alloc(other._alloc),
+			_node_alloc(other._node_alloc),
+			_comp(other._comp)
+		{
+			reserve(other.size());
+			insert(other.begin(), other.end());
+		}
+
+		~compact_map()
+		{
+			clear();
+			if (_nodes)
+				_node_alloc.deallocate(_nodes, _capacity);
+		}
+
+		compact_map& operator=(const compact_map& other)
+		{
+			compact_map temp(other);
+			swap(temp);
+			return *this;
+		}
+
+		allocator_type get_allocator() const { return _alloc; }
+
+	/* ---------- ITERATORS --------------------------------------------------------- */
+		iterator begin() { return iterator(this, _first); }
+		const_iterator begin() const { return const_iterator(this, _first); }
+
+		iterator end() { return iterator(this, nil); }
+		const_iterator end() const { return const_iterator(this, nil); }
+
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	/*
+	* ---------- CAPACITY --------------------------------------------------------- *
+	*/
+		bool empty() const { return _node_count == 0; }
+
+		size_type size() const { return _node_count; }
+
+		size_type max_size() const
+		{
+			return std::min(static_cast<size_type>(nil), static_cast<size_type>(_node_alloc.max_size()));
+		}
+
+		/* slots of the array, used or free */
+		size_type capacity() const { return _capacity; }
+
+		/**
+		*  @brief  Grows the array to hold at least @a n elements.
+		*  @throw  std::length_error  If @a n > max_size().
+		*/
+		void reserve(size_type n)
+		{
+			if (n > max_size())
+				throw std::length_error("compact_map::reserve");
+			if (n > _capacity)
+				reallocate(static_cast<uint32_t>(n));
+		}
+
+	/*
+	* ---------- ELEMENT ACCESS ----------------------------------------------------- *
+	*/
+		mapped_type& at(const key_type& key)
+		{
+			uint32_t index = search_by_key(key);
+			if (index == nil)
+				throw std::out_of_range("compact_map::at:  key not found");
+			return _nodes[index].value.second;
+		}
+
+		const mapped_type& at(const key_type& key) const
+		{
+			uint32_t index = search_by_key(key);
+			if (index == nil)
+				throw std::out_of_range("compact_map::at:  key not found");
+			return _nodes[index].value.second;
+		}
+
+		mapped_type& operator[](const key_type& key)
+		{
+			uint32_t parent;
+			int side;
+			uint32_t index = find_slot(key, parent, side);
+
+			if (index == nil)
+				index = link_node(parent, side, value_type(key, mapped_type()));
+			return _nodes[index].value.second;
+		}
+
+	/*
+	* --------------- MODIFIERS ------------------------------------------------------ *
+	*/
+		/* destroys the elements, keeps the array */
+		void clear()
+		{
+			for (uint32_t i = 0; i < _used; ++i)
+				if (_nodes[i].height)
+					_alloc.destroy(&_nodes[i].value);
+			_used = 0;
+			_free = nil;
+			_root = nil;
+			_first = nil;
+			_last = nil;
+			_node_count = 0;
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value)
+		{
+			uint32_t parent;
+			int side;
+			uint32_t index = find_slot(value.first, parent, side);
+
+			if (index != nil)
+				return ft::make_pair(iterator(this, index), false);
+			return ft::make_pair(iterator(this, link_node(parent, side, value)), true);
+		}
+
+		/* the hint is only used when it is end() and value goes last */
+		iterator insert(iterator pos, const value_type& value)
+		{
+			if (pos.index() == nil && _last != nil && _comp(key_of(_last), value.first))
+				return iterator(this, link_node(_last, 1, value));
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last)
+		{
+			for(; first != last; ++first)
+				insert(end(), *first);
+		}
+
+		void erase(iterator pos)
+		{
+			erase_node(pos.index());
+		}
+
+		void erase(iterator first, iterator last)
+		{
+			while (first != last)
+				erase(first++);
+		}
+
+		size_type erase(const key_type& key)
+		{
+			uint32_t index = search_by_key(key);
+			if (index == nil)
+				return 0;
+			erase_node(index);
+			return 1;
+		}
+
+		void swap(compact_map& other)
+		{
+			std::swap(_nodes, other._nodes);
+			std::swap(_capacity, other._capacity);
+			std::swap(_used, other._used);
+			std::swap(_free, other._free);
+			std::swap(_root, other._root);
+			std::swap(_first, other._first);
+			std::swap(_last, other._last);
+			std::swap(_node_count, other._node_count);
+			std::swap(_alloc, other._alloc);
+			std::swap(_node_alloc, other._node_alloc);
+			std::swap(_comp, other._comp);
+		}
+
+	/*
+	* --------------- LOOK-UP --------------------------------------------------- *
+	*/
+		size_type count(const key_type& key) const { return search_by_key(key) != nil; }
+
+		iterator find(const key_type& key) { return iterator(this, search_by_key(key)); }
+		const_iterator find(const key_type& key) const { return const_iterator(this, search_by_key(key)); }
+
+		iterator lower_bound(const key_type& key) { return iterator(this, lower_bound_index(key)); }
+		const_iterator lower_bound(const key_type& key) const { return const_iterator(this, lower_bound_index(key)); }
+
+		iterator upper_bound(const key_type& key) { return iterator(this, upper_bound_index(key)); }
+		const_iterator upper_bound(const key_type& key) const { return const_iterator(this, upper_bound_index(key)); }
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key)
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+	/*
+	* --------------- OBSERVERS -------------------------------------------------- *
+	*/
+		key_compare key_comp() const { return _comp; }
+
+		value_compare value_comp() const { return value_compare(_comp); }
+
+	/*
+	* --------------- INTROSPECTION ---------------------------------------------- *
+	*/
+		/* Bytes owned by the map: the object itself and its array. */
+		size_type memory_usage() const
+		{
+			return sizeof(*this) + static_cast<size_type>(_capacity) * sizeof(Node);
+		}
+
+	private:
+		Node*			_nodes;
+		uint32_t		_capacity;
+		uint32_t		_used; // slots ever handed out, [_used, _capacity) never was
+		uint32_t		_free; // free list head
+		uint32_t		_root;
+		uint32_t		_first;
+		uint32_t		_last;
+		size_type 		_node_count;
+		allocator_type	_alloc;
+		node_alloc 	 	_node_alloc;
+		key_compare		_comp;
+
+		const key_type& key_of(uint32_t index) const { return _nodes[index].value.first; }
+		uint32_t& parent(uint32_t index) const { return _nodes[index].parent; }
+		uint32_t& child(uint32_t index, int side) const { return _nodes[index].child[side]; }
+
+		/* moves the live elements to an array of new_capacity slots; the slot
+		* indices, hence the links and the free list, are kept */
+		void reallocate(uint32_t new_capacity)
+		{
+			Node* nodes = _node_alloc.allocate(new_capacity);
+			uint32_t i = 0;
+
+			try
+			{
+				for (; i < _used; ++i)
+				{
+					nodes[i].parent = _nodes[i].parent;
+					nodes[i].child[0] = _nodes[i].child[0];
+					nodes[i].child[1] = _nodes[i].child[1];
+					nodes[i].height = _nodes[i].height;
+					if (_nodes[i].height)
+						_alloc.construct(&nodes[i].value, _nodes[i].value);
+				}
+			}
+			catch (...)
+			{
+				while (i-- > 0)
+					if (nodes[i].height)
+						_alloc.destroy(&nodes[i].value);
+				_node_alloc.deallocate(nodes, new_capacity);
+				throw;
+			}
+			for (i = 0; i < _used; ++i)
+				if (_nodes[i].height)
+					_alloc.destroy(&_nodes[i].value);
+			if (_nodes)
+				_node_alloc.deallocate(_nodes, _capacity);
+			_nodes = nodes;
+			_capacity = new_capacity;
+		}
+
+		uint32_t new_slot(const value_type& value)
+		{
+			if (_free == nil && _used == _capacity)
+			{
+				if (_node_count >= max_size())
+					throw std::length_error("compact_map: too many elements");
+				size_type grown = _capacity < 8 ? 16 : static_cast<size_type>(_capacity) * 2;
+				reallocate(static_cast<uint32_t>(std::min(grown, max_size())));
+			}
+			uint32_t index = _free != nil ? _free : _used;
+			_alloc.construct(&_nodes[index].value, value);
+			if (index == _free)
+				_free = _nodes[index].parent;
+			else
+				_used++;
+			_nodes[index].parent = nil;
+			_nodes[index].child[0] = nil;
+			_nodes[index].child[1] = nil;
+			_nodes[index].height = 1;
+			return index;
+		}
+
+		void release_slot(uint32_t index)
+		{
+			_alloc.destroy(&_nodes[index].value);
+			_nodes[index].height = 0;
+			_nodes[index].parent = _free;
+			_free = index;
+		}
+
+		uint32_t search_by_key(const key_type& key) const
+		{
+			uint32_t index = _root;
+
+			while (index != nil)
+			{
+				if (_comp(key, key_of(index)))
+					index = child(index, 0);
+				else if (_comp(key_of(index), key))
+					index = child(index, 1);
+				else
+					return index;
+			}
+			return nil;
+		}
+
+		/* the index holding key, or nil and the slot where it would go */
+		uint32_t find_slot(const key_type& key, uint32_t& parent_index, int& side) const
+		{
+			uint32_t index = _root;
+
+			parent_index = nil;
+			side = 0;
+			while (index != nil)
+			{
+				parent_index = index;
+				if (_comp(key, key_of(index)))
+					side = 0;
+				else if (_comp(key_of(index), key))
+					side = 1;
+				else
+					return index;
+				index = child(index, side);
+			}
+			return nil;
+		}
+
+		uint32_t lower_bound_index(const key_type& key) const
+		{
+			uint32_t index = _root;
+			uint32_t result = nil;
+
+			while (index != nil)
+			{
+				if (_comp(key_of(index), key))
+					index = child(index, 1);
+				else
+				{
+					result = index;
+					index = child(index, 0);
+				}
+			}
+			return result;
+		}
+
+		uint32_t upper_bound_index(const key_type& key) const
+		{
+			uint32_t index = _root;
+			uint32_t result = nil;
+
+			while (index != nil)
+			{
+				if (_comp(key, key_of(index)))
+				{
+					result = index;
+					index = child(index, 0);
+				}
+				else
+					index = child(index, 1);
+			}
+			return result;
+		}
+
+		uint32_t minimum(uint32_t index) const
+		{
+			while (child(index, 0) != nil)
+				index = child(index, 0);
+			return index;
+		}
+
+		uint32_t maximum(uint32_t index) const
+		{
+			while (child(index, 1) != nil)
+				index = child(index, 1);
+			return index;
+		}
+
+		/* end() wraps around to begin(), like ft::map */
+		uint32_t successor(uint32_t index) const
+		{
+			if (index == nil)
+				return _first;
+			if (child(index, 1) != nil)
+				return minimum(child(index, 1));
+			uint32_t up = parent(index);
+			while (up != nil && index == child(up, 1))
+			{
+				index = up;
+				up = parent(up);
+			}
+			return up;
+		}
+
+		uint32_t predecessor(uint32_t index) const
+		{
+			if (index == nil)
+				return _last;
+			if (child(index, 0) != nil)
+				return maximum(child(index, 0));
+			uint32_t up = parent(index);
+			while (up != nil && index == child(up, 0))
+			{
+				index = up;
+				up = parent(up);
+			}
+			return up;
+		}
+
+		uint32_t link_node(uint32_t parent_index, int side, const value_type& value)
+		{
+			uint32_t index = new_slot(value);
+
+			parent(index) = parent_index;
+			if (parent_index == nil)
+			{
+				_root = index;
+				_first = index;
+				_last = index;
+			}
+			else
+			{
+				child(parent_index, side) = index;
+				if (side == 0 && parent_index == _first)
+					_first = index;
+				if (side == 1 && parent_index == _last)
+					_last = index;
+			}
+			_node_count++;
+			rebalance(parent_index);
+			return index;
+		}
+
+		/* makes new_index the child of old_index's parent in place of old_index */
+		void replace_child(uint32_t old_index, uint32_t new_index)
+		{
+			uint32_t up = parent(old_index);
+
+			if (up == nil)
+				_root = new_index;
+			else
+				child(up, child(up, 0) == old_index ? 0 : 1) = new_index;
+			if (new_index != nil)
+				parent(new_index) = up;
+		}
+
+		/* the successor takes the place of a node with two children: the other
+		* elements keep their slots */
+		void erase_node(uint32_t index)
+		{
+			uint32_t to_balance;
+			uint32_t left = child(index, 0);
+			uint32_t right = child(index, 1);
+
+			if (index == _first)
+				_first = successor(index);
+			if (index == _last)
+				_last = predecessor(index);
+			if (left == nil || right == nil)
+			{
+				to_balance = parent(index);
+				replace_child(index, left != nil ? left : right);
+			}
+			else
+			{
+				uint32_t next = minimum(right);
+				if (parent(next) != index)
+				{
+					to_balance = parent(next);
+					replace_child(next, child(next, 1));
+					child(next, 1) = right;
+					parent(right) = next;
+				}
+				else
+					to_balance = next;
+				replace_child(index, next);
+				child(next, 0) = left;
+				parent(left) = next;
+				_nodes[next].height = _nodes[index].height;
+			}
+			release_slot(index);
+			_node_count--;
+			rebalance(to_balance);
+		}
+
+		uint32_t height(uint32_t index) const
+		{
+			return index == nil ? 0 : _nodes[index].height;
+		}
+
+		void update_height(uint32_t index)
+		{
+			uint32_t left_height = height(child(index, 0));
+			uint32_t right_height = height(child(index, 1));
+
+			_nodes[index].height = std::max(left_height, right_height) + 1;
+		}
+
+		/* side 0: the left child goes up (right rotation), side 1: the right one */
+		void rotate(uint32_t index, int side)
+		{
+			uint32_t up = child(index, side);
+			uint32_t center = child(up, 1 - side);
+
+			child(index, side) = center;
+			if (center != nil)
+				parent(center) = index;
+			replace_child(index, up);
+			child(up, 1 - side) = index;
+			parent(index) = up;
+			update_height(index);
+			update_height(up);
+		}
+
+		/* same walk as ft::avl_balance: stops once a subtree keeps its height */
+		void rebalance(uint32_t index)
+		{
+			while (index != nil)
+			{
+				uint32_t old_height = _nodes[index].height;
+				int balance_factor = static_cast<int>(height(child(index, 0))) - static_cast<int>(height(child(index, 1)));
+
+				if (balance_factor > 1 || balance_factor < -1)
+				{
+					int heavy = balance_factor > 1 ? 0 : 1;
+					uint32_t heavy_child = child(index, heavy);
+					if (height(child(heavy_child, heavy)) < height(child(heavy_child, 1 - heavy)))
+						rotate(heavy_child, 1 - heavy);
+					rotate(index, heavy);
+					index = parent(index);
+				}
+				else
+					update_height(index);
+				if (_nodes[index].height == old_height)
+					break;
+				index = parent(index);
+			}
+		}
+};
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const uint32_t compact_map<Key, T, Compare, Allocator>::nil;
+
+/*----------------------------- NON-MEMBER FUNCTIONS ---------------------------------------*/
+template<class Key, class T, class Compare, class Alloc>
+void swap( ft::compact_map<Key, T, Compare, Alloc>& lhs, ft::compact_map<Key, T, Compare, Alloc>& rhs )
+{
+	lhs.swap(rhs);
+}
+
+template< class Key, class T, class Compare, class Alloc >
+bool operator==( const ft::compact_map<Key, T, Compare, Alloc>& x,
+                 const ft::compact_map<Key, T, Compare, Alloc>& y )
+{
+	return (x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()));
+}
+
+template< class Key, class T, class Compare, class Alloc >
+bool operator!=( const ft::compact_map<Key, T, Compare, Alloc>& x,
+                 const ft::compact_map<Key, T, Compare, Alloc>& y )
+{
+	return !(x == y);
+}
+
+template< class Key, class T, class Compare, class Alloc >
+bool operator<( const ft::compact_map<Key, T, Compare, Alloc>& x,
+                const ft::compact_map<Key, T, Compare, Alloc>& y )
+{
+	return (ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+}
+
+template< class Key, class T, class Compare, class Alloc >
+bool operator<=( const ft::compact_map<Key, T, Compare, Alloc>& x,
+                 const ft::compact_map<Key, T, Compare, Alloc>& y )
+{
+	return !(y < x);
+}
+
+template< class Key, class T, class Compare, class Alloc >
+bool operator>( const ft::compact_map<Key, T, Compare, Alloc>& x,
+                const ft::compact_map<Key, T, Compare, Alloc>& y )
+{
+	return (y < x);
+}
+
+template< class Key, class T, class Compare, class Alloc >
+bool operator>=( const ft::compact_map<Key, T, Compare, Alloc>& x,
+                 const ft::compact_map<Key, T, Compare, Alloc>& y )
+{
+	return !(x < y);
+}
+
+} // namespace
+
+#endif
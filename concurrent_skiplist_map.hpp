@@ -0,0 +1,732 @@
+#ifndef CONCURRENT_SKIPLIST_MAP_HPP
+#define CONCURRENT_SKIPLIST_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <stdint.h>
+#include <sched.h>
+
+#include "utility.hpp"
+
+/*
+* ft::concurrent_skiplist_map: an ordered map that threads insert into,
+* erase from and read concurrently, without a lock. A lock-free skip list:
+*
+*	insert		links the node at level 0 with one compare-and-swap, then
+*				at its upper levels, one CAS each
+*	erase		marks the node's links (lowest bit set) from its top level
+*				down: the thread whose mark lands at level 0 owns the
+*				erase; a search then unlinks the node at every level
+*	look-ups	never write: they step over marked nodes
+*
+* Every search that meets a marked node on its way unlinks it, so erased
+* nodes do not stay in the list for long.
+*
+* An unlinked node may still be read by a thread that was passing by, so
+* it is freed later, by epochs: an operation pins the global epoch in one
+* of the map's slots; a node erased in epoch e is freed once the epoch
+* reached e + 2, when every operation that could have seen it is over. The
+* epoch advances when every pinned slot shows the current one.
+*
+* An erase waits for the insertion of its node to have linked all of its
+* levels (a few CAS): a node is never unlinked while being linked.
+*
+* Iterators are forward iterators over level 0, in key order, skipping the
+* erased elements. An iterator, a pointer or a reference stays valid while
+* the thread holds a guard on the map, or while no other thread erases:
+*
+*	{
+*		map_type::guard pin(map);
+*		for (map_type::iterator it = map.lower_bound(a); it != map.end() && it->first < b; ++it)
+*			...
+*	}
+*
+* Only the element links are concurrent: two threads writing the mapped
+* value of the same element need their own synchronization. size() is
+* exact when no insert or erase runs. Copy, assignment, swap, clear and
+* the destructor must not run concurrently with anything else.
+*
+* The atomics are the __atomic builtins of gcc and clang.
+*/
+
+namespace ft {
+
+template <typename Value>
+struct skiplist_node
+{
+	enum { max_height = 16 };
+
+	skiplist_node*	retired;		/* list of the nodes waiting to be freed */
+	unsigned long	retire_epoch;
+	int				height;
+	int				linked;			/* all levels linked by the insertion */
+	Value			value;
+	skiplist_node*	next[1];		/* height links, the lowest bit marks an erase */
+};
+
+/* one pinned operation; 0 is a free slot, a line each */
+struct epoch_slot
+{
+	unsigned long		epoch;
+	unsigned long long	seed;
+	char				padding[64 - sizeof(unsigned long) - sizeof(unsigned long long)];
+};
+
+/* Value is the map's value_type or its const version */
+template <typename Node, typename Value>
+class skiplist_map_iterator
+{
+	public:
+		typedef Value									value_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef std::forward_iterator_tag				iterator_category;
+		typedef Value*									pointer;
+		typedef Value&									reference;
+
+	private:
+		Node*											_node;
+
+	public:
+		skiplist_map_iterator() : _node(NULL) {}
+
+		explicit skiplist_map_iterator(Node* node) : _node(node) {}
+
+		template <typename V>
+		skiplist_map_iterator(const skiplist_map_iterator<Node, V>& other) : _node(other.base()) {}
+
+		Node* base() const { return _node; }
+
+		reference operator*() const { return _node->value; }
+		pointer operator->() const { return &_node->value; }
+
+		/* the next element not erased */
+		skiplist_map_iterator& operator++()
+		{
+			Node* next = unmark(__atomic_load_n(&_node->next[0], __ATOMIC_ACQUIRE));
+			while (next && is_marked(__atomic_load_n(&next->next[0], __ATOMIC_ACQUIRE)))
+				next = unmark(__atomic_load_n(&next->next[0], __ATOMIC_ACQUIRE));
+			_node = next;
+			return *this;
+		}
+
+		skiplist_map_iterator operator++(int)
+		{
+			skiplist_map_iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		template <typename V>
+		bool operator==(const skiplist_map_iterator<Node, V>& x) const { return _node == x.base(); }
+
+		template <typename V>
+		bool operator!=(const skiplist_map_iterator<Node, V>& x) const { return _node != x.base(); }
+
+		static bool is_marked(Node* link) { return reinterpret_cast<uintptr_t>(link) & 1; }
+		static Node* unmark(Node* link) { return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(link) & ~static_cast<uintptr_t>(1)); }
+};
+
+template<typename Key, typename T, typename Compare = std::less<Key>,
+	typename Allocator = std::allocator<ft::pair<const Key, T> > >
+class concurrent_skiplist_map {
+
+	/*MEMBER TYPES*/
+	public:
+		typedef Key																key_type;
+		typedef T																mapped_type;
+		typedef Compare															key_compare;
+		typedef Allocator 														allocator_type;
+
+		typedef ft::pair<const key_type, mapped_type>							value_type;
+		typedef std::ptrdiff_t 													difference_type;
+		typedef std::size_t 													size_type;
+
+		typedef value_type& 													reference;
+		typedef const value_type& 												const_reference;
+		typedef typename Allocator::pointer										pointer;
+		typedef typename Allocator::const_pointer								const_pointer;
+
+	private:
+		typedef skiplist_node<value_type>										node;
+
+	public:
+		typedef skiplist_map_iterator<node, value_type>							iterator;
+		typedef skiplist_map_iterator<node, const value_type>					const_iterator;
+
+	private:
+		/* nodes are allocated in pointer-sized words: their size depends on their height */
+		typedef typename Allocator::template rebind<node*>::other				word_alloc;
+		typedef typename Allocator::template rebind<epoch_slot>::other			slot_alloc;
+
+		enum { max_height = node::max_height };
+		enum { slot_count = 128 };
+		enum { reclaim_period = 64 };	/* erases between two reclamations */
+
+	public:
+		/*
+		* Pins the calling thread's view of the map: nothing it reaches is
+		* freed before the guard is destroyed. Every operation takes one;
+		* iterations that race with erases need their own.
+		*/
+		class guard
+		{
+			private:
+				epoch_slot*						_slot;
+
+				guard(const guard&);
+				guard& operator=(const guard&);
+
+			public:
+				explicit guard(const concurrent_skiplist_map& map) : _slot(map.pin()) {}
+				~guard() { __atomic_store_n(&_slot->epoch, 0UL, __ATOMIC_RELEASE); }
+
+				epoch_slot* slot() const { return _slot; }
+		};
+
+		/* -- CONSTRUCTORS - DESTUCTORS -- */
+
+		explicit concurrent_skiplist_map(const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()):
+			_comp(comp),
+			_alloc(alloc)
+		{
+			init();
+		}
+
+		template<typename InputIt>
+		concurrent_skiplist_map(InputIt first, InputIt last, const key_compare& comp = key_compare(),
+			const allocator_type& alloc = allocator_type()):
+			_comp(comp),
+			_alloc(alloc)
+		{
+			init();
+			try
+			{
+				insert(first, last);
+			}
+			catch (...)
+			{
+				release();
+				throw;
+			}
+		}
+
+		concurrent_skiplist_map(const concurrent_skiplist_map& other):
+			_comp(other._comp),
+			_alloc(other._alloc)
+		{
+			init();
+			try
+			{
+				insert(other.begin(), other.end());
+			}
+			catch (...)
+			{
+				release();
+				throw;
+			}
+		}
+
+		~concurrent_skiplist_map()
+		{
+			release();
+		}
+
+		concurrent_skiplist_map& operator=(const concurrent_skiplist_map& other)
+		{
+			concurrent_skiplist_map temp(other);
+			swap(temp);
+			return *this;
+		}
+
+		allocator_type get_allocator() const { return _alloc; }
+
+	/* ---------- ITERATORS --------------------------------------------------------- */
+		iterator begin() { return iterator(first_live(unmark(__atomic_load_n(&_head->next[0], __ATOMIC_ACQUIRE)))); }
+		const_iterator begin() const { return const_cast<concurrent_skiplist_map*>(this)->begin(); }
+
+		iterator end() { return iterator(NULL); }
+		const_iterator end() const { return const_iterator(NULL); }
+
+	/*
+	* ---------- CAPACITY --------------------------------------------------------- *
+	*/
+		bool empty() const { return size() == 0; }
+
+		size_type size() const { return __atomic_load_n(&_size, __ATOMIC_RELAXED); }
+
+		size_type max_size() const { return word_alloc(_alloc).max_size() / (sizeof(node) / sizeof(node*) + 1); }
+
+	/*
+	* ---------- ELEMENT ACCESS ----------------------------------------------------- *
+	*/
+		mapped_type& at(const key_type& key)
+		{
+			iterator found = find(key);
+			if (found == end())
+				throw std::out_of_range("concurrent_skiplist_map::at:  key not found");
+			return found->second;
+		}
+
+		const mapped_type& at(const key_type& key) const
+		{
+			const_iterator found = find(key);
+			if (found == end())
+				throw std::out_of_range("concurrent_skiplist_map::at:  key not found");
+			return found->second;
+		}
+
+		mapped_type& operator[](const key_type& key)
+		{
+			iterator found = find(key);
+			if (found != end())
+				return found->second;
+			return insert(value_type(key, mapped_type())).first->second;
+		}
+
+	/*
+	* --------------- MODIFIERS ------------------------------------------------------ *
+	*/
+		/* not concurrent */
+		void clear()
+		{
+			node* n = unmark(_head->next[0]);
+			while (n)
+			{
+				node* next = unmark(n->next[0]);
+				free_node(n);
+				n = next;
+			}
+			for (int level = 0; level < max_height; ++level)
+				_head->next[level] = NULL;
+			free_retired(~0UL);
+			_size = 0;
+		}
+
+		/**
+		*  @brief  Inserts @a value unless its key is present. Lock-free.
+		*  @return  The element with that key, and whether it is @a value.
+		*/
+		ft::pair<iterator, bool> insert(const value_type& value)
+		{
+			guard pin(*this);
+			node* preds[max_height];
+			node* succs[max_height];
+			node* created = NULL;
+
+			for (;;)
+			{
+				if (search(value.first, preds, succs))
+				{
+					if (created)
+						free_node(created);
+					return ft::make_pair(iterator(succs[0]), false);
+				}
+				if (!created)
+					created = new_node(value, random_height(pin.slot()));
+				int height = created->height;
+				for (int level = 0; level < height; ++level)
+					__atomic_store_n(&created->next[level], succs[level], __ATOMIC_RELAXED);
+				node* expected = succs[0];
+				if (__atomic_compare_exchange_n(&preds[0]->next[0], &expected, created, false,
+						__ATOMIC_RELEASE, __ATOMIC_RELAXED))
+					break;
+			}
+			__atomic_add_fetch(&_size, 1, __ATOMIC_RELAXED);
+			for (int level = 1; level < created->height; ++level)
+			{
+				for (;;)
+				{
+					node* expected = succs[level];
+					if (__atomic_compare_exchange_n(&preds[level]->next[level], &expected, created, false,
+							__ATOMIC_RELEASE, __ATOMIC_RELAXED))
+						break;
+					/* the neighbours changed: nobody else writes this level of
+					* the node before it is linked there */
+					search(created->value.first, preds, succs);
+					__atomic_store_n(&created->next[level], succs[level], __ATOMIC_RELAXED);
+				}
+			}
+			__atomic_store_n(&created->linked, 1, __ATOMIC_RELEASE);
+			return ft::make_pair(iterator(created), true);
+		}
+
+		/* the hint is not used */
+		iterator insert(iterator, const value_type& value)
+		{
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last)
+		{
+			for(; first != last; ++first)
+				insert(*first);
+		}
+
+		/**
+		*  @brief  Erases the element with key @a key. Lock-free but for the
+		*  wait on an insertion still linking that element.
+		*  @return  1 if this call erased it, 0 otherwise.
+		*/
+		size_type erase(const key_type& key)
+		{
+			guard pin(*this);
+			node* preds[max_height];
+			node* succs[max_height];
+
+			if (!search(key, preds, succs))
+				return 0;
+			node* victim = succs[0];
+			while (!__atomic_load_n(&victim->linked, __ATOMIC_ACQUIRE))
+				sched_yield();
+			for (int level = victim->height - 1; level > 0; --level)
+				mark(victim, level);
+			if (!mark(victim, 0))
+				return 0;
+			/* owned: unlinked from every level by a search */
+			search(key, preds, succs);
+			__atomic_sub_fetch(&_size, 1, __ATOMIC_RELAXED);
+			retire(victim);
+			return 1;
+		}
+
+		void erase(iterator pos)
+		{
+			erase(pos->first);
+		}
+
+		/* not concurrent */
+		void swap(concurrent_skiplist_map& other)
+		{
+			std::swap(_head, other._head);
+			std::swap(_size, other._size);
+			std::swap(_epoch, other._epoch);
+			std::swap(_slots, other._slots);
+			std::swap(_retired, other._retired);
+			std::swap(_erases, other._erases);
+			std::swap(_comp, other._comp);
+			std::swap(_alloc, other._alloc);
+		}
+
+	/*
+	* --------------- LOOK-UP --------------------------------------------------- *
+	*/
+		size_type count(const key_type& key) const { return find(key) != end(); }
+
+		iterator find(const key_type& key)
+		{
+			guard pin(*this);
+			node* found = first_live(bound(key, true));
+			return iterator(found && !_comp(key, found->value.first) ? found : NULL);
+		}
+
+		const_iterator find(const key_type& key) const
+		{
+			return const_cast<concurrent_skiplist_map*>(this)->find(key);
+		}
+
+		/* Wait-free: no write, no retry. */
+		iterator lower_bound(const key_type& key)
+		{
+			guard pin(*this);
+			return iterator(first_live(bound(key, true)));
+		}
+
+		const_iterator lower_bound(const key_type& key) const
+		{
+			return const_cast<concurrent_skiplist_map*>(this)->lower_bound(key);
+		}
+
+		iterator upper_bound(const key_type& key)
+		{
+			guard pin(*this);
+			return iterator(first_live(bound(key, false)));
+		}
+
+		const_iterator upper_bound(const key_type& key) const
+		{
+			return const_cast<concurrent_skiplist_map*>(this)->upper_bound(key);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key)
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+	/*
+	* --------------- OBSERVERS -------------------------------------------------- *
+	*/
+		key_compare key_comp() const { return _comp; }
+
+	private:
+		friend class guard;
+
+		node*			_head;		// max_height links, no value
+		size_type		_size;
+		unsigned long	_epoch;
+		epoch_slot*		_slots;
+		node*			_retired;	// erased nodes, through node::retired
+		unsigned long	_erases;
+		key_compare		_comp;
+		allocator_type	_alloc;
+
+		static bool is_marked(node* link) { return reinterpret_cast<uintptr_t>(link) & 1; }
+		static node* unmark(node* link) { return reinterpret_cast<node*>(reinterpret_cast<uintptr_t>(link) & ~static_cast<uintptr_t>(1)); }
+		static node* marked(node* link) { return reinterpret_cast<node*>(reinterpret_cast<uintptr_t>(link) | 1); }
+
+		static size_type words(int height)
+		{
+			return (sizeof(node) + (height - 1) * sizeof(node*) + sizeof(node*) - 1) / sizeof(node*);
+		}
+
+		void init()
+		{
+			_size = 0;
+			_epoch = 1;
+			_retired = NULL;
+			_erases = 0;
+			_slots = NULL;
+			_head = NULL;
+			slot_alloc slots(_alloc);
+			_slots = slots.allocate(slot_count);
+			for (int i = 0; i < slot_count; ++i)
+			{
+				_slots[i].epoch = 0;
+				_slots[i].seed = 0x9E3779B97F4A7C15ULL * (i + 1);
+			}
+			try
+			{
+				_head = reinterpret_cast<node*>(word_alloc(_alloc).allocate(words(max_height)));
+			}
+			catch (...)
+			{
+				slots.deallocate(_slots, slot_count);
+				throw;
+			}
+			_head->height = max_height;
+			_head->linked = 1;
+			for (int level = 0; level < max_height; ++level)
+				_head->next[level] = NULL;
+		}
+
+		void release()
+		{
+			clear();
+			word_alloc(_alloc).deallocate(reinterpret_cast<node**>(_head), words(max_height));
+			slot_alloc(_alloc).deallocate(_slots, slot_count);
+		}
+
+		node* new_node(const value_type& value, int height)
+		{
+			node* n = reinterpret_cast<node*>(word_alloc(_alloc).allocate(words(height)));
+			try
+			{
+				_alloc.construct(&n->value, value);
+			}
+			catch (...)
+			{
+				word_alloc(_alloc).deallocate(reinterpret_cast<node**>(n), words(height));
+				throw;
+			}
+			n->retired = NULL;
+			n->retire_epoch = 0;
+			n->height = height;
+			n->linked = 0;
+			return n;
+		}
+
+		void free_node(node* n)
+		{
+			_alloc.destroy(&n->value);
+			word_alloc(_alloc).deallocate(reinterpret_cast<node**>(n), words(n->height));
+		}
+
+		/* p = 1/4 per level, from the pinned slot's own generator */
+		static int random_height(epoch_slot* slot)
+		{
+			unsigned long long r = slot->seed;
+			r ^= r << 13;
+			r ^= r >> 7;
+			r ^= r << 17;
+			slot->seed = r;
+			int height = 1;
+			while (height < max_height && (r & 3) == 0)
+			{
+				++height;
+				r >>= 2;
+			}
+			return height;
+		}
+
+	/* ---------- epochs ---------- */
+
+		/* a free slot, near the one of the last operation of this thread:
+		* the stack address tells threads apart */
+		epoch_slot* pin() const
+		{
+			int local = 0;
+			unsigned long start = static_cast<unsigned long>(
+				(reinterpret_cast<uintptr_t>(&local) >> 12) * 0x9E3779B97F4A7C15ULL >> 40);
+
+			for (unsigned long i = start; ; ++i)
+			{
+				epoch_slot* slot = &_slots[i % slot_count];
+				unsigned long expected = 0;
+				unsigned long epoch = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+				if (__atomic_load_n(&slot->epoch, __ATOMIC_RELAXED) == 0
+					&& __atomic_compare_exchange_n(&slot->epoch, &expected, epoch, false,
+						__ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+					return slot;
+				if ((i - start) % slot_count == slot_count - 1)
+					sched_yield();
+			}
+		}
+
+		/* n is unlinked: only the operations pinned now can reach it */
+		void retire(node* n)
+		{
+			n->retire_epoch = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+			push_retired(n);
+			if (__atomic_add_fetch(&_erases, 1, __ATOMIC_RELAXED) % reclaim_period == 0)
+			{
+				try_advance();
+				free_retired(__atomic_load_n(&_epoch, __ATOMIC_SEQ_CST));
+			}
+		}
+
+		void push_retired(node* n)
+		{
+			node* head = __atomic_load_n(&_retired, __ATOMIC_RELAXED);
+			do
+				n->retired = head;
+			while (!__atomic_compare_exchange_n(&_retired, &head, n, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+		}
+
+		/* the epoch moves on once every pinned operation has seen it */
+		void try_advance()
+		{
+			unsigned long epoch = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+
+			for (int i = 0; i < slot_count; ++i)
+			{
+				unsigned long pinned = __atomic_load_n(&_slots[i].epoch, __ATOMIC_SEQ_CST);
+				if (pinned != 0 && pinned != epoch)
+					return;
+			}
+			__atomic_compare_exchange_n(&_epoch, &epoch, epoch + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+		}
+
+		/* frees the nodes retired two epochs before epoch, keeps the others */
+		void free_retired(unsigned long epoch)
+		{
+			node* n = __atomic_exchange_n(&_retired, static_cast<node*>(NULL), __ATOMIC_ACQUIRE);
+
+			while (n)
+			{
+				node* next = n->retired;
+				if (epoch == ~0UL || n->retire_epoch + 2 <= epoch)
+					free_node(n);
+				else
+					push_retired(n);
+				n = next;
+			}
+		}
+
+	/* ---------- the list ---------- */
+
+		/* sets the mark of the level's link; true if this call set it */
+		static bool mark(node* n, int level)
+		{
+			node* link = __atomic_load_n(&n->next[level], __ATOMIC_ACQUIRE);
+
+			while (!is_marked(link))
+			{
+				if (__atomic_compare_exchange_n(&n->next[level], &link, marked(link), false,
+						__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+					return true;
+			}
+			return false;
+		}
+
+		/*
+		* The last node before key and the first one from key, at every
+		* level, unlinking the marked nodes met on the way. True if the
+		* latter at level 0 has key.
+		*/
+		bool search(const key_type& key, node** preds, node** succs)
+		{
+		retry:
+			node* pred = _head;
+			node* curr = NULL;
+			for (int level = max_height - 1; level >= 0; --level)
+			{
+				curr = unmark(__atomic_load_n(&pred->next[level], __ATOMIC_ACQUIRE));
+				while (curr)
+				{
+					node* succ = __atomic_load_n(&curr->next[level], __ATOMIC_ACQUIRE);
+					if (is_marked(succ))
+					{
+						node* expected = curr;
+						if (!__atomic_compare_exchange_n(&pred->next[level], &expected, unmark(succ), false,
+								__ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+							goto retry;
+						curr = unmark(succ);
+						continue;
+					}
+					if (!_comp(curr->value.first, key))
+						break;
+					pred = curr;
+					curr = succ;
+				}
+				preds[level] = pred;
+				succs[level] = curr;
+			}
+			return curr && !_comp(key, curr->value.first);
+		}
+
+		/* the first node from key (not_less) or after it, erased or not */
+		node* bound(const key_type& key, bool not_less) const
+		{
+			node* pred = _head;
+			node* curr = NULL;
+
+			for (int level = max_height - 1; level >= 0; --level)
+			{
+				curr = unmark(__atomic_load_n(&pred->next[level], __ATOMIC_ACQUIRE));
+				while (curr && (not_less ? _comp(curr->value.first, key) : !_comp(key, curr->value.first)))
+				{
+					pred = curr;
+					curr = unmark(__atomic_load_n(&curr->next[level], __ATOMIC_ACQUIRE));
+				}
+			}
+			return curr;
+		}
+
+		/* n or the first node after it that is not erased */
+		static node* first_live(node* n)
+		{
+			while (n && is_marked(__atomic_load_n(&n->next[0], __ATOMIC_ACQUIRE)))
+				n = unmark(__atomic_load_n(&n->next[0], __ATOMIC_ACQUIRE));
+			return n;
+		}
+};
+
+/*----------------------------- NON-MEMBER FUNCTIONS ---------------------------------------*/
+template<class Key, class T, class Compare, class Alloc>
+void swap(ft::concurrent_skiplist_map<Key, T, Compare, Alloc>& lhs, ft::concurrent_skiplist_map<Key, T, Compare, Alloc>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,495 @@
+#ifndef DURABLE_MAP_HPP
+#define DURABLE_MAP_HPP
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "file_io.hpp"
+#include "map.hpp"
+#include "snapshot.hpp"
+
+/*
+* Crash-safe ft::map: every mutation is appended to a write-ahead log before it
+* is acknowledged, and the whole tree is periodically checkpointed to a snapshot
+* so that the log stays short.
+*
+* Files, for a durable_map opened on "<path>":
+*
+*	<path>.snap	[u64 generation][snapshot, see snapshot.hpp]
+*	<path>.wal	[magic "FTWAL\0\0\0"][u32 version][u32 reserved][u64 generation]
+*			[records...]
+*
+* A record is [u8 op][payload][u64 payload size][u64 FNV-1a of op + payload],
+* the payload being encoded by the Codec (see below). A checkpoint writes the
+* snapshot tagged with generation g + 1, then starts a fresh log of generation
+* g + 1; opening replays the log only if its generation is not older than the
+* snapshot's, so a crash between the two steps never replays a record twice.
+* A torn or corrupted tail (crash in the middle of an append) ends the replay
+* and is cut off the log. A record left unfinished by an exception (a
+* throwing codec, a write error) is such a tail too: the map then refuses
+* modifications with std::runtime_error, as any record after it would be cut
+* off with it, until checkpoint() starts a new log.
+*
+* Group commit: records accumulate in the log writer's buffer and are written
+* and fsync'ed together every durable_options::sync_every records, or when
+* sync() is called. Only records covered by a completed sync() are guaranteed
+* to survive a power loss; a process crash only loses what is still buffered.
+*
+* The Codec extends the snapshot codec (see ft::raw_codec) with key records:
+*
+*	codec(ft::file_writer&, const value_type&)	codec(ft::file_reader&) -> value_type
+*	codec.write_key(ft::file_writer&, const key_type&)	codec.read_key(ft::file_reader&) -> key_type
+*/
+
+namespace ft {
+
+	struct durable_options
+	{
+		/* fsync the log every sync_every records (1: every write is durable
+		* when it returns, 0: only on sync(), checkpoint() and close) */
+		std::size_t	sync_every;
+		/* checkpoint once the log holds that many records (0: only on checkpoint()) */
+		std::size_t	checkpoint_every;
+
+		durable_options(std::size_t sync = 1, std::size_t checkpoint = 100000) :
+			sync_every(sync),
+			checkpoint_every(checkpoint)
+		{}
+	};
+
+	namespace durable_detail {
+
+		static const char		wal_magic[8] = { 'F', 'T', 'W', 'A', 'L', 0, 0, 0 };
+		static const uint32_t	wal_version = 1;
+
+		enum op_type { op_put = 1, op_erase = 2, op_clear = 3 };
+
+		inline bool file_exists(const std::string& path)
+		{
+			return ::access(path.c_str(), F_OK) == 0;
+		}
+
+		/* makes a rename() in the directory of path durable */
+		inline void sync_directory(const std::string& path)
+		{
+			std::string::size_type slash = path.find_last_of('/');
+			std::string dir = slash == std::string::npos ? std::string(".") : path.substr(0, slash + 1);
+			int fd = ::open(dir.c_str(), O_RDONLY);
+			if (fd < 0)
+				return;
+			::fsync(fd);
+			::close(fd);
+		}
+	}
+
+	template <typename Key, typename T, typename Codec = ft::raw_codec<Key, T>,
+		typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	class durable_map
+	{
+		public:
+			typedef ft::map<Key, T, Compare, Allocator>			map_type;
+			typedef typename map_type::key_type					key_type;
+			typedef typename map_type::mapped_type				mapped_type;
+			typedef typename map_type::value_type				value_type;
+			typedef typename map_type::key_compare				key_compare;
+			typedef typename map_type::size_type				size_type;
+			typedef typename map_type::difference_type			difference_type;
+			typedef typename map_type::const_reference			const_reference;
+			typedef typename map_type::const_iterator			const_iterator;
+			typedef const_iterator								iterator;
+			typedef typename map_type::const_reverse_iterator	const_reverse_iterator;
+			typedef Codec										codec_type;
+
+			/* What operator[] returns: the element exists already (like with
+			* map::operator[]), assigning through the proxy is logged. */
+			class reference_proxy
+			{
+				public:
+					reference_proxy& operator=(const mapped_type& value)
+					{
+						_owner.put(_key, value);
+						return *this;
+					}
+
+					reference_proxy& operator=(const reference_proxy& other)
+					{
+						return *this = static_cast<const mapped_type&>(other);
+					}
+
+					operator const mapped_type&() const
+					{
+						return _owner.find(_key)->second;
+					}
+
+				private:
+					friend class durable_map;
+
+					durable_map&	_owner;
+					key_type		_key;
+
+					reference_proxy(durable_map& owner, const key_type& key) : _owner(owner), _key(key) {}
+			};
+
+			/**
+			*  @brief  Opens (or creates) the store at @a path and recovers its content.
+			*  @param  path  Prefix of the snapshot and log files.
+			*  @throw  std::runtime_error  If the files can't be opened, or the
+			*          snapshot is corrupted (a corrupted log tail is not an error).
+			*/
+			explicit durable_map(const std::string& path, const durable_options& options = durable_options(),
+				const codec_type& codec = codec_type(), const key_compare& comp = key_compare()) :
+				_map(comp),
+				_codec(codec),
+				_options(options),
+				_snapshot_path(path + ".snap"),
+				_log_path(path + ".wal"),
+				_log(NULL),
+				_generation(0),
+				_log_records(0),
+				_pending(0),
+				_record_start(0),
+				_record_open(false)
+			{
+				load_checkpoint();
+				replay_log();
+			}
+
+			/* syncs the pending records, errors are lost: call close() to see them */
+			~durable_map()
+			{
+				try { close(); } catch (...) {}
+				delete _log;
+			}
+
+		/* ---------- ITERATORS ---------- */
+			const_iterator begin() const { return _map.begin(); }
+			const_iterator end() const { return _map.end(); }
+			const_reverse_iterator rbegin() const { return _map.rbegin(); }
+			const_reverse_iterator rend() const { return _map.rend(); }
+
+		/* ---------- CAPACITY ---------- */
+			bool empty() const { return _map.size() == 0; }
+			size_type size() const { return _map.size(); }
+
+		/* ---------- ELEMENT ACCESS ---------- */
+			const mapped_type& at(const key_type& key) const
+			{
+				const_iterator it = _map.find(key);
+				if (it == _map.end())
+					throw std::out_of_range("durable_map::at:  key not found");
+				return it->second;
+			}
+
+			/* Inserts (and logs) mapped_type() if key is absent, like map::operator[] */
+			reference_proxy operator[](const key_type& key)
+			{
+				if (_map.count(key) == 0)
+					put(key, mapped_type());
+				return reference_proxy(*this, key);
+			}
+
+		/* ---------- MODIFIERS ---------- */
+			/* inserts value if its key is absent; only an actual insertion is logged */
+			ft::pair<const_iterator, bool> insert(const value_type& value)
+			{
+				const_iterator it = _map.find(value.first);
+				if (it != _map.end())
+					return ft::make_pair(it, false);
+				append_put(value);
+				ft::pair<typename map_type::iterator, bool> ret = _map.insert(value);
+				after_append();
+				return ft::make_pair(const_iterator(ret.first), true);
+			}
+
+			/* inserts or overwrites, always logged */
+			const mapped_type& put(const key_type& key, const mapped_type& value)
+			{
+				append_put(value_type(key, value));
+				typename map_type::iterator it = _map.find(key);
+				if (it == _map.end())
+					it = _map.insert(value_type(key, value)).first;
+				else
+					it->second = value;
+				after_append();
+				return it->second;
+			}
+
+			size_type erase(const key_type& key)
+			{
+				if (_map.count(key) == 0)
+					return 0;
+				begin_record(durable_detail::op_erase);
+				_codec.write_key(*_log, key);
+				end_record();
+				_map.erase(key);
+				after_append();
+				return 1;
+			}
+
+			void clear()
+			{
+				begin_record(durable_detail::op_clear);
+				end_record();
+				_map.clear();
+				after_append();
+			}
+
+		/* ---------- LOOK-UP ---------- */
+			const_iterator find(const key_type& key) const { return _map.find(key); }
+			size_type count(const key_type& key) const { return _map.count(key); }
+			const_iterator lower_bound(const key_type& key) const { return _map.lower_bound(key); }
+			const_iterator upper_bound(const key_type& key) const { return _map.upper_bound(key); }
+
+			key_compare key_comp() const { return _map.key_comp(); }
+
+		/* ---------- DURABILITY ---------- */
+			/* group commit: writes and fsyncs every record appended so far */
+			void sync()
+			{
+				if (_log)
+					_log->sync();
+				_pending = 0;
+			}
+
+			/**
+			*  @brief  Writes the whole map to the snapshot and starts an empty log.
+			*  @throw  std::runtime_error  On I/O error; the previous snapshot and
+			*          log are then still valid.
+			*/
+			void checkpoint()
+			{
+				sync();
+				uint64_t next = _generation + 1;
+				std::string tmp = _snapshot_path + ".tmp";
+				try
+				{
+					file_writer out(tmp.c_str());
+					out.write_value(next);
+					write_snapshot(out, _map, _codec);
+					out.sync();
+					out.close();
+				}
+				catch (...)
+				{
+					std::remove(tmp.c_str());
+					throw;
+				}
+				if (std::rename(tmp.c_str(), _snapshot_path.c_str()) != 0)
+					throw std::runtime_error("ft::durable_map: cannot rename " + tmp);
+				durable_detail::sync_directory(_snapshot_path);
+				/* from here on the old log is stale: its generation is behind */
+				_generation = next;
+				start_log();
+			}
+
+			/* syncs and closes the log; the object can't be modified afterwards */
+			void close()
+			{
+				if (!_log)
+					return;
+				_log->sync();
+				_log->close();
+				delete _log;
+				_log = NULL;
+			}
+
+			/* records in the log since the last checkpoint */
+			size_type log_records() const { return _log_records; }
+			uint64_t generation() const { return _generation; }
+
+		private:
+			map_type			_map;
+			codec_type			_codec;
+			durable_options		_options;
+			std::string			_snapshot_path;
+			std::string			_log_path;
+			file_writer*		_log;
+			uint64_t			_generation;
+			size_type			_log_records;
+			size_type			_pending;
+			uint64_t			_record_start;
+			bool				_record_open;		/* begun, not ended: torn */
+
+			void load_checkpoint()
+			{
+				if (!durable_detail::file_exists(_snapshot_path))
+					return;
+				file_reader in(_snapshot_path.c_str());
+				_generation = in.read_value<uint64_t>();
+				read_snapshot(in, _map, _codec);
+			}
+
+			/* replays the log if it belongs to the current generation, then
+			* reopens it for appending, cut after the last valid record */
+			void replay_log()
+			{
+				uint64_t valid_size = 0;
+				if (durable_detail::file_exists(_log_path))
+				{
+					file_reader in(_log_path.c_str());
+					char magic[sizeof(durable_detail::wal_magic)];
+					uint64_t generation = 0;
+					if (in.read_some(magic, sizeof(magic)) == sizeof(magic)
+						&& std::memcmp(magic, durable_detail::wal_magic, sizeof(magic)) == 0)
+					{
+						try
+						{
+							if (in.read_value<uint32_t>() != durable_detail::wal_version)
+								throw std::runtime_error("ft::durable_map: unsupported log version");
+							in.read_value<uint32_t>();
+							generation = in.read_value<uint64_t>();
+						}
+						catch (const std::exception&)
+						{
+							generation = 0;
+						}
+					}
+					if (generation != 0 && generation >= _generation)
+					{
+						_generation = generation;
+						valid_size = in.bytes_read();
+						while (replay_record(in))
+							valid_size = in.bytes_read();
+					}
+				}
+				if (valid_size == 0)
+					start_log();
+				else
+				{
+					if (::truncate(_log_path.c_str(), valid_size) != 0)
+						throw std::runtime_error("ft::durable_map: cannot truncate " + _log_path);
+					_log = new file_writer(_log_path.c_str(), true);
+				}
+			}
+
+			/* applies the next record, false at the end of the log or on a torn one */
+			bool replay_record(file_reader& in)
+			{
+				in.reset_checksum();
+				uint64_t start = in.bytes_read();
+				unsigned char op;
+				if (in.read_some(&op, 1) != 1)
+					return false;
+				try
+				{
+					if (op == durable_detail::op_put)
+					{
+						value_type value = _codec(in);
+						if (!check_trailer(in, start))
+							return false;
+						typename map_type::iterator it = _map.find(value.first);
+						if (it == _map.end())
+							_map.insert(value);
+						else
+							it->second = value.second;
+					}
+					else if (op == durable_detail::op_erase)
+					{
+						key_type key = _codec.read_key(in);
+						if (!check_trailer(in, start))
+							return false;
+						_map.erase(key);
+					}
+					else if (op == durable_detail::op_clear)
+					{
+						if (!check_trailer(in, start))
+							return false;
+						_map.clear();
+					}
+					else
+						return false;
+				}
+				catch (const std::exception&)
+				{
+					/* a truncated record makes the codec read past the end */
+					return false;
+				}
+				++_log_records;
+				return true;
+			}
+
+			bool check_trailer(file_reader& in, uint64_t start)
+			{
+				uint64_t size = in.bytes_read() - start - 1;
+				uint64_t checksum = in.checksum();
+				return in.read_value<uint64_t>() == size && in.read_value<uint64_t>() == checksum;
+			}
+
+			/* atomically replaces the log with an empty one of the current generation */
+			void start_log()
+			{
+				if (_generation == 0)
+					_generation = 1;
+				delete _log;
+				_log = NULL;
+				std::string tmp = _log_path + ".tmp";
+				{
+					file_writer out(tmp.c_str());
+					out.write(durable_detail::wal_magic, sizeof(durable_detail::wal_magic));
+					out.write_value(durable_detail::wal_version);
+					out.write_value(uint32_t(0));
+					out.write_value(_generation);
+					out.sync();
+					out.close();
+				}
+				if (std::rename(tmp.c_str(), _log_path.c_str()) != 0)
+					throw std::runtime_error("ft::durable_map: cannot rename " + tmp);
+				durable_detail::sync_directory(_log_path);
+				_log = new file_writer(_log_path.c_str(), true);
+				_log_records = 0;
+				_pending = 0;
+				_record_open = false;
+			}
+
+			void begin_record(durable_detail::op_type op)
+			{
+				if (!_log)
+					throw std::logic_error("ft::durable_map: modified after close()");
+				if (_record_open)
+					throw std::runtime_error("ft::durable_map: a record failed half-way, checkpoint() first");
+				_record_open = true;
+				_log->reset_checksum();
+				_record_start = _log->bytes_written();
+				unsigned char byte = op;
+				_log->write(&byte, 1);
+			}
+
+			void end_record()
+			{
+				uint64_t size = _log->bytes_written() - _record_start - 1;
+				uint64_t checksum = _log->checksum();
+				_log->write_value(size);
+				_log->write_value(checksum);
+				_record_open = false;
+			}
+
+			void append_put(const value_type& value)
+			{
+				begin_record(durable_detail::op_put);
+				_codec(*_log, value);
+				end_record();
+			}
+
+			/* group commit and checkpoint triggers, once the map is updated */
+			void after_append()
+			{
+				++_log_records;
+				++_pending;
+				if (_options.sync_every && _pending >= _options.sync_every)
+					sync();
+				if (_options.checkpoint_every && _log_records >= _options.checkpoint_every)
+					checkpoint();
+			}
+
+			durable_map(const durable_map&);
+			durable_map& operator=(const durable_map&);
+	};
+
+} // namespace
+
+#endif
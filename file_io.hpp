@@ -0,0 +1,254 @@
+#ifndef FILE_IO_HPP
+#define FILE_IO_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+* Buffered binary file I/O used by the snapshot and log formats.
+*
+* Both classes own a single fixed-size buffer, so streaming a container through
+* them never costs more than buffer_size bytes on top of the container itself.
+* Every byte going through them is folded into a running FNV-1a checksum that
+* the formats use to detect torn or corrupted files.
+* Errors are reported with std::runtime_error, like the rest of ft:: does.
+*/
+
+namespace ft {
+
+	/* 64 bit FNV-1a, cheap and good enough to detect torn writes */
+	struct fnv1a
+	{
+		static const uint64_t	offset_basis = 14695981039346656037ULL;
+		static const uint64_t	prime = 1099511628211ULL;
+
+		static uint64_t update(uint64_t hash, const void* data, std::size_t len)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (std::size_t i = 0; i < len; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= prime;
+			}
+			return hash;
+		}
+	};
+
+	class file_writer
+	{
+		public:
+			static const std::size_t	buffer_size = 64 * 1024;
+
+			/**
+			*  @brief  Opens @a path for writing.
+			*  @param  append  Keep the current content and write at the end of
+			*                  the file instead of truncating it.
+			*  @throw  std::runtime_error  If the file cannot be opened.
+			*/
+			explicit file_writer(const char* path, bool append = false) :
+				_fd(-1),
+				_buffer(new char[buffer_size]),
+				_used(0),
+				_checksum(fnv1a::offset_basis),
+				_written(0)
+			{
+				int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+				_fd = ::open(path, flags, 0644);
+				if (_fd < 0)
+				{
+					delete[] _buffer;
+					throw std::runtime_error(std::string("ft::file_writer: cannot open ") + path + ": " + std::strerror(errno));
+				}
+			}
+
+			/* Pending bytes are flushed but errors can't be reported from here:
+			* call close() to know whether everything reached the file. */
+			~file_writer()
+			{
+				if (_fd >= 0)
+				{
+					try { flush(); } catch (...) {}
+					::close(_fd);
+				}
+				delete[] _buffer;
+			}
+
+			void write(const void* data, std::size_t len)
+			{
+				_checksum = fnv1a::update(_checksum, data, len);
+				_written += len;
+				const char* bytes = static_cast<const char*>(data);
+				while (len)
+				{
+					if (_used == buffer_size)
+						flush();
+					std::size_t chunk = std::min(len, buffer_size - _used);
+					std::memcpy(_buffer + _used, bytes, chunk);
+					_used += chunk;
+					bytes += chunk;
+					len -= chunk;
+				}
+			}
+
+			/* writes the object representation of a trivially copyable value */
+			template <typename T>
+			void write_value(const T& value)
+			{
+				write(&value, sizeof(T));
+			}
+
+			/* hands the buffered bytes to the kernel */
+			void flush()
+			{
+				std::size_t done = 0;
+				while (done < _used)
+				{
+					ssize_t n = ::write(_fd, _buffer + done, _used - done);
+					if (n < 0 && errno == EINTR)
+						continue;
+					if (n <= 0)
+						throw std::runtime_error(std::string("ft::file_writer: write error: ") + std::strerror(errno));
+					done += n;
+				}
+				_used = 0;
+			}
+
+			/* flush() and wait for the data to be on stable storage */
+			void sync()
+			{
+				flush();
+				if (::fsync(_fd) != 0)
+					throw std::runtime_error(std::string("ft::file_writer: fsync error: ") + std::strerror(errno));
+			}
+
+			void close()
+			{
+				if (_fd < 0)
+					return;
+				flush();
+				int fd = _fd;
+				_fd = -1;
+				if (::close(fd) != 0)
+					throw std::runtime_error(std::string("ft::file_writer: close error: ") + std::strerror(errno));
+			}
+
+			uint64_t checksum() const { return _checksum; }
+			void reset_checksum() { _checksum = fnv1a::offset_basis; }
+
+			/* bytes written through this writer since it was opened */
+			uint64_t bytes_written() const { return _written; }
+
+		private:
+			int				_fd;
+			char*			_buffer;
+			std::size_t		_used;
+			uint64_t		_checksum;
+			uint64_t		_written;
+
+			file_writer(const file_writer&);
+			file_writer& operator=(const file_writer&);
+	};
+
+	class file_reader
+	{
+		public:
+			static const std::size_t	buffer_size = 64 * 1024;
+
+			/* @throw  std::runtime_error  If the file cannot be opened.*/
+			explicit file_reader(const char* path) :
+				_fd(-1),
+				_buffer(new char[buffer_size]),
+				_pos(0),
+				_used(0),
+				_checksum(fnv1a::offset_basis),
+				_read(0)
+			{
+				_fd = ::open(path, O_RDONLY);
+				if (_fd < 0)
+				{
+					delete[] _buffer;
+					throw std::runtime_error(std::string("ft::file_reader: cannot open ") + path + ": " + std::strerror(errno));
+				}
+			}
+
+			~file_reader()
+			{
+				if (_fd >= 0)
+					::close(_fd);
+				delete[] _buffer;
+			}
+
+			/* reads up to len bytes, returns how many were read (less only at end of file) */
+			std::size_t read_some(void* data, std::size_t len)
+			{
+				char* bytes = static_cast<char*>(data);
+				std::size_t done = 0;
+				while (done < len)
+				{
+					if (_pos == _used && !fill())
+						break;
+					std::size_t chunk = std::min(len - done, _used - _pos);
+					std::memcpy(bytes + done, _buffer + _pos, chunk);
+					_pos += chunk;
+					done += chunk;
+				}
+				_checksum = fnv1a::update(_checksum, data, done);
+				_read += done;
+				return done;
+			}
+
+			/* @throw  std::runtime_error  If the file ends before len bytes.*/
+			void read(void* data, std::size_t len)
+			{
+				if (read_some(data, len) != len)
+					throw std::runtime_error("ft::file_reader: unexpected end of file");
+			}
+
+			template <typename T>
+			T read_value()
+			{
+				T value;
+				read(&value, sizeof(T));
+				return value;
+			}
+
+			uint64_t checksum() const { return _checksum; }
+			void reset_checksum() { _checksum = fnv1a::offset_basis; }
+
+			/* bytes consumed through this reader since it was opened */
+			uint64_t bytes_read() const { return _read; }
+
+		private:
+			int				_fd;
+			char*			_buffer;
+			std::size_t		_pos;
+			std::size_t		_used;
+			uint64_t		_checksum;
+			uint64_t		_read;
+
+			bool fill()
+			{
+				ssize_t n;
+				do
+					n = ::read(_fd, _buffer, buffer_size);
+				while (n < 0 && errno == EINTR);
+				if (n < 0)
+					throw std::runtime_error(std::string("ft::file_reader: read error: ") + std::strerror(errno));
+				_pos = 0;
+				_used = n;
+				return n > 0;
+			}
+
+			file_reader(const file_reader&);
+			file_reader& operator=(const file_reader&);
+	};
+
+} // namespace
+
+#endif
@@ -0,0 +1,422 @@
+#ifndef FROZEN_MAP_HPP
+#define FROZEN_MAP_HPP
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "file_io.hpp"
+#include "map.hpp"
+#include "normal_iterator.hpp"
+#include "type_traits.hpp"
+
+/*
+* On-disk image of an ft::map whose key and mapped types are trivially copyable.
+*
+* The file is written once by ft::freeze() and is then served read-only by
+* ft::frozen_map straight from an mmap of the file: nothing is deserialized on
+* load, the pages are faulted in by the kernel when find()/lower_bound() or an
+* iteration touches them.
+*
+* Layout (native byte order and alignment, see frozen_header::version):
+*
+*	[frozen_header][pad][entries: count * {Key, T}, sorted][pad][fences]
+*
+* The search index is implicit: fences[i] is the key of entries[i * block_size],
+* so a lookup binary-searches the small fence array (which stays hot in cache)
+* and then a single block of the entry array.
+*
+* The order of the entries is the one of the map's Compare: the header records
+* its type and size, and an id given by the caller to freeze() (for
+* comparators of the same type that order differently), and frozen_map
+* refuses a file written under another comparator.
+*/
+
+namespace ft {
+
+	struct frozen_header
+	{
+		static const uint32_t	version_1 = 1;		/* no comparator fields */
+		static const uint32_t	version_2 = 2;
+
+		char		magic[8];		/* "FTFROZEN" */
+		uint32_t	version;
+		uint32_t	key_size;
+		uint32_t	mapped_size;
+		uint32_t	entry_size;
+		uint64_t	count;
+		uint64_t	block_size;		/* entries covered by one fence */
+		uint64_t	entries_offset;
+		uint64_t	fences_offset;
+		uint64_t	file_size;
+		uint32_t	compare_size;	/* sizeof(Compare) */
+		uint32_t	reserved;
+		uint64_t	compare_type;	/* FNV-1a of typeid(Compare).name() */
+		uint64_t	compare_id;		/* given to freeze(), 0 by default */
+	};
+
+	/* One record of the sorted entry array. Plain aggregate so that it stays
+	* trivially copyable (ft::pair has a user-provided copy constructor). */
+	template <typename Key, typename T>
+	struct frozen_entry
+	{
+		Key		first;
+		T		second;
+	};
+
+	namespace frozen_detail {
+
+		static const char		magic[8] = { 'F', 'T', 'F', 'R', 'O', 'Z', 'E', 'N' };
+		static const uint64_t	alignment = 64;
+		static const uint64_t	block_size = 64;
+
+		inline uint64_t align_up(uint64_t offset)
+		{
+			return (offset + alignment - 1) & ~(alignment - 1);
+		}
+
+		inline void write_at(std::FILE* file, uint64_t offset, const void* data, std::size_t len)
+		{
+			static const char zeros[alignment] = {};
+			long pos = std::ftell(file);
+
+			while (pos >= 0 && static_cast<uint64_t>(pos) < offset)
+			{
+				std::size_t pad = std::min<uint64_t>(offset - pos, alignment);
+				if (std::fwrite(zeros, 1, pad, file) != pad)
+					throw std::runtime_error("ft::freeze: write error");
+				pos += pad;
+			}
+			if (len && std::fwrite(data, 1, len, file) != len)
+				throw std::runtime_error("ft::freeze: write error");
+		}
+
+		/* true if count items of size bytes from offset end within file_size,
+		* and offset is aligned for them; no overflow on any header value */
+		inline bool fits(uint64_t offset, uint64_t count, uint64_t size, uint64_t align, uint64_t file_size)
+		{
+			if (offset > file_size || offset % align != 0)
+				return false;
+			return count <= (file_size - offset) / size;
+		}
+
+		/* identifies the comparator type, for this compiler's ABI as the
+		* rest of the layout */
+		template <typename Compare>
+		inline uint64_t compare_type()
+		{
+			const char* name = typeid(Compare).name();
+			return fnv1a::update(fnv1a::offset_basis, name, std::strlen(name));
+		}
+
+		/* makes sure both types can be memcpy'ed to disk; fails to compile otherwise */
+		template <typename Key, typename T>
+		struct check_trivial
+		{
+			typedef typename enable_if<is_trivially_copyable<Key>::value
+				&& is_trivially_copyable<T>::value, frozen_entry<Key, T> >::type entry_type;
+		};
+	}
+
+	/**
+	*  @brief  Writes @a m to @a path in the frozen_map format.
+	*  @param  m  A map of trivially copyable key and mapped types.
+	*  @param  path  Destination file, truncated if it exists.
+	*  @param  compare_id  Tells apart comparators of the same type that order
+	*          differently; frozen_map must be opened with the same.
+	*  @throw  std::runtime_error  If the file cannot be written.
+	*/
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance>
+	void freeze(const ft::map<Key, T, Compare, Alloc, Balance>& m, const char* path, uint64_t compare_id = 0)
+	{
+		typedef typename frozen_detail::check_trivial<Key, T>::entry_type	entry_type;
+		typedef typename ft::map<Key, T, Compare, Alloc, Balance>::const_iterator	const_iterator;
+
+		frozen_header header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, frozen_detail::magic, sizeof(header.magic));
+		header.version = frozen_header::version_2;
+		header.key_size = sizeof(Key);
+		header.mapped_size = sizeof(T);
+		header.entry_size = sizeof(entry_type);
+		header.count = m.size();
+		header.block_size = frozen_detail::block_size;
+		header.entries_offset = frozen_detail::align_up(sizeof(frozen_header));
+		header.fences_offset = frozen_detail::align_up(header.entries_offset + header.count * sizeof(entry_type));
+		uint64_t fence_count = (header.count + header.block_size - 1) / header.block_size;
+		header.file_size = header.fences_offset + fence_count * sizeof(Key);
+		header.compare_size = sizeof(Compare);
+		header.compare_type = frozen_detail::compare_type<Compare>();
+		header.compare_id = compare_id;
+
+		std::FILE* file = std::fopen(path, "wb");
+		if (!file)
+			throw std::runtime_error(std::string("ft::freeze: cannot open ") + path);
+		try
+		{
+			frozen_detail::write_at(file, 0, &header, sizeof(header));
+
+			entry_type entry;
+			std::memset(&entry, 0, sizeof(entry)); /* no garbage in the padding bytes */
+			uint64_t offset = header.entries_offset;
+			for (const_iterator it = m.begin(); it != m.end(); ++it, offset += sizeof(entry))
+			{
+				entry.first = it->first;
+				entry.second = it->second;
+				frozen_detail::write_at(file, offset, &entry, sizeof(entry));
+			}
+
+			uint64_t i = 0;
+			offset = header.fences_offset;
+			for (const_iterator it = m.begin(); it != m.end(); ++it, ++i)
+			{
+				if (i % header.block_size)
+					continue;
+				frozen_detail::write_at(file, offset, &it->first, sizeof(Key));
+				offset += sizeof(Key);
+			}
+			frozen_detail::write_at(file, header.file_size, NULL, 0);
+			if (std::fflush(file) != 0)
+				throw std::runtime_error("ft::freeze: write error");
+		}
+		catch (...)
+		{
+			std::fclose(file);
+			throw;
+		}
+		if (std::fclose(file) != 0)
+			throw std::runtime_error("ft::freeze: write error");
+	}
+
+	/*
+	* Read-only map served from a file written by ft::freeze().
+	* Iterators are plain random access iterators over the mapped entry array,
+	* they stay valid for the lifetime of the frozen_map.
+	*/
+	template <typename Key, typename T, typename Compare = std::less<Key> >
+	class frozen_map
+	{
+		public:
+			typedef Key																key_type;
+			typedef T																mapped_type;
+			typedef Compare															key_compare;
+			typedef typename frozen_detail::check_trivial<Key, T>::entry_type		value_type;
+			typedef std::size_t														size_type;
+			typedef std::ptrdiff_t													difference_type;
+			typedef const value_type&												const_reference;
+			typedef const value_type*												const_pointer;
+			typedef const_pointer													pointer;
+			typedef normal_iterator<const_pointer, frozen_map>						const_iterator;
+			typedef const_iterator													iterator;
+			typedef ft::reverse_iterator<const_iterator>							const_reverse_iterator;
+			typedef ft::map<Key, T, Compare>										map_type;
+
+			/**
+			*  @brief  Maps @a path, written by ft::freeze(), into memory.
+			*  @param  compare_id  The one given to ft::freeze().
+			*  @throw  std::runtime_error  If the file is missing, truncated, has
+			*          its arrays out of bounds or misaligned, or was written for
+			*          other key/mapped types, another comparator or another
+			*          format version.
+			*/
+			explicit frozen_map(const char* path, const key_compare& comp = key_compare(), uint64_t compare_id = 0) :
+				_comp(comp),
+				_data(NULL),
+				_length(0),
+				_entries(NULL),
+				_fences(NULL),
+				_count(0),
+				_block_size(1)
+			{
+				int fd = ::open(path, O_RDONLY);
+				if (fd < 0)
+					throw std::runtime_error(std::string("ft::frozen_map: cannot open ") + path);
+				struct stat st;
+				if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(frozen_header)))
+				{
+					::close(fd);
+					throw std::runtime_error("ft::frozen_map: truncated file");
+				}
+				_length = st.st_size;
+				void* data = ::mmap(NULL, _length, PROT_READ, MAP_SHARED, fd, 0);
+				::close(fd); /* the mapping keeps its own reference on the file */
+				if (data == MAP_FAILED)
+					throw std::runtime_error("ft::frozen_map: mmap failed");
+				_data = static_cast<const char*>(data);
+
+				const frozen_header* header = reinterpret_cast<const frozen_header*>(_data);
+				if (std::memcmp(header->magic, frozen_detail::magic, sizeof(header->magic)) != 0
+					|| header->version != frozen_header::version_2
+					|| header->key_size != sizeof(Key)
+					|| header->mapped_size != sizeof(T)
+					|| header->entry_size != sizeof(value_type)
+					|| header->block_size == 0
+					|| header->file_size > _length)
+				{
+					::munmap(const_cast<char*>(_data), _length);
+					throw std::runtime_error("ft::frozen_map: bad header or incompatible types");
+				}
+				/* lookups would search an order they do not expect */
+				if (header->compare_size != sizeof(Compare)
+					|| header->compare_type != frozen_detail::compare_type<Compare>()
+					|| header->compare_id != compare_id)
+				{
+					::munmap(const_cast<char*>(_data), _length);
+					throw std::runtime_error("ft::frozen_map: written with another comparator");
+				}
+				/* the arrays must lie within the file: lookups trust them */
+				uint64_t fence_count = header->count / header->block_size + (header->count % header->block_size != 0);
+				if (header->entries_offset < sizeof(frozen_header)
+					|| !frozen_detail::fits(header->entries_offset, header->count, sizeof(value_type),
+						__alignof__(value_type), header->file_size)
+					|| !frozen_detail::fits(header->fences_offset, fence_count, sizeof(Key),
+						__alignof__(Key), header->file_size))
+				{
+					::munmap(const_cast<char*>(_data), _length);
+					throw std::runtime_error("ft::frozen_map: truncated file or corrupt header");
+				}
+				_count = header->count;
+				_block_size = header->block_size;
+				_entries = reinterpret_cast<const_pointer>(_data + header->entries_offset);
+				_fences = reinterpret_cast<const Key*>(_data + header->fences_offset);
+			}
+
+			~frozen_map()
+			{
+				::munmap(const_cast<char*>(_data), _length);
+			}
+
+		/* ---------- ITERATORS ---------- */
+			const_iterator begin() const { return const_iterator(_entries); }
+			const_iterator end() const { return const_iterator(_entries + _count); }
+			const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+			const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+		/* ---------- CAPACITY ---------- */
+			bool empty() const { return _count == 0; }
+			size_type size() const { return _count; }
+
+		/* ---------- LOOK-UP ---------- */
+			/* Returns an iterator pointing to the first element
+			* that is not less than (i.e. greater or equal to) key */
+			const_iterator lower_bound(const key_type& key) const
+			{
+				size_type fence_count = (_count + _block_size - 1) / _block_size;
+				/* last block whose first key is <= key */
+				size_type lo = 0;
+				size_type hi = fence_count;
+				while (lo < hi)
+				{
+					size_type mid = lo + (hi - lo) / 2;
+					if (_comp(key, _fences[mid]))
+						hi = mid;
+					else
+						lo = mid + 1;
+				}
+				if (lo == 0)
+					return begin();
+				const_pointer first = _entries + (lo - 1) * _block_size;
+				const_pointer last = std::min(first + _block_size, _entries + _count);
+				while (first < last)
+				{
+					const_pointer mid = first + (last - first) / 2;
+					if (_comp(mid->first, key))
+						first = mid + 1;
+					else
+						last = mid;
+				}
+				return const_iterator(first);
+			}
+
+			/* Returns an iterator pointing to the first element
+			* that is greater than key.*/
+			const_iterator upper_bound(const key_type& key) const
+			{
+				const_iterator it = lower_bound(key);
+				if (it != end() && !_comp(key, it->first))
+					++it;
+				return it;
+			}
+
+			const_iterator find(const key_type& key) const
+			{
+				const_iterator it = lower_bound(key);
+				if (it != end() && !_comp(key, it->first))
+					return it;
+				return end();
+			}
+
+			size_type count(const key_type& key) const
+			{
+				return find(key) != end();
+			}
+
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			/* @throw  std::out_of_range  If no such data is present.*/
+			const mapped_type& at(const key_type& key) const
+			{
+				const_iterator it = find(key);
+				if (it == end())
+					throw std::out_of_range("frozen_map::at:  key not found");
+				return it->second;
+			}
+
+			key_compare key_comp() const { return _comp; }
+
+			/**
+			*  @brief  Copies the mapping back into a mutable %map.
+			*
+			*  The entries are already sorted, so the tree is built in O(n) by
+			*  map::assign_sorted(). The frozen_map itself stays usable.
+			*/
+			map_type thaw() const
+			{
+				map_type m(_comp);
+				entry_reader next(_entries);
+				m.assign_sorted(_count, next);
+				return m;
+			}
+
+		private:
+			/* feeds the sorted entries to map::assign_sorted() */
+			struct entry_reader
+			{
+				const_pointer	current;
+
+				explicit entry_reader(const_pointer first) : current(first) {}
+
+				ft::pair<const Key, T> operator()()
+				{
+					const_pointer entry = current++;
+					return ft::pair<const Key, T>(entry->first, entry->second);
+				}
+			};
+
+			key_compare		_comp;
+			const char*		_data;
+			size_type		_length;
+			const_pointer	_entries;
+			const Key*		_fences;
+			size_type		_count;
+			size_type		_block_size;
+
+			/* a mapping can't be shared: not copyable */
+			frozen_map(const frozen_map&);
+			frozen_map& operator=(const frozen_map&);
+	};
+
+} // namespace
+
+#endif
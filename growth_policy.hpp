@@ -0,0 +1,79 @@
+#ifndef GROWTH_POLICY_HPP
+#define GROWTH_POLICY_HPP
+
+#include <cstddef>
+
+/*
+* Growth policies of ft::vector, its third template parameter: the capacity
+* to reallocate to when an insertion does not fit.
+*
+* A policy is a class with
+*	static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+*		std::size_t max_size, std::size_t element_size);
+* which returns a capacity of at least required (the size after the
+* insertion) and at most max_size, required <= max_size. A larger factor
+* copies each element fewer times over the growths and leaves more unused
+* capacity.
+*/
+
+namespace ft {
+
+	/* twice the capacity: about one copy per element, up to half the buffer unused */
+	struct growth_double
+	{
+		static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+			std::size_t max_size, std::size_t)
+		{
+			std::size_t grown = capacity > max_size / 2 ? max_size : capacity * 2;
+			return grown < required ? required : grown;
+		}
+	};
+
+	/*
+	* 1.5 times the capacity: about two copies per element, up to a third of
+	* the buffer unused, and a freed block can be reused by a later growth
+	* (the sum of the previous blocks passes the next request).
+	*/
+	struct growth_golden
+	{
+		static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+			std::size_t max_size, std::size_t)
+		{
+			std::size_t grown = capacity > max_size / 3 * 2 ? max_size : capacity + capacity / 2;
+			return grown < required ? required : grown;
+		}
+	};
+
+	/*
+	* 1.5 times the capacity, then up to the size class of the allocator:
+	* malloc implementations (jemalloc, tcmalloc, glibc's bins) round a
+	* request up to 16 bytes, and larger ones to a quarter of their power of
+	* two. The capacity takes that space instead of leaving it unused.
+	*/
+	struct growth_size_class
+	{
+		static std::size_t size_class(std::size_t bytes)
+		{
+			if (bytes <= 128)
+				return (bytes + 15) & ~static_cast<std::size_t>(15);
+			std::size_t power = 128;
+			while (power <= (bytes - 1) / 2)
+				power *= 2;
+			std::size_t step = power / 4;
+			return (bytes + step - 1) / step * step;
+		}
+
+		static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+			std::size_t max_size, std::size_t element_size)
+		{
+			std::size_t grown = growth_golden::next_capacity(capacity, required, max_size, element_size);
+			if (grown >= max_size / 2)
+				return grown;
+			std::size_t fitted = size_class(grown * element_size) / element_size;
+			return fitted < max_size ? fitted : max_size;
+		}
+	};
+
+} //namespace
+
+#endif
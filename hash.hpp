@@ -0,0 +1,85 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef>
+#include <string>
+
+/*
+* ft::hash<Key>: the default hash function of ft::unordered_map, for the
+* integral types, pointers and std::string. C++98 has no std::hash.
+*
+* The integral versions return the value itself: the table mixes every
+* hash before use (see unordered_map), so a weak hash only costs one
+* multiplication there. Other key types need a hash of their own.
+*/
+
+namespace ft {
+
+template <typename Key>
+struct hash;
+
+template <>
+struct hash<bool> { std::size_t operator()(bool value) const { return value; } };
+
+template <>
+struct hash<char> { std::size_t operator()(char value) const { return static_cast<std::size_t>(value); } };
+
+template <>
+struct hash<signed char> { std::size_t operator()(signed char value) const { return static_cast<std::size_t>(value); } };
+
+template <>
+struct hash<unsigned char> { std::size_t operator()(unsigned char value) const { return value; } };
+
+template <>
+struct hash<wchar_t> { std::size_t operator()(wchar_t value) const { return static_cast<std::size_t>(value); } };
+
+template <>
+struct hash<short> { std::size_t operator()(short value) const { return static_cast<std::size_t>(value); } };
+
+template <>
+struct hash<unsigned short> { std::size_t operator()(unsigned short value) const { return value; } };
+
+template <>
+struct hash<int> { std::size_t operator()(int value) const { return static_cast<std::size_t>(value); } };
+
+template <>
+struct hash<unsigned int> { std::size_t operator()(unsigned int value) const { return value; } };
+
+template <>
+struct hash<long> { std::size_t operator()(long value) const { return static_cast<std::size_t>(value); } };
+
+template <>
+struct hash<unsigned long> { std::size_t operator()(unsigned long value) const { return value; } };
+
+template <>
+struct hash<long long> { std::size_t operator()(long long value) const { return static_cast<std::size_t>(value); } };
+
+template <>
+struct hash<unsigned long long> { std::size_t operator()(unsigned long long value) const { return static_cast<std::size_t>(value); } };
+
+template <typename T>
+struct hash<T*>
+{
+	std::size_t operator()(T* value) const { return reinterpret_cast<std::size_t>(value); }
+};
+
+/* FNV-1a over the bytes */
+template <>
+struct hash<std::string>
+{
+	std::size_t operator()(const std::string& value) const
+	{
+		unsigned long long h = 14695981039346656037ULL;
+
+		for (std::string::size_type i = 0; i < value.size(); ++i)
+		{
+			h ^= static_cast<unsigned char>(value[i]);
+			h *= 1099511628211ULL;
+		}
+		return static_cast<std::size_t>(h);
+	}
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef KEY_PREFIX_HPP
+#define KEY_PREFIX_HPP
+
+#include <string>
+#include <stdint.h>
+
+#include "avl_iterator.hpp"
+#include "type_traits.hpp"
+
+/*
+* Key prefix caching for ft::map<std::string, T, ft::prefix_less>.
+*
+* With ft::prefix_less as comparator the map uses map_prefix_node: the first
+* 8 bytes of the key are kept, packed big endian in an integer, next to the
+* links of the node. Two keys whose prefixes differ are ordered by their
+* prefixes alone, so a descent only reads the string buffer of a node (one
+* more cache miss per level) when the prefixes tie.
+*
+* Packing the bytes as unsigned chars, padded with zeros, keeps the order of
+* std::less<std::string>: a differing prefix decides, a tie (equal first 8
+* bytes, or a shorter key padded to a '\0' byte) falls back to the full
+* comparison.
+*/
+
+namespace ft {
+
+	/* std::less<std::string>, plus the prefixed node layout in ft::map */
+	struct prefix_less
+	{
+		bool operator()(const std::string& a, const std::string& b) const
+		{
+			return a < b;
+		}
+	};
+
+	template <class Compare>
+	struct uses_key_prefix : public false_type {};
+
+	template <>
+	struct uses_key_prefix<prefix_less> : public true_type {};
+
+	inline uint64_t key_prefix(const std::string& key)
+	{
+		uint64_t prefix = 0;
+		std::size_t length = key.size() < 8 ? key.size() : 8;
+
+		for (std::size_t i = 0; i < 8; ++i)
+			prefix = (prefix << 8) | (i < length ? static_cast<unsigned char>(key[i]) : 0);
+		return prefix;
+	}
+
+	template <typename Value>
+	struct map_prefix_node : public map_node_base
+	{
+		uint64_t		prefix; /*key_prefix() of value.first*/
+		Value			value; /*holds the key in first*/
+	};
+
+	/* a key_type looked up with its prefix computed once */
+	template <typename Key>
+	struct prefixed_key
+	{
+		const Key&		key;
+		uint64_t		prefix;
+
+		explicit prefixed_key(const Key& k) : key(k), prefix(key_prefix(k)) {}
+	};
+
+	/* node layout and look-up argument of a map, by comparator */
+	template <typename Key, typename Value, typename Compare, bool Prefix = uses_key_prefix<Compare>::value>
+	struct map_key_layout
+	{
+		typedef map_node<Value>			node_type;
+		typedef const Key&				probe_type;
+
+		static probe_type probe(const Key& key) { return key; }
+		static void init(node_type*) {}
+	};
+
+	template <typename Key, typename Value, typename Compare>
+	struct map_key_layout<Key, Value, Compare, true>
+	{
+		typedef map_prefix_node<Value>	node_type;
+		typedef prefixed_key<Key>		probe_type;
+
+		static probe_type probe(const Key& key) { return probe_type(key); }
+		static void init(node_type* node) { node->prefix = key_prefix(node->value.first); }
+	};
+
+} // namespace
+
+#endif
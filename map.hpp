@@ -4,10 +4,16 @@
 #include <functional>
 #include <memory>
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 #include "utility.hpp"
+#include "type_traits.hpp"
 #include "iterator.hpp"
 #include "avl_iterator.hpp"
+#include "map_balance.hpp"
+#include "key_prefix.hpp"
+#include "vector.hpp"
 
 /* REMINDER - si comp = std::less alors:
 *		comp(value1, value2) == value1 < value2
@@ -17,24 +23,52 @@
 */
 
 namespace ft {
+
+/*
+* Memory report of a map, see map::stats(). Byte counts are what the map asks
+* from its allocator: the allocator's own bookkeeping is not included.
+*/
+struct map_stats
+{
+	std::size_t					node_count;			/* elements */
+	std::size_t					node_size;			/* sizeof one node */
+	std::size_t					value_size;			/* sizeof(value_type) */
+	std::size_t					per_node_overhead;	/* node_size - value_size: links and padding */
+	std::size_t					sentinel_bytes;		/* heap bytes spent on the end() sentinel, 0: it lives in the map */
+	std::size_t					bytes_allocated;	/* nodes */
+	std::size_t					height;				/* number of levels, 0 when empty */
+	ft::vector<std::size_t>		depth_histogram;	/* [d] = nodes at depth d, the root is at 0 */
+};
+
+/*
+* True when the keys are integers ordered by std::less or std::greater. The
+* descents of the map then pick the next node with the comparison result as
+* an index in map_node_base::child, which compiles to conditional moves
+* instead of a hard to predict branch per level.
+*/
+template <typename Key, typename Compare>
+struct map_branchless_descent : public bool_constant<ft::is_integral<Key>::value
+	&& (ft::is_same<Compare, std::less<Key> >::value || ft::is_same<Compare, std::greater<Key> >::value)> {};
+
 /*
 	The first template argument is the type of the element's key, and the second template argument is the type of the element's value;
 	The optional third template argument defines the sorting criterion;
 	The optional fourth template parameter defines the memory model;
+	The optional fifth template parameter defines the balancing scheme, see map_balance.hpp;
 */
-template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> >,
+	typename Balance = ft::avl_balance>
 class map {
 
 	private:
-		struct Node
-		{
-			typedef Node*	    		node_pointer;
+		/* the node layout depends on Compare, see key_prefix.hpp */
+		typedef ft::map_key_layout<Key, ft::pair<const Key, T>, Compare>		key_layout;
+		typedef typename key_layout::node_type									Node;
+		typedef ft::map_node_base*												base_pointer;
 
-			ft::pair<const Key, T>		value; /*holds the key in first*/
-			node_pointer        		parent;
-			node_pointer        		left;
-			node_pointer        		right;
-		};
+		/* R, for the heterogeneous overloads of a transparent Compare only */
+		template <typename K, typename R>
+		struct transparent : public ft::enable_if<ft::is_transparent<Compare>::value, R> {};
 
 	/*MEMBER TYPES*/
 	public:
@@ -42,6 +76,7 @@ class map {
 		typedef T																mapped_type; /*type de données stockées dans chaque élément d'une classe map*/
 		typedef Compare															key_compare; /*objet de fonction qui peut comparer deux clés de tri pour déterminer l'ordre relatif de deux éléments d'un map*/
 		typedef Allocator 														allocator_type;
+		typedef Balance															balance_type;
 		
 		typedef ft::pair<const key_type, mapped_type>							value_type; /*type d'objet stockés comme élément d'une classe map*/
 		typedef std::ptrdiff_t 													difference_type; /*nombre d'éléments d'une classe map comprise dans une plage d'éléments pointés par des itérateurs*/
@@ -68,7 +103,7 @@ class map {
 		class value_compare : public std::binary_function<value_type, value_type, bool>
 		{
 			public:
-			friend class map<Key, T, Compare, Allocator>;
+			friend class map<Key, T, Compare, Allocator, Balance>;
 			bool operator()(const value_type& lhs, const value_type& rhs) const 
 			{ 
 				return comp(lhs.first, rhs.first); 
@@ -90,12 +125,13 @@ class map {
 		explicit map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
 			_node_count(0),
 			_alloc(alloc),
-			_comp(comp)
+			_node_alloc(alloc),
+			_comp(comp),
+			_block(NULL),
+			_block_size(0),
+			_block_live(0)
 		{
-			_end = new_node(ft::pair<const key_type, mapped_type>());
-			_root = _end;
-			_end->left = _end;
-			_end->right = _end;
+			reset_header();
 		}
 
  		/**
@@ -110,13 +146,13 @@ class map {
 		map(InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
 			_node_count(0),
 			_alloc(alloc),
-			_comp(comp)
+			_node_alloc(alloc),
+			_comp(comp),
+			_block(NULL),
+			_block_size(0),
+			_block_live(0)
 		{
-			_end = new_node(ft::pair<const key_type, mapped_type>());
-			_root = _end;
-			_end->left = _end;
-			_end->right = _end;
-
+			reset_header();
 			insert(first, last);
 		}
 
@@ -126,22 +162,20 @@ class map {
         */
 		map(const map& other) :
 			_node_count(0),
-			_alloc(other._alloc),
-			_node_alloc(other._node_alloc),
-			_comp(other._comp)
-		{
-			_end = new_node(ft::pair<const key_type, mapped_type>());
-			_root = _end;
-			_end->left = _end;
-			_end->right = _end;
-			
+			_alloc(allocator_propagation<Allocator>::select_on_copy(other._alloc)),
+			_node_alloc(_alloc),
+			_comp(other._comp),
+			_block(NULL),
+			_block_size(0),
+			_block_live(0)
+		{
+			reset_header();
 			insert(other.begin(), other.end());
 		}
 
 		~map()
         {
             clear();
-            dealloc_node(_end);
         }
 
 		/**
@@ -149,27 +183,32 @@ class map {
         *  @param  other  A %map of identical element and allocator types.
         *
         *  All the elements of other are copied, but unlike the copy constructor,
-        *  the allocator object is not copied.
+        *  the allocator object is not copied, unless its
+        *  propagate_on_container_copy_assignment says so (see
+        *  allocator_propagation).
         */
 		map& operator=(const map& other)
 		{
-			map temp(other);
-			swap(temp);
+			if (this == &other)
+				return *this;
+			map temp(other.begin(), other.end(), other._comp,
+				allocator_propagation<Allocator>::on_copy_assignment ? other._alloc : _alloc);
+			swap_all(temp);
 			return *this;
 		}
 
 	// Get a copy of the memory allocation object.
 		allocator_type get_allocator() const 
 		{
-			return (allocator_type());
+			return (_alloc);
 		}
 
 	/* ---------- ITERATORS --------------------------------------------------------- */
-		iterator begin() { return iterator(_end->right, _end, _comp); }
-		const_iterator begin() const { return const_iterator(_end->right, _end, _comp); }
+		iterator begin() { return iterator(_header.left(), header(), _comp); }
+		const_iterator begin() const { return const_iterator(_header.left(), header(), _comp); }
 
-		iterator end() { return iterator(_end, _end, _comp); }
-		const_iterator end() const { return const_iterator(_end, _end, _comp); }
+		iterator end() { return iterator(header(), header(), _comp); }
+		const_iterator end() const { return const_iterator(header(), header(), _comp); }
 
 		reverse_iterator rbegin() { return reverse_iterator(end()); }
 		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
@@ -179,7 +218,7 @@ class map {
 	/*
 	* ---------- CAPACITY --------------------------------------------------------- *
 	*/
-		bool empty()
+		bool empty() const
         {
 			return _node_count == 0;
         }
@@ -187,7 +226,7 @@ class map {
 		size_type max_size() const
 		{
 			const size_t diff_max = std::numeric_limits<difference_type>::max();
-			const size_t alloc_max = _node_alloc().max_size();
+			const size_t alloc_max = _node_alloc.max_size();
 
 			return std::min(diff_max, alloc_max);
 		}
@@ -206,24 +245,18 @@ class map {
         *  @throw  std::out_of_range  If no such data is present.*/
 		mapped_type& at(const key_type& key)
 		{
-			node_pointer temp = search_by_key(_root, key);
+			node_pointer temp = search_by_key(key_layout::probe(key));
 			if (!temp)
 				throw std::out_of_range("map::at:  key not found");
-			iterator it(temp, _end, _comp);
-			if (it == end())
-				throw std::out_of_range("map::at:  key not found");
-			return it->second;
+			return temp->value.second;
 		}
 
 		const mapped_type at(const key_type& key) const 
 		{
-			node_pointer temp = search_by_key(_root, key);
+			node_pointer temp = search_by_key(key_layout::probe(key));
 			if (!temp)
 				throw std::out_of_range("map::at:  key not found");
-			const_iterator it(temp, _end, _comp);
-			if (it == end())
-				throw std::out_of_range("map::at:  key not found");
-			return it->second;
+			return temp->value.second;
 		}
 
 		/* Returns a reference to the value that is mapped to a key 
@@ -231,12 +264,13 @@ class map {
 		* does not already exist.*/
 		mapped_type& operator[](const key_type& key)
 		{
-			node_pointer temp = search_by_key(_root, key);
+			base_pointer parent;
+			bool left;
+			node_pointer temp = find_slot(key_layout::probe(key), parent, left);
 
 			if (temp)
 				return temp->value.second;
-			_node_count++;
-			return insertNode(_root, ft::make_pair<key_type, mapped_type>(key, mapped_type()))->value.second;
+			return link_node(parent, left, value_type(key, mapped_type()))->value.second;
 		}
 
 	/*
@@ -246,21 +280,23 @@ class map {
 		* After this call, size() returns zero.*/
 		void clear()
 		{
-			while (_node_count != 0)
-			{
-				delete_node(_root, _root->value.first);
-				_node_count--;
-			}
+			destroy_subtree(_header.parent);
+			reset_header();
+			_node_count = 0;
 		}
 
 		void erase(iterator pos)
 		{
-			delete_node(pos.getNode(), pos->first);
-			_node_count--;
+			erase_node(pos.base());
 		}
 
 		void erase(iterator first, iterator last)
 		{
+			if (first == begin() && last == end())
+			{
+				clear();
+				return;
+			}
 			for(; first != last;)
 			{
 				iterator temp(first);
@@ -271,21 +307,36 @@ class map {
 
 		size_type erase(const key_type& key)
 		{
-			bool success = delete_node(_root, key);
-			_node_count -= success;
-			return success;
-			
+			node_pointer to_delete = search_by_key(key_layout::probe(key));
+			if (!to_delete)
+				return 0;
+			erase_node(to_delete);
+			return 1;
+		}
+
+		/* heterogeneous erase, only with a transparent comparator (see find) */
+		template <typename K>
+		typename ft::enable_if<ft::is_transparent<Compare>::value && !ft::is_same<K, iterator>::value
+			&& !ft::is_same<K, const_iterator>::value, size_type>::type
+		erase(const K& key)
+		{
+			node_pointer to_delete = search_by_key(key);
+			if (!to_delete)
+				return 0;
+			erase_node(to_delete);
+			return 1;
 		}
 
 		ft::pair<iterator, bool> insert(const value_type& value)
 		{
 			/*recherche sur la clé est déjà présente et retourne un iterator le cas échéant*/
-			node_pointer existing = search_by_key(_root, value.first);
+			base_pointer parent;
+			bool left;
+			node_pointer existing = find_slot(key_layout::probe(value.first), parent, left);
 			if(existing)
-				return ft::make_pair<iterator, bool>(iterator(existing, _end, _comp), false);
-			_node_count++;
-			return ft::pair<iterator, bool>(iterator(insertNode(_root, value), _end, _comp), true);
+				return ft::make_pair<iterator, bool>(iterator(existing, header(), _comp), false);
 			/*insère la clé dans l'arbre et retourne un iterateur à sa position*/
+			return ft::pair<iterator, bool>(iterator(link_node(parent, left, value), header(), _comp), true);
 		}
 
  		/**
@@ -302,56 +353,171 @@ class map {
         *  parameter is only a hint and can potentially improve the
         *  performance of the insertion process.  A bad hint would
         *  cause no gains in efficiency.
+        *
+        *  When @a value belongs right before @a position, it is linked without
+        *  any descent: inserting sorted input at end() costs no comparison but
+        *  two.
         */
 		iterator insert(iterator pos, const value_type& value)
 		{
-			if (_comp(value.first, pos->first)) 
+			base_pointer hint = pos.base();
+
+			if (hint == header())
 			{
-				iterator previous(pos);
-				previous--;
-				while (previous != end() && !_comp(previous->first, value.first)) 
-				{
-					previous--;
-					pos--;
-				}
+				if (_node_count != 0 && _comp(key_of(_header.right()), value.first))
+					return iterator(link_node(_header.right(), false, value), header(), _comp);
+				return insert(value).first;
 			}
-			else if (_comp(pos->first, value.first)) 
+			if (_comp(value.first, key_of(hint)))
 			{
-				iterator next(pos);
-				next++;
-				while(next != end() && !_comp(value.first, next->first)) 
+				if (hint == _header.left())
+					return iterator(link_node(hint, true, value), header(), _comp);
+				iterator previous(pos);
+				--previous;
+				if (_comp(previous->first, value.first))
 				{
-					next++;
-					pos++;
+					/* one of the two is free: previous is the maximum of hint's left subtree */
+					if (!hint->left())
+						return iterator(link_node(hint, true, value), header(), _comp);
+					return iterator(link_node(previous.base(), false, value), header(), _comp);
 				}
 			}
-
-			if (pos != end() && (pos->first == value.first))
+			else if (!_comp(key_of(hint), value.first))
 				return pos;
-
-			_node_count++;
-			return iterator(insertNode(pos.getNode(), value), _end, _comp);
+			return insert(value).first;
 		}
 
 		template<class InputIt>
 		void insert(InputIt first, InputIt last)
 		{
 			for(; first != last; ++first)
-				insert(*first);
+				insert(end(), *first);
 		}
 
+		/*
+		* O(1) when the allocators are swapped too (propagate_on_container_swap)
+		* or equal. Two maps with different allocators that stay with their
+		* maps cannot exchange nodes: the elements are copied, in linear time.
+		*/
 		void swap(map& other)
 		{
-			std::swap(_root, other._root);
-			std::swap(_end, other._end);
+			if (!allocator_propagation<Allocator>::on_swap && _alloc != other._alloc)
+			{
+				map mine(other.begin(), other.end(), other._comp, _alloc);
+				map theirs(begin(), end(), _comp, other._alloc);
+				swap_all(mine);
+				other.swap_all(theirs);
+				return;
+			}
+			swap_all(other);
+		}
+
+	private:
+		/* everything, the allocators included */
+		void swap_all(map& other)
+		{
+			/* O(1): only the root has to learn its new sentinel */
+			std::swap(_header, other._header);
+			fix_header();
+			other.fix_header();
 			std::swap(_node_count, other._node_count);
 			std::swap(_node_alloc, other._node_alloc);
 			std::swap(_alloc, other._alloc);
 			std::swap(_comp, other._comp);
+			std::swap(_block, other._block);
+			std::swap(_block_size, other._block_size);
+			std::swap(_block_live, other._block_live);
+		}
+
+	public:
+
+		/**
+		*  @brief  Replaces the content with @a n elements given in key order.
+		*  @param  n  Number of elements @a next will produce.
+		*  @param  next  Functor returning the next value_type on each call,
+		*                keys must be strictly increasing.
+		*  @throw  std::invalid_argument  If the keys are not strictly increasing.
+		*
+		*  The elements are consumed in a single forward pass and linked into a
+		*  perfectly balanced tree as they arrive: O(n), no comparison but the
+		*  ordering check and no rebalancing, unlike n calls to insert().
+		*  If @a next throws, the %map is left empty.
+		*/
+		template <typename Generator>
+		void assign_sorted(size_type n, Generator& next)
+		{
+			clear();
+			if (n == 0)
+				return;
+
+			node_pointer last = NULL;
+			_header.parent = build_sorted(n, next, last);
+			_header.parent->parent = header();
+			_header.left() = balance_detail::minimum(_header.parent);
+			_header.right() = last;
+			_node_count = n;
+			Balance::init_sorted(_header.parent);
+		}
+
+		/**
+		*  @brief  Moves every node into one contiguous block, in key order.
+		*  @param  rebalance  Also rebuilds the tree to perfect balance.
+		*
+		*  After a long insert / erase churn the nodes are scattered over the
+		*  heap and scans or look-ups miss the cache on almost every step.
+		*  compact() copies the elements into a single allocation, the first
+		*  element first, and links the copies like the originals: same shape,
+		*  same balancing data, so the map behaves as before, only denser. With
+		*  @a rebalance the copies are linked into a perfectly balanced tree
+		*  instead, as assign_sorted() builds it.
+		*  Keys and values are copied, not rebuilt: the copies compare and hold
+		*  the same. Like any reallocation, it invalidates iterators, pointers
+		*  and references. Later inserts allocate nodes one by one again; the
+		*  block is freed when its last node is erased.
+		*  If a copy throws, the %map is left unchanged. O(n).
+		*/
+		void compact(bool rebalance = false)
+		{
+			if (_node_count == 0)
+				return;
+
+			node_pointer block = _node_alloc.allocate(_node_count);
+			node_pointer root = NULL;
+			size_type placed = 0;
+			try
+			{
+				root = place_subtree(_header.parent, block, placed);
+			}
+			catch (...)
+			{
+				for (size_type i = 0; i < placed; ++i)
+					_alloc.destroy(&block[i].value);
+				_node_alloc.deallocate(block, _node_count);
+				throw;
+			}
+			if (rebalance)
+				root = link_balanced(block, _node_count);
+
+			size_type n = _node_count;
+			destroy_subtree(_header.parent);
+			_block = block;
+			_block_size = n;
+			_block_live = n;
+			_header.parent = root;
+			root->parent = header();
+			_header.left() = block;
+			_header.right() = block + n - 1;
+			if (rebalance)
+				Balance::init_sorted(root);
 		}
 
 	/*
 	* --------------- LOOK-UP --------------------------------------------------- *
+	*
+	* When Compare declares a member type is_transparent (ft::transparent_less
+	* does), every look-up also has a template overload taking any type K that
+	* Compare can order against key_type: the argument is compared as is, no
+	* key_type temporary is built. Without it, only key_type is accepted.
 	*/	
 		/**
         *  @brief  Finds the number of elements with given key.
@@ -363,8 +529,13 @@ class map {
         */
 		size_type count(const key_type& key) const
 		{
-			node_pointer temp = search_by_key(_root, key);
-			return temp ? 1: 0;
+			return search_by_key(key_layout::probe(key)) ? 1: 0;
+		}
+
+		template <typename K>
+		typename transparent<K, size_type>::type count(const K& key) const
+		{
+			return search_by_key(key) ? 1: 0;
 		}
 
 		/*  This function takes a key and tries to locate the element with which
@@ -372,61 +543,47 @@ class map {
         *  pointing to the sought after %pair.  If unsuccessful it returns the
         *  past-the-end iterator.
         */
-		iterator find(const key_type& key)
-		{
-			node_pointer temp  = search_by_key(_root, key);
-			if (temp)
-				return iterator(temp, _end, _comp);
-			return end();
-		}
+		iterator find(const key_type& key) { return make_iterator(search_by_key(key_layout::probe(key))); }
+		const_iterator find(const key_type& key) const { return make_const_iterator(search_by_key(key_layout::probe(key))); }
 
-		const_iterator find(const key_type& key) const 
-		{
-			node_pointer temp  = search_by_key(_root, key);
-			if (temp)
-				return const_iterator(temp, _end, _comp);
-			return end();
-		}
+		template <typename K>
+		typename transparent<K, iterator>::type find(const K& key) { return make_iterator(search_by_key(key)); }
+		template <typename K>
+		typename transparent<K, const_iterator>::type find(const K& key) const { return make_const_iterator(search_by_key(key)); }
 
 	 	/* Returns an iterator pointing to 
 		* the first element that is not less than (i.e. greater or equal to) key
         */
-		iterator lower_bound(const key_type& key)
+		iterator lower_bound(const key_type& key) { return iterator(lower_bound_node(key_layout::probe(key)), header(), _comp); }
+		const_iterator lower_bound(const key_type& key) const { return const_iterator(lower_bound_node(key_layout::probe(key)), header(), _comp); }
+
+		template <typename K>
+		typename transparent<K, iterator>::type lower_bound(const K& key)
 		{
-			iterator it = begin();
-			for(; it != end(); ++it)
-				if (!(_comp(it->first, key))) 
-					break;
-			return it;
+			return iterator(lower_bound_node(key), header(), _comp);
 		}
 
-		const_iterator lower_bound(const key_type& key) const
+		template <typename K>
+		typename transparent<K, const_iterator>::type lower_bound(const K& key) const
 		{
-			iterator it = begin();
-			for(; it != end(); ++it)
-				if (!(_comp(it->first, key))) 
-					break;
-			return it;
+			return const_iterator(lower_bound_node(key), header(), _comp);
 		}
 
 		/* Returns an iterator pointing to the first element 
 		* that is greater than key.*/
-		iterator upper_bound(const key_type& key)
+		iterator upper_bound(const key_type& key) { return iterator(upper_bound_node(key_layout::probe(key)), header(), _comp); }
+		const_iterator upper_bound(const key_type& key) const { return const_iterator(upper_bound_node(key_layout::probe(key)), header(), _comp); }
+
+		template <typename K>
+		typename transparent<K, iterator>::type upper_bound(const K& key)
 		{
-			iterator it = begin();
-			for(; it != end(); ++it)
-				if (_comp(key, it->first)) //_comp = (key<it)
-					break;
-			return it;
+			return iterator(upper_bound_node(key), header(), _comp);
 		}
 
-		const_iterator upper_bound(const key_type& key) const
+		template <typename K>
+		typename transparent<K, const_iterator>::type upper_bound(const K& key) const
 		{
-			iterator it = begin();
-			for(; it != end(); ++it)
-				if (_comp(key, it->first)) 
-					break;
-			return it;
+			return const_iterator(upper_bound_node(key), header(), _comp);
 		}
 
 		/* Returns a range containing all elements with the given key in the container. 
@@ -449,6 +606,18 @@ class map {
 			return ft::make_pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
 		}
 
+		template <typename K>
+		typename transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& key)
+		{
+			return ft::make_pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+		}
+
+		template <typename K>
+		typename transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& key) const
+		{
+			return ft::make_pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+		}
+
 	/*
 	* --------------- OBSERVERS -------------------------------------------------- *
 	*/	
@@ -462,393 +631,438 @@ class map {
     */
 		value_compare value_comp() const { return value_compare(_comp); }
 
+	/*
+	* --------------- INTROSPECTION ---------------------------------------------- *
+	*/
+
+		/* Bytes owned by the map: the object itself and its heap blocks.
+		* An empty map owns no heap block. */
+		size_type memory_usage() const
+		{
+			return sizeof(*this) + heap_nodes() * sizeof(Node);
+		}
+
+		/* Detailed memory and shape report, walks the whole tree: O(n). */
+		map_stats stats() const
+		{
+			map_stats s;
+			s.node_count = _node_count;
+			s.node_size = sizeof(Node);
+			s.value_size = sizeof(value_type);
+			s.per_node_overhead = sizeof(Node) - sizeof(value_type);
+			s.sentinel_bytes = 0;
+			s.bytes_allocated = heap_nodes() * sizeof(Node);
+			fill_depth_histogram(_header.parent, 0, s.depth_histogram);
+			s.height = s.depth_histogram.size();
+			return s;
+		}
+
 
 	private:
-		node_pointer	_root;// left child of end
-        node_pointer    _end;// parent of root
+		map_node_base	_header;// end(): parent -> root, left -> first, right -> last
 		size_type 		_node_count; //keeps track oh the size
 		allocator_type	_alloc;
         node_alloc 	 	_node_alloc;
 		key_compare		_comp;	
+		node_pointer	_block;		// nodes placed by compact(), NULL if none
+		size_type		_block_size;
+		size_type		_block_live;// nodes of the block still in the tree
+
+		base_pointer header() const { return const_cast<base_pointer>(&_header); }
+
+		/* node slots owned: the nodes outside the block and the whole block,
+		* including the slots its erased nodes left */
+		size_type heap_nodes() const { return _node_count - _block_live + _block_size; }
+
+		static const key_type& key_of(base_pointer node)
+		{
+			return static_cast<node_pointer>(node)->value.first;
+		}
+
+		/* empty tree: no root, first and last are end() */
+		void reset_header()
+		{
+			_header.rank = 0;
+			_header.parent = NULL;
+			_header.left() = header();
+			_header.right() = header();
+		}
+
+		/* after the header was copied from another map */
+		void fix_header()
+		{
+			if (_header.parent)
+				_header.parent->parent = header();
+			else
+				reset_header();
+		}
 
 		node_pointer new_node(const value_type& value)
 		{
 			Node* new_node = _node_alloc.allocate(1);
-			new_node->left = NULL;
-			new_node->right = NULL;
+			new_node->left() = NULL;
+			new_node->right() = NULL;
 			new_node->parent = NULL;
 			
-			_alloc.construct(&new_node->value, value);
-
+			try
+			{
+				_alloc.construct(&new_node->value, value);
+			}
+			catch (...)
+			{
+				_node_alloc.deallocate(new_node, 1);
+				throw;
+			}
+			key_layout::init(new_node);
 			return new_node;
 		}
 
+		/* a node placed by compact() only leaves its slot, the block is freed
+		* with its last node */
 		void dealloc_node(node_pointer to_delete)
 		{
 			_alloc.destroy(&to_delete->value);
-			_node_alloc.deallocate(to_delete, 1);
+			if (!in_block(to_delete))
+				_node_alloc.deallocate(to_delete, 1);
+			else if (--_block_live == 0)
+			{
+				_node_alloc.deallocate(_block, _block_size);
+				_block = NULL;
+				_block_size = 0;
+			}
 		}
 
-		int getBalanceFactor(node_pointer n)
+		bool in_block(node_pointer node) const
 		{
-			if (n == NULL)
-				return -1;
-			else 
-				return(tree_height(n->left) - tree_height(n->right));
+			std::less<node_pointer> before;
+			return _block && !before(node, _block) && before(node, _block + _block_size);
 		}
 
-		/* the height of a BST is the number of edges between the tree's root
-		and its furthest leaf */
-		int tree_height(Node* r)
+		/* copies the subtree into the next slots of block in key order and
+		* links the copies like the originals: same shape, same ranks.
+		* Returns the copy of node; placed counts the constructed slots. */
+		node_pointer place_subtree(base_pointer node, node_pointer block, size_type& placed)
 		{
-			if (r == NULL || r == _end)
-				return -1;
-			else 
-			{
-				int left_height = tree_height(r->left);
-				int right_height = tree_height(r->right);
-				if (left_height > right_height)
-					return (left_height + 1);
-				else
-					return (right_height + 1);
-			}
+			if (!node)
+				return NULL;
+			node_pointer left = place_subtree(node->left(), block, placed);
+			node_pointer copy = block + placed;
+			_alloc.construct(&copy->value, static_cast<node_pointer>(node)->value);
+			key_layout::init(copy);
+			placed++;
+			copy->rank = node->rank;
+			copy->left() = left;
+			if (left)
+				left->parent = copy;
+			copy->right() = place_subtree(node->right(), block, placed);
+			if (copy->right())
+				copy->right()->parent = copy;
+			return copy;
 		}
 
-		node_pointer search_by_key(node_pointer node_r, key_type key) const
+		/* links n nodes, consecutive in key order, into a perfectly balanced
+		* tree shaped like the one of build_sorted() */
+		static node_pointer link_balanced(node_pointer first, size_type n)
 		{
-			if (node_r == NULL || node_r == _end)
+			if (n == 0)
 				return NULL;
-			
-			if (!_comp(node_r->value.first, key) && !_comp(key, node_r->value.first))
-				return node_r;
-			else if (_comp(key, node_r->value.first) && node_r->left && node_r->left != _end) 
-				return search_by_key(node_r->left, key);
-			else if (_comp(node_r->value.first, key) && node_r->right && node_r->right != _end) 
-				return search_by_key(node_r->right, key);
-			return NULL;
+			size_type left_count = n / 2;
+			node_pointer node = first + left_count;
+			node->left() = link_balanced(first, left_count);
+			if (node->left())
+				node->left()->parent = node;
+			node->right() = link_balanced(node + 1, n - left_count - 1);
+			if (node->right())
+				node->right()->parent = node;
+			return node;
 		}
 
-		node_pointer insertNode(node_pointer pos, const value_type& value)
+		iterator make_iterator(base_pointer node)
 		{
-			if (_root == _end)
-			{
-				_root = new_node(value);
+			return iterator(node ? node : header(), header(), _comp);
+		}
+
+		const_iterator make_const_iterator(base_pointer node) const
+		{
+			return const_iterator(node ? node : header(), header(), _comp);
+		}
 
-				_root->left = _end;
-				_root->right = _end;
-				_end->left = _root;
-				_end->right = _root;
+		/* key < node and node < key. K is key_type, a transparent look-up
+		* argument or a prefixed_key */
+		template <typename K>
+		bool key_less(const K& key, base_pointer node) const { return _comp(key, key_of(node)); }
 
-				return _root;
-			}
+		template <typename K>
+		bool node_less(base_pointer node, const K& key) const { return _comp(key_of(node), key); }
 
-			if (_comp(pos->value.first, value.first) && _comp(value.first, pos->value.first)) 
-				return NULL; //node existe deja
-
-			if (_comp(value.first, pos->value.first) && pos->left && pos->left != _end) 
-				return insertNode(pos->left, value);
-			if (_comp(pos->value.first, value.first) && pos->right && pos->right != _end)
-				return insertNode(pos->right, value);
-
-			node_pointer newNode = new_node(value);
-			/*cas où je peux insérer dans une leaf node*/
-			if (_comp(newNode->value.first, pos->value.first) && !pos->left) 
-				pos->left = newNode;
-			else if (_comp(pos->value.first, newNode->value.first) && !pos->right) 
-				pos->right = newNode;
-			else if (pos->left && _comp(newNode->value.first, pos->value.first)) 
+		/* prefixed nodes: the full keys are only compared on a prefix tie */
+		bool key_less(const ft::prefixed_key<key_type>& key, base_pointer node) const
+		{
+			uint64_t prefix = static_cast<node_pointer>(node)->prefix;
+			if (key.prefix != prefix)
+				return key.prefix < prefix;
+			return _comp(key.key, key_of(node));
+		}
+
+		bool node_less(base_pointer node, const ft::prefixed_key<key_type>& key) const
+		{
+			uint64_t prefix = static_cast<node_pointer>(node)->prefix;
+			if (key.prefix != prefix)
+				return prefix < key.prefix;
+			return _comp(key_of(node), key.key);
+		}
+
+		template <typename K>
+		node_pointer search_by_key(const K& key) const
+		{
+			if (map_branchless_descent<Key, Compare>::value)
 			{
-				newNode->left = _end;
-				_end->right = newNode;
-				pos->left = newNode;
+				/* no early exit: the lower bound is the key or it is absent */
+				base_pointer bound = lower_bound_node(key);
+				if (bound != header() && !key_less(key, bound))
+					return static_cast<node_pointer>(bound);
+				return NULL;
 			}
-			else if (pos->right && _comp(pos->value.first, newNode->value.first)) 
+
+			base_pointer node = _header.parent;
+
+			while (node)
 			{
-				newNode->right = _end;
-				_end->left = newNode;
-				pos->right = newNode;
+				if (key_less(key, node))
+					node = node->left();
+				else if (node_less(node, key))
+					node = node->right();
+				else
+					return static_cast<node_pointer>(node);
 			}
-			newNode->parent = pos;
-
-			balance_tree(&_root, newNode);
-			return newNode;
+			return NULL;
 		}
 
-		bool delete_node(node_pointer node, key_type key)
+		/* first node whose key is not less than key, or the header */
+		template <typename K>
+		base_pointer lower_bound_node(const K& key) const
 		{
-			node_pointer to_delete = search_by_key(node, key);
-			if (!to_delete)
-				return false;
-			
-			node_pointer to_balance = NULL;
-			/*CASE : ROOT NODE TO DELETE */
-			if (!to_delete->parent)
+			base_pointer node = _header.parent;
+			base_pointer result = header();
+
+			if (map_branchless_descent<Key, Compare>::value)
 			{
-				if (to_delete->left == _end && to_delete->right == _end) 
-				{
-					_root = _end;
-					_end->left = _end;
-					_end->right = _end;
-				}
-				else if (to_delete->left && to_delete->right == _end)
+				while (node)
 				{
-					to_balance = to_delete->parent;
-					_root = to_delete->left;
-					to_delete->left->parent = NULL;
-					_end->left = to_delete->left;
-					to_delete->left->right = _end;
-				}
-				else if (to_delete->right && to_delete->left == _end)
-				{
-					to_balance = to_delete->parent;
-					_root = to_delete->right;
-					to_delete->right->parent = NULL;
-					_end->right = to_delete->right;
-					to_delete->right->left = _end;
-				}
-				else
-				{
-					node_pointer max_node = maximum(to_delete->left);
-					_alloc.destroy(&to_delete->value);
-					_alloc.construct(&to_delete->value, max_node->value);
-					return (delete_node(to_delete->left, max_node->value.first));
+					bool right = node_less(node, key);
+					result = right ? result : node;
+					node = node->child[right];
 				}
+				return result;
 			}
-			/* CASE : LEAF NODE TO DELETE */
-			else if ((!to_delete->left || to_delete->left == _end) && (!to_delete->right || to_delete->right == _end))
+			while (node)
 			{
-				to_balance = to_delete->parent;
-				node_pointer temp = NULL;
-				if (to_delete->left == _end || to_delete->right == _end)
+				if (node_less(node, key))
+					node = node->right();
+				else
 				{
-					temp = _end;
-					if (!_comp(to_delete->parent->value.first, to_delete->value.first))
-						_end->right = to_delete->parent;
-					else if (_comp(to_delete->parent->value.first, to_delete->value.first))
-						_end->left = to_delete->parent;
+					result = node;
+					node = node->left();
 				}
-				if (!_comp(to_delete->parent->value.first, to_delete->value.first))
-					to_delete->parent->left = temp;
-				else if (_comp(to_delete->parent->value.first, to_delete->value.first))
-					to_delete->parent->right = temp;
-
 			}
-			/* CASE : NODE TO DELETE HAVE A LEFT CHILD */
-			else if ((to_delete->left && to_delete->left != _end) && (!to_delete->right || to_delete->right == _end))
+			return result;
+		}
+
+		/* first node whose key is greater than key, or the header */
+		template <typename K>
+		base_pointer upper_bound_node(const K& key) const
+		{
+			base_pointer node = _header.parent;
+			base_pointer result = header();
+
+			if (map_branchless_descent<Key, Compare>::value)
 			{
-				to_balance = to_delete->parent;
-				if (!_comp(to_delete->parent->value.first, to_delete->value.first))
-					to_delete->parent->left = to_delete->left;
-				else if (_comp(to_delete->parent->value.first, to_delete->value.first))
-					to_delete->parent->right = to_delete->left;
-				to_delete->left->parent = to_delete->parent;
-
-				if (to_delete->right == _end)
+				while (node)
 				{
-					_end->left = to_delete->left;
-					to_delete->left->right = _end;
+					bool right = !key_less(key, node);
+					result = right ? result : node;
+					node = node->child[right];
 				}
+				return result;
 			}
-			/* CASE : NODE TO DELETE HAVE A RIGHT CHILD */
-			else if (to_delete->right && to_delete->right != _end && (!to_delete->left || to_delete->left == _end))
+			while (node)
 			{
-				to_balance = to_delete->parent;
-				if (!_comp(to_delete->parent->value.first, to_delete->value.first))
-					to_delete->parent->left = to_delete->right;
-				else if (_comp(to_delete->parent->value.first, to_delete->value.first))
-					to_delete->parent->right = to_delete->right;
-				to_delete->right->parent = to_delete->parent;
-
-				if(to_delete->left == _end)
+				if (key_less(key, node))
 				{
-					_end->right = to_delete->right;
-					to_delete->right->left = _end;
+					result = node;
+					node = node->left();
 				}
-			} 
-			/* CASE : NODE TO DELETE HAVE TWO CHILDREN */
-			else 
-			{
-				node_pointer max_node = maximum(to_delete->left);
-				_alloc.destroy(&to_delete->value);
-				_alloc.construct(&to_delete->value, max_node->value);
-				return (delete_node(to_delete->left, max_node->value.first));
+				else
+					node = node->right();
 			}
-			balance_tree(&_root, to_balance);
-			dealloc_node(to_delete);
-			return true;
+			return result;
 		}
 
-		void balance_tree(node_pointer* root, node_pointer node)
+		/* returns the node holding key, or NULL and where it would be linked:
+		* as the left or right child of parent (the header for an empty tree) */
+		template <typename K>
+		node_pointer find_slot(const K& key, base_pointer& parent, bool& left) const
 		{
+			base_pointer node = _header.parent;
+
+			parent = header();
+			left = true;
+			if (map_branchless_descent<Key, Compare>::value)
+			{
+				/* down to a leaf, keeping the lower bound as a candidate */
+				base_pointer bound = NULL;
+				bool right = false;
+				while (node)
+				{
+					parent = node;
+					right = node_less(node, key);
+					bound = right ? bound : node;
+					node = node->child[right];
+				}
+				left = !right;
+				if (bound && !key_less(key, bound))
+					return static_cast<node_pointer>(bound);
+				return NULL;
+			}
 			while (node)
 			{
-				int balance_factor = getBalanceFactor(node);
-
-				if (balance_factor > 1 && getBalanceFactor(node->left) > 0) //left heavy case
-					right_rotate(root, node);
-				else if (balance_factor < -1 && getBalanceFactor(node->right) < 0) // right heavy case
-					left_rotate(root, node);
-				else if (balance_factor < -1 && getBalanceFactor(node->right) >= 0) //right-left case
+				parent = node;
+				if (key_less(key, node))
 				{
-					right_rotate(root, node->right);
-					left_rotate(root, node);
+					left = true;
+					node = node->left();
 				}
-				else if (balance_factor > 1 && getBalanceFactor(node->left) <= 0) //left-right case
+				else if (node_less(node, key))
 				{
-					left_rotate(root, node->left);
-					right_rotate(root, node);
+					left = false;
+					node = node->right();
 				}
-				node = node->parent;
+				else
+					return static_cast<node_pointer>(node);
 			}
+			return NULL;
 		}
 
-
-
-		void right_rotate(node_pointer* root, node_pointer node)
-		{
-			node_pointer left_node = node->left;
-			node_pointer center_node = left_node->right;
-
-			if (center_node)
-				center_node->parent = node;
-
-			left_node->right = node;
-			node->left = center_node;
-
-			left_node->parent = node->parent;
-
-			if (node->parent && node->parent->left == node)
-				node->parent->left = left_node;
-			else if (node->parent)
-				node->parent->right = left_node;
-			node->parent = left_node;
-
-			if (!left_node->parent)
-				*root = left_node;
-		}
-
-		void left_rotate(node_pointer* root, node_pointer node)
+		/* links a new node at an empty child slot of parent found by
+		* find_slot() or by a hint */
+		node_pointer link_node(base_pointer parent, bool left, const value_type& value)
 		{
-			node_pointer right_node = node->right;
-			node_pointer center_node = right_node->left;
-
-			if (center_node)
-				center_node->parent = node;
-
-			right_node->left = node;
-			node->right = center_node;
+			node_pointer node = new_node(value);
 
-			right_node->parent = node->parent;
-			if (node->parent && node->parent->left == node)
-				node->parent->left = right_node;
-			else if (node->parent)
-				node->parent->right = right_node;
-
-			node->parent = right_node;
-
-			if(!right_node->parent)
-				*root = right_node;
+			Balance::insert_and_rebalance(left, node, parent, _header);
+			_node_count++;
+			return node;
 		}
 
-		/*find the node with the maximum key*/
-		node_pointer maximum(node_pointer node)
+		void erase_node(base_pointer to_delete)
 		{
-			while (node->right && node->right != _end)
-				return maximum(node->right);
-			return node;
+			Balance::erase_and_rebalance(to_delete, _header);
+			dealloc_node(static_cast<node_pointer>(to_delete));
+			_node_count--;
 		}
 
-		/*find the node with the minimum key*/
-		node_pointer minimum(node_pointer node)
+		/* builds the in-order subtree of the n next elements: left half first,
+		* then its root, then the right half, so that next() is called in key order.
+		* last is the previously built node, used to check the ordering. */
+		template <typename Generator>
+		node_pointer build_sorted(size_type n, Generator& next, node_pointer& last)
 		{
-			if (node->left && node->left != _end)
-				return minimum(node->left);
+			if (n == 0)
+				return NULL;
+			size_type left_count = n / 2;
+			node_pointer left = build_sorted(left_count, next, last);
+			node_pointer node = NULL;
+			try
+			{
+				node = new_node(next());
+				if (last && !_comp(last->value.first, node->value.first))
+					throw std::invalid_argument("map::assign_sorted: keys not strictly increasing");
+				last = node;
+				node->left() = left;
+				if (left)
+					left->parent = node;
+				node->right() = build_sorted(n - left_count - 1, next, last);
+				if (node->right())
+					node->right()->parent = node;
+			}
+			catch (...)
+			{
+				destroy_subtree(left);
+				if (node)
+					dealloc_node(node);
+				throw;
+			}
 			return node;
 		}
 
-		/* find the successor of a given node : if the right subtree != null
-		 * the successor is the leftmost node in the right subtree;
-		 * else it is the lowest ancestor of the node;
-		 * basically: one step left and right till you can
-		*/
-		node_pointer successor(node_pointer node)
+		void fill_depth_histogram(base_pointer node, size_type depth, ft::vector<size_type>& histogram) const
 		{
-			if(node->right != NULL)
-				return minimum(node->right);
-			node_pointer parent = node->parent;
-			while (parent != NULL && node == parent->right)
-			{
-				node = parent;
-				parent = parent->parent;
-			}
-			return parent;
+			if (!node)
+				return;
+			if (histogram.size() <= depth)
+				histogram.push_back(0);
+			histogram[depth]++;
+			fill_depth_histogram(node->left(), depth + 1, histogram);
+			fill_depth_histogram(node->right(), depth + 1, histogram);
 		}
 
-		/* find the predecessor of a given node: if the left subtree != null
-		 * the predecessor is the rightmost node in the left subtree
-		 * basically : one step left and then right till you can
-		*/
-		node_pointer predecessor(node_pointer node)
+		void destroy_subtree(base_pointer node)
 		{
-			if(node->left != NULL)
-				return maximum(node->left);
-			node_pointer parent = node->parent;
-			while(parent != NULL && node == parent->left)
+			while (node)
 			{
-				node = parent;
-				parent = parent->parent;
+				destroy_subtree(node->right());
+				base_pointer left = node->left();
+				dealloc_node(static_cast<node_pointer>(node));
+				node = left;
 			}
-			return parent;
 		}
-
-		
 };
 
 /*----------------------------- NON-MEMBER FUNCTIONS ---------------------------------------*/
-template<class Key, class T, class Compare, class Alloc>
-void swap( ft::map<Key, T, Compare, Alloc>& lhs, ft::map<Key, T, Compare, Alloc>& rhs )
+template<class Key, class T, class Compare, class Alloc, class Balance>
+void swap( ft::map<Key, T, Compare, Alloc, Balance>& lhs, ft::map<Key, T, Compare, Alloc, Balance>& rhs )
 {
 	lhs.swap(rhs);
 }
 
-template< class Key, class T, class Compare, class Alloc >
-bool operator==( const ft::map<Key, T, Compare, Alloc>& x,
-                 const ft::map<Key, T, Compare, Alloc>& y )
+template< class Key, class T, class Compare, class Alloc, class Balance >
+bool operator==( const ft::map<Key, T, Compare, Alloc, Balance>& x,
+                 const ft::map<Key, T, Compare, Alloc, Balance>& y )
 {
 	return (x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin()));
 }
 
-template< class Key, class T, class Compare, class Alloc >
-bool operator!=( const ft::map<Key, T, Compare, Alloc>& x,
-                 const ft::map<Key, T, Compare, Alloc>& y )
+template< class Key, class T, class Compare, class Alloc, class Balance >
+bool operator!=( const ft::map<Key, T, Compare, Alloc, Balance>& x,
+                 const ft::map<Key, T, Compare, Alloc, Balance>& y )
 {
 	return !(x == y);
 }
 
-template< class Key, class T, class Compare, class Alloc >
-bool operator<( const ft::map<Key, T, Compare, Alloc>& x,
-                const ft::map<Key, T, Compare, Alloc>& y )
+template< class Key, class T, class Compare, class Alloc, class Balance >
+bool operator<( const ft::map<Key, T, Compare, Alloc, Balance>& x,
+                const ft::map<Key, T, Compare, Alloc, Balance>& y )
 {
 	return (ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
 }
 
-template< class Key, class T, class Compare, class Alloc >
-bool operator<=( const ft::map<Key, T, Compare, Alloc>& x,
-                 const ft::map<Key, T, Compare, Alloc>& y )
+template< class Key, class T, class Compare, class Alloc, class Balance >
+bool operator<=( const ft::map<Key, T, Compare, Alloc, Balance>& x,
+                 const ft::map<Key, T, Compare, Alloc, Balance>& y )
 {
 	return !(y < x);
 }
 
-template< class Key, class T, class Compare, class Alloc >
-bool operator>( const ft::map<Key, T, Compare, Alloc>& x,
-                const ft::map<Key, T, Compare, Alloc>& y )
+template< class Key, class T, class Compare, class Alloc, class Balance >
+bool operator>( const ft::map<Key, T, Compare, Alloc, Balance>& x,
+                const ft::map<Key, T, Compare, Alloc, Balance>& y )
 {
 	return (y < x);
 }
 
-template< class Key, class T, class Compare, class Alloc >
-bool operator>=( const ft::map<Key, T, Compare, Alloc>& x,
-                 const ft::map<Key, T, Compare, Alloc>& y )
+template< class Key, class T, class Compare, class Alloc, class Balance >
+bool operator>=( const ft::map<Key, T, Compare, Alloc, Balance>& x,
+                 const ft::map<Key, T, Compare, Alloc, Balance>& y )
 {
 	return !(x < y);
 }							
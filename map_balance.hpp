@@ -0,0 +1,436 @@
+#ifndef MAP_BALANCE_HPP
+#define MAP_BALANCE_HPP
+
+#include "avl_iterator.hpp"
+
+/*
+* Balancing policies of ft::map, its fifth template argument.
+*
+* A policy only sees the links of the nodes and the header of the map (see
+* map_node_base), never the values, so the same code serves every map. It
+* keeps its own data in map_node_base::rank and provides:
+*
+*	insert_and_rebalance(insert_left, node, parent, header)
+*		links the new node as a child of parent (the header for an empty
+*		tree), updates the first / last links of the header and rebalances.
+*	erase_and_rebalance(node, header)
+*		unlinks the node, updates the header and rebalances; the node is not
+*		freed. Nodes never exchange values, iterators stay valid.
+*	init_sorted(root)
+*		sets the data of a tree built by map::assign_sorted(): the sizes of
+*		the two subtrees of any node differ by at most one, left first.
+*
+*	ft::avl_balance		height balanced: lower trees, faster lookups, up to
+*						O(log n) rotations per erase. The default.
+*	ft::rb_balance		red-black: at most 2 rotations per insert and 3 per
+*						erase, O(1) amortized recoloring; trees up to twice as
+*						high as the optimum.
+*/
+
+namespace ft {
+
+	namespace balance_detail {
+
+		typedef map_node_base*	base_pointer;
+
+		inline base_pointer minimum(base_pointer node)
+		{
+			while (node->left())
+				node = node->left();
+			return node;
+		}
+
+		inline base_pointer maximum(base_pointer node)
+		{
+			while (node->right())
+				node = node->right();
+			return node;
+		}
+
+		/* makes new_node the child of old_node's parent in place of old_node */
+		inline void replace_child(base_pointer old_node, base_pointer new_node, map_node_base& header)
+		{
+			if (old_node == header.parent)
+				header.parent = new_node;
+			else if (old_node == old_node->parent->left())
+				old_node->parent->left() = new_node;
+			else
+				old_node->parent->right() = new_node;
+			if (new_node)
+				new_node->parent = old_node->parent;
+		}
+
+		inline void rotate_left(base_pointer node, map_node_base& header)
+		{
+			base_pointer right_node = node->right();
+
+			node->right() = right_node->left();
+			if (right_node->left())
+				right_node->left()->parent = node;
+			replace_child(node, right_node, header);
+			right_node->left() = node;
+			node->parent = right_node;
+		}
+
+		inline void rotate_right(base_pointer node, map_node_base& header)
+		{
+			base_pointer left_node = node->left();
+
+			node->left() = left_node->right();
+			if (left_node->right())
+				left_node->right()->parent = node;
+			replace_child(node, left_node, header);
+			left_node->right() = node;
+			node->parent = left_node;
+		}
+
+		/* the part of an insertion common to every policy */
+		inline void link(bool insert_left, base_pointer node, base_pointer parent, map_node_base& header)
+		{
+			node->parent = parent;
+			node->left() = NULL;
+			node->right() = NULL;
+			if (parent == &header)
+			{
+				header.parent = node;
+				header.left() = node;
+				header.right() = node;
+			}
+			else if (insert_left)
+			{
+				parent->left() = node;
+				if (parent == header.left())
+					header.left() = node;
+			}
+			else
+			{
+				parent->right() = node;
+				if (parent == header.right())
+					header.right() = node;
+			}
+		}
+
+		/* the first / last links must leave a node before it is unlinked */
+		inline void unlink_bounds(base_pointer node, map_node_base& header)
+		{
+			if (node == header.left())
+				header.left() = node->right() ? minimum(node->right()) : node->parent;
+			if (node == header.right())
+				header.right() = node->left() ? maximum(node->left()) : node->parent;
+		}
+	}
+
+	/* rank = height of the subtree, a leaf is 1 */
+	struct avl_balance
+	{
+		typedef map_node_base*	base_pointer;
+
+		static void insert_and_rebalance(bool insert_left, base_pointer node, base_pointer parent, map_node_base& header)
+		{
+			balance_detail::link(insert_left, node, parent, header);
+			node->rank = 1;
+			rebalance(parent, header);
+		}
+
+		static void erase_and_rebalance(base_pointer node, map_node_base& header)
+		{
+			base_pointer to_balance;
+
+			balance_detail::unlink_bounds(node, header);
+			if (!node->left() || !node->right())
+			{
+				to_balance = node->parent;
+				balance_detail::replace_child(node, node->left() ? node->left() : node->right(), header);
+			}
+			else
+			{
+				/* the successor takes the place, and the height, of the node */
+				base_pointer next = balance_detail::minimum(node->right());
+				if (next->parent != node)
+				{
+					to_balance = next->parent;
+					balance_detail::replace_child(next, next->right(), header);
+					next->right() = node->right();
+					next->right()->parent = next;
+				}
+				else
+					to_balance = next;
+				balance_detail::replace_child(node, next, header);
+				next->left() = node->left();
+				next->left()->parent = next;
+				next->rank = node->rank;
+			}
+			rebalance(to_balance, header);
+		}
+
+		static void init_sorted(base_pointer node)
+		{
+			if (!node)
+				return;
+			init_sorted(node->left());
+			init_sorted(node->right());
+			update_height(node);
+		}
+
+		private:
+			static int height(base_pointer node)
+			{
+				return node ? node->rank : 0;
+			}
+
+			static void update_height(base_pointer node)
+			{
+				int left_height = height(node->left());
+				int right_height = height(node->right());
+
+				node->rank = (left_height > right_height ? left_height : right_height) + 1;
+			}
+
+			static void rotate_left(base_pointer node, map_node_base& header)
+			{
+				balance_detail::rotate_left(node, header);
+				update_height(node);
+				update_height(node->parent);
+			}
+
+			static void rotate_right(base_pointer node, map_node_base& header)
+			{
+				balance_detail::rotate_right(node, header);
+				update_height(node);
+				update_height(node->parent);
+			}
+
+			/* walks up from the lowest node whose subtree changed, and stops as
+			* soon as a subtree keeps its height: nothing above can change */
+			static void rebalance(base_pointer node, map_node_base& header)
+			{
+				while (node != &header)
+				{
+					int old_height = node->rank;
+					int balance_factor = height(node->left()) - height(node->right());
+
+					if (balance_factor > 1)
+					{
+						if (height(node->left()->left()) < height(node->left()->right())) //left-right case
+							rotate_left(node->left(), header);
+						rotate_right(node, header);
+						node = node->parent;
+					}
+					else if (balance_factor < -1)
+					{
+						if (height(node->right()->right()) < height(node->right()->left())) //right-left case
+							rotate_right(node->right(), header);
+						rotate_left(node, header);
+						node = node->parent;
+					}
+					else
+						update_height(node);
+					if (node->rank == old_height)
+						break;
+					node = node->parent;
+				}
+			}
+	};
+
+	/* rank = color; the root is black, a red node has black children and
+	* every path from a node down to a NULL link meets as many black nodes */
+	struct rb_balance
+	{
+		typedef map_node_base*	base_pointer;
+
+		enum { red = 0, black = 1 };
+
+		static void insert_and_rebalance(bool insert_left, base_pointer node, base_pointer parent, map_node_base& header)
+		{
+			balance_detail::link(insert_left, node, parent, header);
+			node->rank = red;
+
+			while (node != header.parent && node->parent->rank == red)
+			{
+				/* a red parent is never the root: the grandparent exists */
+				base_pointer grandparent = node->parent->parent;
+
+				if (node->parent == grandparent->left())
+				{
+					base_pointer uncle = grandparent->right();
+					if (uncle && uncle->rank == red)
+					{
+						node->parent->rank = black;
+						uncle->rank = black;
+						grandparent->rank = red;
+						node = grandparent;
+						continue;
+					}
+					if (node == node->parent->right())
+					{
+						node = node->parent;
+						balance_detail::rotate_left(node, header);
+					}
+					node->parent->rank = black;
+					grandparent->rank = red;
+					balance_detail::rotate_right(grandparent, header);
+				}
+				else
+				{
+					base_pointer uncle = grandparent->left();
+					if (uncle && uncle->rank == red)
+					{
+						node->parent->rank = black;
+						uncle->rank = black;
+						grandparent->rank = red;
+						node = grandparent;
+						continue;
+					}
+					if (node == node->parent->left())
+					{
+						node = node->parent;
+						balance_detail::rotate_right(node, header);
+					}
+					node->parent->rank = black;
+					grandparent->rank = red;
+					balance_detail::rotate_left(grandparent, header);
+				}
+			}
+			header.parent->rank = black;
+		}
+
+		static void erase_and_rebalance(base_pointer node, map_node_base& header)
+		{
+			base_pointer child;				/* takes the place of the removed position */
+			base_pointer child_parent;		/* its parent, child may be NULL */
+			int removed_color = node->rank;
+
+			balance_detail::unlink_bounds(node, header);
+			if (!node->left() || !node->right())
+			{
+				child = node->left() ? node->left() : node->right();
+				child_parent = node->parent;
+				balance_detail::replace_child(node, child, header);
+			}
+			else
+			{
+				/* the successor takes the place and the color of the node, its
+				* own position is the one that disappears */
+				base_pointer next = balance_detail::minimum(node->right());
+				removed_color = next->rank;
+				child = next->right();
+				if (next->parent != node)
+				{
+					child_parent = next->parent;
+					balance_detail::replace_child(next, child, header);
+					next->right() = node->right();
+					next->right()->parent = next;
+				}
+				else
+					child_parent = next;
+				balance_detail::replace_child(node, next, header);
+				next->left() = node->left();
+				next->left()->parent = next;
+				next->rank = node->rank;
+			}
+			if (removed_color == black)
+				fix_double_black(child, child_parent, header);
+		}
+
+		/* the perfectly balanced tree is black but for its deepest level,
+		* which is red unless it is the root: every path meets the same number
+		* of black nodes. The left subtree is never the smaller one, so the
+		* leftmost node is on the deepest level. */
+		static void init_sorted(base_pointer root)
+		{
+			if (!root)
+				return;
+			int deepest = 0;
+			for (base_pointer node = root; node->left(); node = node->left())
+				++deepest;
+			paint(root, 0, deepest);
+		}
+
+		private:
+			static bool is_black(base_pointer node)
+			{
+				return !node || node->rank == black;
+			}
+
+			static void paint(base_pointer node, int depth, int deepest)
+			{
+				if (!node)
+					return;
+				node->rank = (depth == deepest && depth != 0) ? red : black;
+				paint(node->left(), depth + 1, deepest);
+				paint(node->right(), depth + 1, deepest);
+			}
+
+			/* node is short of one black node on all its paths */
+			static void fix_double_black(base_pointer node, base_pointer parent, map_node_base& header)
+			{
+				while (node != header.parent && is_black(node))
+				{
+					if (node == parent->left())
+					{
+						base_pointer sibling = parent->right();
+						if (sibling->rank == red)
+						{
+							sibling->rank = black;
+							parent->rank = red;
+							balance_detail::rotate_left(parent, header);
+							sibling = parent->right();
+						}
+						if (is_black(sibling->left()) && is_black(sibling->right()))
+						{
+							sibling->rank = red;
+							node = parent;
+							parent = parent->parent;
+							continue;
+						}
+						if (is_black(sibling->right()))
+						{
+							sibling->left()->rank = black;
+							sibling->rank = red;
+							balance_detail::rotate_right(sibling, header);
+							sibling = parent->right();
+						}
+						sibling->rank = parent->rank;
+						parent->rank = black;
+						sibling->right()->rank = black;
+						balance_detail::rotate_left(parent, header);
+					}
+					else
+					{
+						base_pointer sibling = parent->left();
+						if (sibling->rank == red)
+						{
+							sibling->rank = black;
+							parent->rank = red;
+							balance_detail::rotate_right(parent, header);
+							sibling = parent->left();
+						}
+						if (is_black(sibling->left()) && is_black(sibling->right()))
+						{
+							sibling->rank = red;
+							node = parent;
+							parent = parent->parent;
+							continue;
+						}
+						if (is_black(sibling->left()))
+						{
+							sibling->right()->rank = black;
+							sibling->rank = red;
+							balance_detail::rotate_left(sibling, header);
+							sibling = parent->left();
+						}
+						sibling->rank = parent->rank;
+						parent->rank = black;
+						sibling->left()->rank = black;
+						balance_detail::rotate_right(parent, header);
+					}
+					node = header.parent;
+				}
+				if (node)
+					node->rank = black;
+			}
+	};
+
+} // namespace
+
+#endif
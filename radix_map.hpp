@@ -0,0 +1,1353 @@
+#ifndef RADIX_MAP_HPP
+#define RADIX_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+#include "utility.hpp"
+#include "iterator.hpp"
+
+/*
+* ft::radix_map: an ordered map on an adaptive radix tree, for keys that
+* are strings of bytes: the integral types and std::string.
+*
+* A look-up reads the key one byte per level and never compares it with
+* other keys but at the leaf: its cost depends on the key length, not on
+* the number of elements. Inner nodes grow and shrink with their number of
+* children:
+*
+*	node4		4 sorted key bytes and 4 children			  64 bytes
+*	node16		16 sorted key bytes (SSE2 search) and 16 children	 168 bytes
+*	node48		a 256 byte index into 48 children			 664 bytes
+*	node256		256 children						2072 bytes
+*
+* A node with a single child is merged with it: the node keeps the bytes
+* they share as a compressed path, the first 8 in the node, the others are
+* read in any key below it. A key that is a prefix of another one (strings)
+* ends at an inner node, in its "end" slot.
+*
+* Keys are ordered byte by byte, as unsigned chars: the numeric order for
+* integers (stored big-endian, the sign bit flipped) and the order of
+* std::string::compare. The leaves are also linked in that order, so the
+* iterators are the ones of a list: ++ and -- are O(1), erase only
+* invalidates the erased element. prefix_range() gives the elements whose
+* key starts with given bytes.
+*/
+
+namespace ft {
+
+/* the bytes of an integer key, in the order of its values */
+template <typename T>
+struct radix_integer_key
+{
+	unsigned char	bytes[sizeof(T)];
+
+	explicit radix_integer_key(T key)
+	{
+		unsigned long long value = static_cast<unsigned long long>(key);
+
+		if (static_cast<T>(-1) < static_cast<T>(0))
+			value ^= 1ULL << (sizeof(T) * 8 - 1);
+		for (std::size_t i = sizeof(T); i-- > 0; value >>= 8)
+			bytes[i] = static_cast<unsigned char>(value & 0xff);
+	}
+
+	const unsigned char* data() const { return bytes; }
+	std::size_t size() const { return sizeof(T); }
+};
+
+/* radix_key<Key>(key).data() / size(): the bytes ft::radix_map reads */
+template <typename Key>
+struct radix_key;
+
+template <>
+struct radix_key<char> : radix_integer_key<char> { explicit radix_key(char key) : radix_integer_key<char>(key) {} };
+
+template <>
+struct radix_key<signed char> : radix_integer_key<signed char> { explicit radix_key(signed char key) : radix_integer_key<signed char>(key) {} };
+
+template <>
+struct radix_key<unsigned char> : radix_integer_key<unsigned char> { explicit radix_key(unsigned char key) : radix_integer_key<unsigned char>(key) {} };
+
+template <>
+struct radix_key<short> : radix_integer_key<short> { explicit radix_key(short key) : radix_integer_key<short>(key) {} };
+
+template <>
+struct radix_key<unsigned short> : radix_integer_key<unsigned short> { explicit radix_key(unsigned short key) : radix_integer_key<unsigned short>(key) {} };
+
+template <>
+struct radix_key<int> : radix_integer_key<int> { explicit radix_key(int key) : radix_integer_key<int>(key) {} };
+
+template <>
+struct radix_key<unsigned int> : radix_integer_key<unsigned int> { explicit radix_key(unsigned int key) : radix_integer_key<unsigned int>(key) {} };
+
+template <>
+struct radix_key<long> : radix_integer_key<long> { explicit radix_key(long key) : radix_integer_key<long>(key) {} };
+
+template <>
+struct radix_key<unsigned long> : radix_integer_key<unsigned long> { explicit radix_key(unsigned long key) : radix_integer_key<unsigned long>(key) {} };
+
+template <>
+struct radix_key<long long> : radix_integer_key<long long> { explicit radix_key(long long key) : radix_integer_key<long long>(key) {} };
+
+template <>
+struct radix_key<unsigned long long> : radix_integer_key<unsigned long long>
+{
+	explicit radix_key(unsigned long long key) : radix_integer_key<unsigned long long>(key) {}
+};
+
+/* the characters themselves, no copy */
+template <>
+struct radix_key<std::string>
+{
+	const std::string&	key;
+
+	explicit radix_key(const std::string& k) : key(k) {}
+
+	const unsigned char* data() const { return reinterpret_cast<const unsigned char*>(key.data()); }
+	std::size_t size() const { return key.size(); }
+};
+
+/* links of the leaves, in key order; the map holds the header */
+struct radix_link
+{
+	radix_link*	prev;
+	radix_link*	next;
+};
+
+template <typename Value>
+struct radix_leaf : public radix_link
+{
+	Value		value;
+};
+
+/*
+* Inner nodes, independent of the values. A child is an inner node or a
+* leaf, a leaf pointer having its lowest bit set.
+*/
+struct radix_node
+{
+	enum { node4, node16, node48, node256 };
+	enum { max_prefix = 8 };
+
+	unsigned char	type;
+	unsigned short	count;					/* children, end not included */
+	unsigned int	prefix_len;				/* bytes of the compressed path */
+	unsigned char	prefix[max_prefix];		/* its first bytes */
+	radix_node*		end;					/* the key ending here, a leaf */
+};
+
+struct radix_node4 : public radix_node
+{
+	unsigned char	keys[4];
+	radix_node*		children[4];
+};
+
+struct radix_node16 : public radix_node
+{
+	unsigned char	keys[16];
+	radix_node*		children[16];
+};
+
+struct radix_node48 : public radix_node
+{
+	unsigned char	index[256];				/* slot + 1, 0 when no child */
+	radix_node*		children[48];
+};
+
+struct radix_node256 : public radix_node
+{
+	radix_node*		children[256];
+};
+
+/* Value is the map's value_type or its const version */
+template <typename Value, typename Leaf>
+class radix_map_iterator
+{
+	public:
+		typedef Value									value_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef std::bidirectional_iterator_tag			iterator_category;
+		typedef Value*									pointer;
+		typedef Value&									reference;
+
+	private:
+		radix_link*										_link;
+
+	public:
+		radix_map_iterator() : _link(NULL) {}
+
+		explicit radix_map_iterator(radix_link* link) : _link(link) {}
+
+		template <typename V>
+		radix_map_iterator(const radix_map_iterator<V, Leaf>& other) : _link(other.base()) {}
+
+		radix_link* base() const { return _link; }
+
+		reference operator*() const { return static_cast<Leaf*>(_link)->value; }
+		pointer operator->() const { return &static_cast<Leaf*>(_link)->value; }
+
+		radix_map_iterator& operator++()
+		{
+			_link = _link->next;
+			return *this;
+		}
+
+		radix_map_iterator operator++(int)
+		{
+			radix_map_iterator tmp(*this);
+			_link = _link->next;
+			return tmp;
+		}
+
+		radix_map_iterator& operator--()
+		{
+			_link = _link->prev;
+			return *this;
+		}
+
+		radix_map_iterator operator--(int)
+		{
+			radix_map_iterator tmp(*this);
+			_link = _link->prev;
+			return tmp;
+		}
+
+		template <typename V>
+		bool operator==(const radix_map_iterator<V, Leaf>& x) const { return _link == x.base(); }
+
+		template <typename V>
+		bool operator!=(const radix_map_iterator<V, Leaf>& x) const { return _link != x.base(); }
+};
+
+template<typename Key, typename T, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+class radix_map {
+
+	/*MEMBER TYPES*/
+	public:
+		typedef Key																key_type;
+		typedef T																mapped_type;
+		typedef std::less<Key>													key_compare;
+		typedef Allocator 														allocator_type;
+
+		typedef ft::pair<const key_type, mapped_type>							value_type;
+		typedef std::ptrdiff_t 													difference_type;
+		typedef std::size_t 													size_type;
+
+		typedef value_type& 													reference;
+		typedef const value_type& 												const_reference;
+		typedef typename Allocator::pointer										pointer;
+		typedef typename Allocator::const_pointer								const_pointer;
+
+	private:
+		typedef radix_leaf<value_type>											leaf;
+		typedef radix_node*														child;
+		typedef radix_key<Key>													key_bytes;
+
+	public:
+		typedef radix_map_iterator<value_type, leaf>							iterator;
+		typedef radix_map_iterator<const value_type, leaf>						const_iterator;
+
+		typedef ft::reverse_iterator<iterator>									reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> 							const_reverse_iterator;
+
+	private:
+		typedef typename Allocator::template rebind<leaf>::other				leaf_alloc;
+
+		/* what a bound() looks for */
+		enum bound_mode
+		{
+			not_less,		/* the first key >= the bytes */
+			greater,		/* the first key > the bytes */
+			past_prefix		/* the first key > the bytes and not starting with them */
+		};
+
+	public:
+		/* -- CONSTRUCTORS - DESTUCTORS -- */
+
+		/**
+		*  @brief  Creates an empty %radix_map, without allocating.
+		*/
+		explicit radix_map(const allocator_type& alloc = allocator_type()):
+			_root(NULL),
+			_size(0),
+			_node_bytes(0),
+			_alloc(alloc),
+			_leaf_alloc(alloc)
+		{
+			reset_header();
+		}
+
+		template<typename InputIt>
+		radix_map(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()):
+			_root(NULL),
+			_size(0),
+			_node_bytes(0),
+			_alloc(alloc),
+			_leaf_alloc(alloc)
+		{
+			reset_header();
+			insert(first, last);
+		}
+
+		radix_map(const radix_map& other):
+			_root(NULL),
+			_size(0),
+			_node_bytes(0),
+			_alloc(other._alloc),
+			_leaf_alloc(other._leaf_alloc)
+		{
+			reset_header();
+			insert(other.begin(), other.end());
+		}
+
+		~radix_map()
+		{
+			clear();
+		}
+
+		radix_map& operator=(const radix_map& other)
+		{
+			radix_map temp(other);
+			swap(temp);
+			return *this;
+		}
+
+		allocator_type get_allocator() const { return _alloc; }
+
+	/* ---------- ITERATORS --------------------------------------------------------- */
+		iterator begin() { return iterator(_header.next); }
+		const_iterator begin() const { return const_iterator(_header.next); }
+
+		iterator end() { return iterator(header()); }
+		const_iterator end() const { return const_iterator(header()); }
+
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	/*
+	* ---------- CAPACITY --------------------------------------------------------- *
+	*/
+		bool empty() const { return _size == 0; }
+
+		size_type size() const { return _size; }
+
+		size_type max_size() const { return _leaf_alloc.max_size(); }
+
+	/*
+	* ---------- ELEMENT ACCESS ----------------------------------------------------- *
+	*/
+		mapped_type& at(const key_type& key)
+		{
+			leaf* found = search(key);
+			if (!found)
+				throw std::out_of_range("radix_map::at:  key not found");
+			return found->value.second;
+		}
+
+		const mapped_type& at(const key_type& key) const
+		{
+			leaf* found = search(key);
+			if (!found)
+				throw std::out_of_range("radix_map::at:  key not found");
+			return found->value.second;
+		}
+
+		mapped_type& operator[](const key_type& key)
+		{
+			leaf* found = search(key);
+			if (found)
+				return found->value.second;
+			return insert(value_type(key, mapped_type())).first->second;
+		}
+
+	/*
+	* --------------- MODIFIERS ------------------------------------------------------ *
+	*/
+		void clear()
+		{
+			destroy(_root);
+			_root = NULL;
+			_size = 0;
+			reset_header();
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value)
+		{
+			bool inserted = false;
+			leaf* l = insert_leaf(value, inserted);
+			return ft::make_pair(iterator(l), inserted);
+		}
+
+		/* the hint is not used */
+		iterator insert(iterator, const value_type& value)
+		{
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last)
+		{
+			for(; first != last; ++first)
+				insert(*first);
+		}
+
+		void erase(iterator pos)
+		{
+			key_bytes k(static_cast<leaf*>(pos.base())->value.first);
+			erase_in(_root, k.data(), k.size(), 0);
+		}
+
+		void erase(iterator first, iterator last)
+		{
+			while (first != last)
+				erase(first++);
+		}
+
+		size_type erase(const key_type& key)
+		{
+			key_bytes k(key);
+			return erase_in(_root, k.data(), k.size(), 0);
+		}
+
+		void swap(radix_map& other)
+		{
+			std::swap(_header, other._header);
+			std::swap(_size, other._size);
+			fix_header();
+			other.fix_header();
+			std::swap(_root, other._root);
+			std::swap(_node_bytes, other._node_bytes);
+			std::swap(_alloc, other._alloc);
+			std::swap(_leaf_alloc, other._leaf_alloc);
+		}
+
+	/*
+	* --------------- LOOK-UP --------------------------------------------------- *
+	*/
+		size_type count(const key_type& key) const { return search(key) != NULL; }
+
+		iterator find(const key_type& key) { return make_iterator(search(key)); }
+		const_iterator find(const key_type& key) const { return const_iterator(make_iterator(search(key))); }
+
+		iterator lower_bound(const key_type& key) { return make_iterator(bound(key, not_less)); }
+		const_iterator lower_bound(const key_type& key) const { return const_iterator(make_iterator(bound(key, not_less))); }
+
+		iterator upper_bound(const key_type& key) { return make_iterator(bound(key, greater)); }
+		const_iterator upper_bound(const key_type& key) const { return const_iterator(make_iterator(bound(key, greater))); }
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key)
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+		/**
+		*  @brief  The elements whose key starts with the first bytes of @a prefix.
+		*  @param  prefix  A key, whose bytes are those of radix_key<Key>.
+		*  @param  length  Number of its bytes to match, at most all of them.
+		*
+		*  For std::string keys, the keys starting with the first @a length
+		*  characters; for integers, the keys sharing the @a length most
+		*  significant bytes. Two descents: O(key length).
+		*/
+		ft::pair<iterator, iterator> prefix_range(const key_type& prefix, size_type length)
+		{
+			key_bytes k(prefix);
+			length = std::min(length, k.size());
+			return ft::make_pair(make_iterator(bound_in(_root, k.data(), length, 0, not_less)),
+				make_iterator(bound_in(_root, k.data(), length, 0, past_prefix)));
+		}
+
+		ft::pair<const_iterator, const_iterator> prefix_range(const key_type& prefix, size_type length) const
+		{
+			return const_cast<radix_map*>(this)->prefix_range(prefix, length);
+		}
+
+		/* the elements whose key starts with all of @a prefix */
+		ft::pair<iterator, iterator> prefix_range(const key_type& prefix)
+		{
+			return prefix_range(prefix, key_bytes(prefix).size());
+		}
+
+		ft::pair<const_iterator, const_iterator> prefix_range(const key_type& prefix) const
+		{
+			return const_cast<radix_map*>(this)->prefix_range(prefix);
+		}
+
+	/*
+	* --------------- OBSERVERS -------------------------------------------------- *
+	*/
+		key_compare key_comp() const { return key_compare(); }
+
+	/*
+	* --------------- INTROSPECTION ---------------------------------------------- *
+	*/
+		/* Bytes owned by the map: the object itself, its inner nodes and leaves. */
+		size_type memory_usage() const
+		{
+			return sizeof(*this) + _node_bytes + _size * sizeof(leaf);
+		}
+
+	private:
+		radix_link		_header;	// end(): next -> first leaf, prev -> last leaf
+		child			_root;
+		size_type		_size;
+		size_type		_node_bytes;// inner nodes
+		allocator_type	_alloc;
+		leaf_alloc		_leaf_alloc;
+
+		radix_link* header() const { return const_cast<radix_link*>(&_header); }
+
+		void reset_header()
+		{
+			_header.prev = header();
+			_header.next = header();
+		}
+
+		/* after the header and the size were taken from another map */
+		void fix_header()
+		{
+			if (_size == 0)
+				reset_header();
+			else
+			{
+				_header.next->prev = header();
+				_header.prev->next = header();
+			}
+		}
+
+		iterator make_iterator(leaf* l) const
+		{
+			return iterator(l ? static_cast<radix_link*>(l) : header());
+		}
+
+		static bool is_leaf(child c) { return reinterpret_cast<uintptr_t>(c) & 1; }
+		static leaf* as_leaf(child c) { return reinterpret_cast<leaf*>(reinterpret_cast<uintptr_t>(c) & ~static_cast<uintptr_t>(1)); }
+		static child tag(leaf* l) { return reinterpret_cast<child>(reinterpret_cast<uintptr_t>(l) | 1); }
+
+		/* byte-wise comparison of a leaf's key with k, as memcmp then length */
+		static int compare(leaf* l, const unsigned char* k, size_type len)
+		{
+			key_bytes own(l->value.first);
+			size_type common = std::min(own.size(), len);
+			int cmp = common ? std::memcmp(own.data(), k, common) : 0;
+
+			if (cmp)
+				return cmp;
+			return own.size() < len ? -1 : own.size() > len ? 1 : 0;
+		}
+
+		static bool starts_with(leaf* l, const unsigned char* k, size_type len)
+		{
+			key_bytes own(l->value.first);
+			return own.size() >= len && (len == 0 || std::memcmp(own.data(), k, len) == 0);
+		}
+
+	/* ---------- nodes ---------- */
+
+		template <typename Node>
+		Node* new_node(unsigned char type)
+		{
+			typename Allocator::template rebind<Node>::other alloc(_alloc);
+			Node* node = alloc.allocate(1);
+
+			std::memset(static_cast<void*>(node), 0, sizeof(Node));
+			node->type = type;
+			_node_bytes += sizeof(Node);
+			return node;
+		}
+
+		template <typename Node>
+		void delete_node(radix_node* node)
+		{
+			typename Allocator::template rebind<Node>::other alloc(_alloc);
+			alloc.deallocate(static_cast<Node*>(node), 1);
+			_node_bytes -= sizeof(Node);
+		}
+
+		void free_node(radix_node* node)
+		{
+			switch (node->type)
+			{
+				case radix_node::node4:		delete_node<radix_node4>(node); break;
+				case radix_node::node16:	delete_node<radix_node16>(node); break;
+				case radix_node::node48:	delete_node<radix_node48>(node); break;
+				default:					delete_node<radix_node256>(node); break;
+			}
+		}
+
+		leaf* new_leaf(const value_type& value)
+		{
+			leaf* l = _leaf_alloc.allocate(1);
+			try
+			{
+				_alloc.construct(&l->value, value);
+			}
+			catch (...)
+			{
+				_leaf_alloc.deallocate(l, 1);
+				throw;
+			}
+			return l;
+		}
+
+		void free_leaf(leaf* l)
+		{
+			_alloc.destroy(&l->value);
+			_leaf_alloc.deallocate(l, 1);
+		}
+
+		static void copy_header(radix_node* to, const radix_node* from)
+		{
+			to->count = from->count;
+			to->prefix_len = from->prefix_len;
+			std::memcpy(to->prefix, from->prefix, radix_node::max_prefix);
+			to->end = from->end;
+		}
+
+		static void set_prefix(radix_node* node, const unsigned char* bytes, size_type len)
+		{
+			node->prefix_len = static_cast<unsigned int>(len);
+			std::memmove(node->prefix, bytes, std::min(len, static_cast<size_type>(radix_node::max_prefix)));
+		}
+
+		static int lowest_bit(unsigned mask)
+		{
+#if defined(__GNUC__)
+			return __builtin_ctz(mask);
+#else
+			int i = 0;
+			while (!(mask & 1u))
+			{
+				mask >>= 1;
+				++i;
+			}
+			return i;
+#endif
+		}
+
+		/* the slot of the child for byte b, or NULL */
+		static child* find_child(radix_node* node, unsigned char b)
+		{
+			switch (node->type)
+			{
+				case radix_node::node4:
+				{
+					radix_node4* n = static_cast<radix_node4*>(node);
+					for (int i = 0; i < n->count; ++i)
+						if (n->keys[i] == b)
+							return &n->children[i];
+					return NULL;
+				}
+				case radix_node::node16:
+				{
+					radix_node16* n = static_cast<radix_node16*>(node);
+#if defined(__SSE2__)
+					__m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys));
+					unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(b)), keys)));
+					mask &= (1u << n->count) - 1;
+					return mask ? &n->children[lowest_bit(mask)] : NULL;
+#else
+					for (int i = 0; i < n->count; ++i)
+						if (n->keys[i] == b)
+							return &n->children[i];
+					return NULL;
+#endif
+				}
+				case radix_node::node48:
+				{
+					radix_node48* n = static_cast<radix_node48*>(node);
+					return n->index[b] ? &n->children[n->index[b] - 1] : NULL;
+				}
+				default:
+				{
+					radix_node256* n = static_cast<radix_node256*>(node);
+					return n->children[b] ? &n->children[b] : NULL;
+				}
+			}
+		}
+
+		/* the child with the smallest byte greater than after (-1: the first) */
+		static child next_child(radix_node* node, int after)
+		{
+			switch (node->type)
+			{
+				case radix_node::node4:
+				{
+					radix_node4* n = static_cast<radix_node4*>(node);
+					for (int i = 0; i < n->count; ++i)
+						if (n->keys[i] > after)
+							return n->children[i];
+					return NULL;
+				}
+				case radix_node::node16:
+				{
+					radix_node16* n = static_cast<radix_node16*>(node);
+					for (int i = 0; i < n->count; ++i)
+						if (n->keys[i] > after)
+							return n->children[i];
+					return NULL;
+				}
+				case radix_node::node48:
+				{
+					radix_node48* n = static_cast<radix_node48*>(node);
+					for (int b = after + 1; b < 256; ++b)
+						if (n->index[b])
+							return n->children[n->index[b] - 1];
+					return NULL;
+				}
+				default:
+				{
+					radix_node256* n = static_cast<radix_node256*>(node);
+					for (int b = after + 1; b < 256; ++b)
+						if (n->children[b])
+							return n->children[b];
+					return NULL;
+				}
+			}
+		}
+
+		/* the leaf of the smallest key below c */
+		static leaf* minimum(child c)
+		{
+			while (!is_leaf(c))
+				c = c->end ? c->end : next_child(c, -1);
+			return as_leaf(c);
+		}
+
+		/* adds the child for byte b to the node at ref, which grows if full */
+		void add_child(child& ref, unsigned char b, child c)
+		{
+			radix_node* node = ref;
+
+			switch (node->type)
+			{
+				case radix_node::node4:
+				{
+					radix_node4* n = static_cast<radix_node4*>(node);
+					if (n->count == 4)
+					{
+						radix_node16* grown = new_node<radix_node16>(radix_node::node16);
+						copy_header(grown, n);
+						std::memcpy(grown->keys, n->keys, 4);
+						std::memcpy(grown->children, n->children, 4 * sizeof(child));
+						free_node(n);
+						ref = grown;
+						add_child(ref, b, c);
+						return;
+					}
+					insert_sorted(n->keys, n->children, n->count, b, c);
+					break;
+				}
+				case radix_node::node16:
+				{
+					radix_node16* n = static_cast<radix_node16*>(node);
+					if (n->count == 16)
+					{
+						radix_node48* grown = new_node<radix_node48>(radix_node::node48);
+						copy_header(grown, n);
+						for (int i = 0; i < 16; ++i)
+						{
+							grown->children[i] = n->children[i];
+							grown->index[n->keys[i]] = static_cast<unsigned char>(i + 1);
+						}
+						free_node(n);
+						ref = grown;
+						add_child(ref, b, c);
+						return;
+					}
+					insert_sorted(n->keys, n->children, n->count, b, c);
+					break;
+				}
+				case radix_node::node48:
+				{
+					radix_node48* n = static_cast<radix_node48*>(node);
+					if (n->count == 48)
+					{
+						radix_node256* grown = new_node<radix_node256>(radix_node::node256);
+						copy_header(grown, n);
+						for (int i = 0; i < 256; ++i)
+							if (n->index[i])
+								grown->children[i] = n->children[n->index[i] - 1];
+						free_node(n);
+						ref = grown;
+						add_child(ref, b, c);
+						return;
+					}
+					int slot = 0;
+					while (n->children[slot])
+						++slot;
+					n->children[slot] = c;
+					n->index[b] = static_cast<unsigned char>(slot + 1);
+					break;
+				}
+				default:
+					static_cast<radix_node256*>(node)->children[b] = c;
+					break;
+			}
+			node->count++;
+		}
+
+		static void insert_sorted(unsigned char* keys, child* children, int count, unsigned char b, child c)
+		{
+			int i = count;
+			for (; i > 0 && keys[i - 1] > b; --i)
+			{
+				keys[i] = keys[i - 1];
+				children[i] = children[i - 1];
+			}
+			keys[i] = b;
+			children[i] = c;
+		}
+
+		static void remove_sorted(unsigned char* keys, child* children, int count, unsigned char b)
+		{
+			int i = 0;
+			while (keys[i] != b)
+				++i;
+			for (; i + 1 < count; ++i)
+			{
+				keys[i] = keys[i + 1];
+				children[i] = children[i + 1];
+			}
+		}
+
+		/* removes the child for byte b of the node at ref, which shrinks */
+		void remove_child(child& ref, unsigned char b)
+		{
+			radix_node* node = ref;
+
+			switch (node->type)
+			{
+				case radix_node::node4:
+				{
+					radix_node4* n = static_cast<radix_node4*>(node);
+					remove_sorted(n->keys, n->children, n->count, b);
+					n->count--;
+					collapse(ref);
+					return;
+				}
+				case radix_node::node16:
+				{
+					radix_node16* n = static_cast<radix_node16*>(node);
+					remove_sorted(n->keys, n->children, n->count, b);
+					if (--n->count == 3)
+					{
+						radix_node4* shrunk = new_node<radix_node4>(radix_node::node4);
+						copy_header(shrunk, n);
+						std::memcpy(shrunk->keys, n->keys, 3);
+						std::memcpy(shrunk->children, n->children, 3 * sizeof(child));
+						free_node(n);
+						ref = shrunk;
+					}
+					return;
+				}
+				case radix_node::node48:
+				{
+					radix_node48* n = static_cast<radix_node48*>(node);
+					n->children[n->index[b] - 1] = NULL;
+					n->index[b] = 0;
+					if (--n->count == 12)
+					{
+						radix_node16* shrunk = new_node<radix_node16>(radix_node::node16);
+						copy_header(shrunk, n);
+						int j = 0;
+						for (int i = 0; i < 256; ++i)
+						{
+							if (n->index[i])
+							{
+								shrunk->keys[j] = static_cast<unsigned char>(i);
+								shrunk->children[j++] = n->children[n->index[i] - 1];
+							}
+						}
+						free_node(n);
+						ref = shrunk;
+					}
+					return;
+				}
+				default:
+				{
+					radix_node256* n = static_cast<radix_node256*>(node);
+					n->children[b] = NULL;
+					if (--n->count == 37)
+					{
+						radix_node48* shrunk = new_node<radix_node48>(radix_node::node48);
+						copy_header(shrunk, n);
+						int slot = 0;
+						for (int i = 0; i < 256; ++i)
+						{
+							if (n->children[i])
+							{
+								shrunk->children[slot] = n->children[i];
+								shrunk->index[i] = static_cast<unsigned char>(++slot);
+							}
+						}
+						free_node(n);
+						ref = shrunk;
+					}
+					return;
+				}
+			}
+		}
+
+		/* a node4 left with a single way down is replaced by it: a lone
+		* end leaf, or its only child with the compressed paths joined */
+		void collapse(child& ref)
+		{
+			radix_node4* n = static_cast<radix_node4*>(ref);
+
+			if (n->type != radix_node::node4)
+				return;
+			if (n->count == 0)
+			{
+				ref = n->end;
+				free_node(n);
+			}
+			else if (n->count == 1 && !n->end)
+			{
+				child only = n->children[0];
+				if (!is_leaf(only))
+				{
+					unsigned char joined[radix_node::max_prefix];
+					size_type len = std::min(static_cast<size_type>(n->prefix_len), static_cast<size_type>(radix_node::max_prefix));
+					std::memcpy(joined, n->prefix, len);
+					if (len < radix_node::max_prefix)
+						joined[len++] = n->keys[0];
+					size_type rest = std::min(static_cast<size_type>(only->prefix_len), radix_node::max_prefix - len);
+					std::memcpy(joined + len, only->prefix, rest);
+					only->prefix_len += n->prefix_len + 1;
+					std::memcpy(only->prefix, joined, radix_node::max_prefix);
+				}
+				ref = only;
+				free_node(n);
+			}
+		}
+
+		void destroy(child c)
+		{
+			if (!c)
+				return;
+			if (is_leaf(c))
+			{
+				free_leaf(as_leaf(c));
+				return;
+			}
+			destroy(c->end);
+			destroy_children(c);
+			free_node(c);
+		}
+
+		void destroy_children(radix_node* node)
+		{
+			switch (node->type)
+			{
+				case radix_node::node4:
+					for (int i = 0; i < node->count; ++i)
+						destroy(static_cast<radix_node4*>(node)->children[i]);
+					break;
+				case radix_node::node16:
+					for (int i = 0; i < node->count; ++i)
+						destroy(static_cast<radix_node16*>(node)->children[i]);
+					break;
+				case radix_node::node48:
+					for (int i = 0; i < 48; ++i)
+						destroy(static_cast<radix_node48*>(node)->children[i]);
+					break;
+				default:
+					for (int i = 0; i < 256; ++i)
+						destroy(static_cast<radix_node256*>(node)->children[i]);
+					break;
+			}
+		}
+
+	/* ---------- operations ---------- */
+
+		leaf* search(const key_type& key) const
+		{
+			key_bytes k(key);
+			const unsigned char* bytes = k.data();
+			size_type len = k.size();
+			size_type depth = 0;
+			child c = _root;
+
+			while (c && !is_leaf(c))
+			{
+				/* only the stored bytes of a long path are checked here,
+				* the leaf is compared in full */
+				if (c->prefix_len)
+				{
+					if (len - depth < c->prefix_len)
+						return NULL;
+					size_type stored = std::min(static_cast<size_type>(c->prefix_len), static_cast<size_type>(radix_node::max_prefix));
+					if (std::memcmp(c->prefix, bytes + depth, stored) != 0)
+						return NULL;
+					depth += c->prefix_len;
+				}
+				if (depth == len)
+				{
+					c = c->end;
+					break;
+				}
+				child* next = find_child(c, bytes[depth++]);
+				c = next ? *next : NULL;
+			}
+			if (c && compare(as_leaf(c), bytes, len) == 0)
+				return as_leaf(c);
+			return NULL;
+		}
+
+		/* the position of the first byte where the node's path and the key
+		* differ, the path length if they do not */
+		size_type prefix_mismatch(radix_node* node, const unsigned char* bytes, size_type len, size_type depth) const
+		{
+			size_type limit = std::min(static_cast<size_type>(node->prefix_len), len - depth);
+			size_type i = 0;
+
+			if (node->prefix_len <= radix_node::max_prefix)
+			{
+				while (i < limit && node->prefix[i] == bytes[depth + i])
+					++i;
+				return i;
+			}
+			key_bytes full(minimum(node)->value.first);
+			while (i < limit && full.data()[depth + i] == bytes[depth + i])
+				++i;
+			return i;
+		}
+
+		/* links l in the list before the first greater key */
+		void link_leaf(leaf* l, const unsigned char* bytes, size_type len)
+		{
+			leaf* next_leaf = bound_in(_root, bytes, len, 0, greater);
+			radix_link* next = next_leaf ? static_cast<radix_link*>(next_leaf) : header();
+
+			l->next = next;
+			l->prev = next->prev;
+			next->prev->next = l;
+			next->prev = l;
+			_size++;
+		}
+
+		/* a leaf for key placed in node at byte position depth */
+		void place(child& node, leaf* l, const unsigned char* bytes, size_type len, size_type depth)
+		{
+			if (depth == len)
+				node->end = tag(l);
+			else
+				add_child(node, bytes[depth], tag(l));
+		}
+
+		leaf* insert_leaf(const value_type& value, bool& inserted)
+		{
+			key_bytes k(value.first);
+			const unsigned char* bytes = k.data();
+			size_type len = k.size();
+			size_type depth = 0;
+			child* ref = &_root;
+
+			for (;;)
+			{
+				child c = *ref;
+				if (!c)
+				{
+					leaf* l = new_leaf(value);
+					*ref = tag(l);
+					return linked(l, bytes, len, inserted);
+				}
+				if (is_leaf(c))
+				{
+					leaf* old = as_leaf(c);
+					key_bytes old_key(old->value.first);
+					if (compare(old, bytes, len) == 0)
+						return old;
+					size_type limit = std::min(old_key.size(), len);
+					size_type common = depth;
+					while (common < limit && old_key.data()[common] == bytes[common])
+						++common;
+					leaf* l = new_leaf(value);
+					child split;
+					try
+					{
+						split = new_node<radix_node4>(radix_node::node4);
+					}
+					catch (...)
+					{
+						free_leaf(l);
+						throw;
+					}
+					set_prefix(split, bytes + depth, common - depth);
+					place(split, old, old_key.data(), old_key.size(), common);
+					place(split, l, bytes, len, common);
+					*ref = split;
+					return linked(l, bytes, len, inserted);
+				}
+				if (c->prefix_len)
+				{
+					size_type mismatch = prefix_mismatch(c, bytes, len, depth);
+					if (mismatch < c->prefix_len)
+					{
+						leaf* l = new_leaf(value);
+						try
+						{
+							split_path(*ref, mismatch, depth);
+						}
+						catch (...)
+						{
+							free_leaf(l);
+							throw;
+						}
+						place(*ref, l, bytes, len, depth + mismatch);
+						return linked(l, bytes, len, inserted);
+					}
+					depth += c->prefix_len;
+				}
+				if (depth == len)
+				{
+					if (c->end)
+						return as_leaf(c->end);
+					leaf* l = new_leaf(value);
+					c->end = tag(l);
+					return linked(l, bytes, len, inserted);
+				}
+				child* next = find_child(c, bytes[depth]);
+				if (!next)
+				{
+					leaf* l = new_leaf(value);
+					place_new(*ref, l, bytes, len, depth);
+					return linked(l, bytes, len, inserted);
+				}
+				ref = next;
+				++depth;
+			}
+		}
+
+		leaf* linked(leaf* l, const unsigned char* bytes, size_type len, bool& inserted)
+		{
+			link_leaf(l, bytes, len);
+			inserted = true;
+			return l;
+		}
+
+		/* place() of a new leaf: if the node cannot grow, the leaf is freed */
+		void place_new(child& node, leaf* l, const unsigned char* bytes, size_type len, size_type depth)
+		{
+			try
+			{
+				place(node, l, bytes, len, depth);
+			}
+			catch (...)
+			{
+				free_leaf(l);
+				throw;
+			}
+		}
+
+		/* cuts the path of the node at ref after mismatch bytes: a node4
+		* takes the first part and the node, with the rest, as its child */
+		void split_path(child& ref, size_type mismatch, size_type depth)
+		{
+			radix_node* node = ref;
+			radix_node4* parent = new_node<radix_node4>(radix_node::node4);
+			size_type keep = node->prefix_len - mismatch - 1;
+			unsigned char stored[radix_node::max_prefix];
+			const unsigned char* path = stored;
+			key_bytes full(minimum(node)->value.first);
+
+			/* a long path is read in a key below the node */
+			if (node->prefix_len <= radix_node::max_prefix)
+				std::memcpy(stored, node->prefix, radix_node::max_prefix);
+			else
+				path = full.data() + depth;
+			set_prefix(parent, path, mismatch);
+			parent->keys[0] = path[mismatch];
+			parent->children[0] = node;
+			parent->count = 1;
+			set_prefix(node, path + mismatch + 1, keep);
+			ref = parent;
+		}
+
+		size_type erase_in(child& ref, const unsigned char* bytes, size_type len, size_type depth)
+		{
+			child c = ref;
+
+			if (!c)
+				return 0;
+			if (is_leaf(c))
+			{
+				if (compare(as_leaf(c), bytes, len) != 0)
+					return 0;
+				unlink(as_leaf(c));
+				ref = NULL;
+				return 1;
+			}
+			if (c->prefix_len)
+			{
+				if (len - depth < c->prefix_len)
+					return 0;
+				size_type stored = std::min(static_cast<size_type>(c->prefix_len), static_cast<size_type>(radix_node::max_prefix));
+				if (std::memcmp(c->prefix, bytes + depth, stored) != 0)
+					return 0;
+				depth += c->prefix_len;
+			}
+			if (depth == len)
+			{
+				if (!c->end || compare(as_leaf(c->end), bytes, len) != 0)
+					return 0;
+				unlink(as_leaf(c->end));
+				c->end = NULL;
+				collapse(ref);
+				return 1;
+			}
+			unsigned char b = bytes[depth];
+			child* next = find_child(c, b);
+			if (!next)
+				return 0;
+			if (!is_leaf(*next))
+				return erase_in(*next, bytes, len, depth + 1);
+			if (compare(as_leaf(*next), bytes, len) != 0)
+				return 0;
+			/* the bytes may be those of the leaf: not read after this */
+			unlink(as_leaf(*next));
+			remove_child(ref, b);
+			return 1;
+		}
+
+		void unlink(leaf* l)
+		{
+			l->prev->next = l->next;
+			l->next->prev = l->prev;
+			free_leaf(l);
+			_size--;
+		}
+
+		leaf* bound(const key_type& key, bound_mode mode) const
+		{
+			key_bytes k(key);
+			return bound_in(_root, k.data(), k.size(), 0, mode);
+		}
+
+		/* the first leaf below c matching mode, or NULL */
+		leaf* bound_in(child c, const unsigned char* bytes, size_type len, size_type depth, bound_mode mode) const
+		{
+			if (!c)
+				return NULL;
+			if (is_leaf(c))
+			{
+				leaf* l = as_leaf(c);
+				int cmp = compare(l, bytes, len);
+				if (mode == not_less)
+					return cmp >= 0 ? l : NULL;
+				if (mode == greater)
+					return cmp > 0 ? l : NULL;
+				return cmp > 0 && !starts_with(l, bytes, len) ? l : NULL;
+			}
+			if (c->prefix_len)
+			{
+				size_type limit = std::min(static_cast<size_type>(c->prefix_len), len - depth);
+				size_type i = 0;
+				unsigned char path_byte = 0;
+				if (c->prefix_len <= radix_node::max_prefix)
+				{
+					while (i < limit && c->prefix[i] == bytes[depth + i])
+						++i;
+					path_byte = i < limit ? c->prefix[i] : 0;
+				}
+				else
+				{
+					key_bytes full(minimum(c)->value.first);
+					while (i < limit && full.data()[depth + i] == bytes[depth + i])
+						++i;
+					path_byte = i < limit ? full.data()[depth + i] : 0;
+				}
+				if (i < limit)
+					return path_byte > bytes[depth + i] ? minimum(c) : NULL;
+				/* the bytes end inside the path: every key below starts with them */
+				if (limit < c->prefix_len)
+					return mode == past_prefix ? NULL : minimum(c);
+				depth += c->prefix_len;
+			}
+			if (depth == len)
+			{
+				if (mode == not_less)
+					return minimum(c);
+				if (mode == past_prefix)
+					return NULL;
+				child first = next_child(c, -1);
+				return first ? minimum(first) : NULL;
+			}
+			/* the end leaf is a prefix of the bytes: smaller */
+			child* exact = find_child(c, bytes[depth]);
+			if (exact)
+			{
+				leaf* found = bound_in(*exact, bytes, len, depth + 1, mode);
+				if (found)
+					return found;
+			}
+			child after = next_child(c, bytes[depth]);
+			return after ? minimum(after) : NULL;
+		}
+};
+
+/*----------------------------- NON-MEMBER FUNCTIONS ---------------------------------------*/
+template<class Key, class T, class Alloc>
+void swap(ft::radix_map<Key, T, Alloc>& lhs, ft::radix_map<Key, T, Alloc>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+template<class Key, class T, class Alloc>
+bool operator==(const ft::radix_map<Key, T, Alloc>& x, const ft::radix_map<Key, T, Alloc>& y)
+{
+	return (x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin()));
+}
+
+template<class Key, class T, class Alloc>
+bool operator!=(const ft::radix_map<Key, T, Alloc>& x, const ft::radix_map<Key, T, Alloc>& y)
+{
+	return !(x == y);
+}
+
+template<class Key, class T, class Alloc>
+bool operator<(const ft::radix_map<Key, T, Alloc>& x, const ft::radix_map<Key, T, Alloc>& y)
+{
+	return (ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+}
+
+template<class Key, class T, class Alloc>
+bool operator<=(const ft::radix_map<Key, T, Alloc>& x, const ft::radix_map<Key, T, Alloc>& y)
+{
+	return !(y < x);
+}
+
+template<class Key, class T, class Alloc>
+bool operator>(const ft::radix_map<Key, T, Alloc>& x, const ft::radix_map<Key, T, Alloc>& y)
+{
+	return (y < x);
+}
+
+template<class Key, class T, class Alloc>
+bool operator>=(const ft::radix_map<Key, T, Alloc>& x, const ft::radix_map<Key, T, Alloc>& y)
+{
+	return !(x < y);
+}
+
+} // namespace
+
+#endif
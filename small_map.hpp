@@ -0,0 +1,707 @@
+#ifndef SMALL_MAP_HPP
+#define SMALL_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+#include "utility.hpp"
+#include "iterator.hpp"
+#include "map.hpp"
+
+/*
+* ft::small_map: the interface of ft::map for maps that are mostly small.
+*
+* Up to N elements live inside the object, in an array sorted by key and
+* searched linearly: no allocation, one or two cache lines per look-up.
+* The insertion of element N + 1 moves everything into an ft::map built in
+* the same storage, and the map stays a tree from then on, even when it
+* shrinks back: erasing never moves the elements of a tree. clear() makes it
+* an empty inline array again.
+*
+* Differences with ft::map, all coming from the inline array:
+*	- while inline, insert and erase shift the elements after the position:
+*	  iterators, pointers and references to them are invalidated, as in a
+*	  vector. erase(iterator) returns the iterator that follows the erased
+*	  element, use it instead of erase(it++);
+*	- the insertion that moves the elements to the tree invalidates them all;
+*	- swap() copies the inline elements, and invalidates their iterators.
+* Once in the tree, the ft::map rules apply.
+*/
+
+namespace ft {
+
+/* Value is the map's value_type or its const version, Tree the matching
+* ft::map iterator */
+template <typename Value, typename Tree>
+class small_map_iterator
+{
+	public:
+		typedef Value									value_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef std::bidirectional_iterator_tag			iterator_category;
+		typedef Value*									pointer;
+		typedef Value&									reference;
+
+	private:
+		pointer											_element; // NULL in tree mode
+		Tree											_node;
+
+	public:
+		small_map_iterator() : _element(NULL), _node() {}
+
+		explicit small_map_iterator(pointer element) : _element(element), _node() {}
+
+		explicit small_map_iterator(const Tree& node) : _element(NULL), _node(node) {}
+
+		template <typename V, typename T>
+		small_map_iterator(const small_map_iterator<V, T>& other) : _element(other.element()), _node(other.node()) {}
+
+		pointer element() const { return _element; }
+		const Tree& node() const { return _node; }
+
+		reference operator*() const { return _element ? *_element : *_node; }
+		pointer operator->() const { return &**this; }
+
+		small_map_iterator& operator++()
+		{
+			if (_element)
+				++_element;
+			else
+				++_node;
+			return *this;
+		}
+
+		small_map_iterator operator++(int)
+		{
+			small_map_iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		small_map_iterator& operator--()
+		{
+			if (_element)
+				--_element;
+			else
+				--_node;
+			return *this;
+		}
+
+		small_map_iterator operator--(int)
+		{
+			small_map_iterator tmp(*this);
+			--(*this);
+			return tmp;
+		}
+
+		template <typename V, typename T>
+		bool operator==(const small_map_iterator<V, T>& x) const
+		{
+			if (_element || x.element())
+				return _element == x.element();
+			return _node == x.node();
+		}
+
+		template <typename V, typename T>
+		bool operator!=(const small_map_iterator<V, T>& x) const { return !(*this == x); }
+};
+
+template<typename Key, typename T, std::size_t N = 8, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+class small_map {
+
+	/*MEMBER TYPES*/
+	public:
+		typedef Key																key_type;
+		typedef T																mapped_type;
+		typedef Compare															key_compare;
+		typedef Allocator 														allocator_type;
+
+		typedef ft::pair<const key_type, mapped_type>							value_type;
+		typedef std::ptrdiff_t 													difference_type;
+		typedef std::size_t 													size_type;
+
+		typedef value_type& 													reference;
+		typedef const value_type& 												const_reference;
+		typedef typename Allocator::pointer										pointer;
+		typedef typename Allocator::const_pointer								const_pointer;
+
+		/* the tree the elements move to beyond N */
+		typedef ft::map<Key, T, Compare, Allocator>								map_type;
+
+		typedef small_map_iterator<value_type, typename map_type::iterator>		iterator;
+		typedef small_map_iterator<const value_type, typename map_type::const_iterator>	const_iterator;
+
+		typedef ft::reverse_iterator<iterator>									reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator> 							const_reverse_iterator;
+
+		typedef typename map_type::value_compare								value_compare;
+
+		/* -- CONSTRUCTORS - DESTUCTORS -- */
+
+		/**
+		*  @brief  Creates an empty, inline %small_map.
+		*/
+		explicit small_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+			_size(0),
+			_in_tree(false),
+			_alloc(alloc),
+			_comp(comp)
+		{}
+
+		template<typename InputIt>
+		small_map(InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()):
+			_size(0),
+			_in_tree(false),
+			_alloc(alloc),
+			_comp(comp)
+		{
+			insert(first, last);
+		}
+
+		/* an inline map is copied inline, a tree into a tree */
+		small_map(const small_map& other):
+			_size(0),
+			_in_tree(false),
+			_alloc(other._alloc),
+			_comp(other._comp)
+		{
+			if (other._in_tree)
+			{
+				new (_storage.bytes) map_type(other.tree());
+				_in_tree = true;
+			}
+			else
+				copy_elements(other);
+		}
+
+		~small_map()
+		{
+			clear();
+		}
+
+		small_map& operator=(const small_map& other)
+		{
+			small_map temp(other);
+			swap(temp);
+			return *this;
+		}
+
+		allocator_type get_allocator() const { return _alloc; }
+
+	/* ---------- ITERATORS --------------------------------------------------------- */
+		iterator begin() { return _in_tree ? iterator(tree().begin()) : iterator(elements()); }
+		const_iterator begin() const { return _in_tree ? const_iterator(tree().begin()) : const_iterator(elements()); }
+
+		iterator end() { return _in_tree ? iterator(tree().end()) : iterator(elements() + _size); }
+		const_iterator end() const { return _in_tree ? const_iterator(tree().end()) : const_iterator(elements() + _size); }
+
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	/*
+	* ---------- CAPACITY --------------------------------------------------------- *
+	*/
+		bool empty() const { return size() == 0; }
+
+		size_type size() const { return _in_tree ? tree().size() : _size; }
+
+		size_type max_size() const { return _in_tree ? tree().max_size() : map_type(_comp, _alloc).max_size(); }
+
+		/* the number of elements kept inline */
+		static size_type inline_capacity() { return N; }
+
+		/* false while the elements are in the inline array */
+		bool is_tree() const { return _in_tree; }
+
+	/*
+	* ---------- ELEMENT ACCESS ----------------------------------------------------- *
+	*/
+		mapped_type& at(const key_type& key)
+		{
+			if (_in_tree)
+				return tree().at(key);
+			size_type i = lower_index(key);
+			if (!found(i, key))
+				throw std::out_of_range("small_map::at:  key not found");
+			return elements()[i].second;
+		}
+
+		/* ft::map::at const returns a copy: the tree is searched here so that
+		* the reference is to the element itself */
+		const mapped_type& at(const key_type& key) const
+		{
+			if (_in_tree)
+			{
+				typename map_type::const_iterator it = tree().find(key);
+				if (it == tree().end())
+					throw std::out_of_range("small_map::at:  key not found");
+				return it->second;
+			}
+			size_type i = lower_index(key);
+			if (!found(i, key))
+				throw std::out_of_range("small_map::at:  key not found");
+			return elements()[i].second;
+		}
+
+		mapped_type& operator[](const key_type& key)
+		{
+			if (_in_tree)
+				return tree()[key];
+			size_type i = lower_index(key);
+			if (found(i, key))
+				return elements()[i].second;
+			return insert_at(i, value_type(key, mapped_type()))->second;
+		}
+
+	/*
+	* --------------- MODIFIERS ------------------------------------------------------ *
+	*/
+		/* destroys the elements; a tree is freed and the map is inline again */
+		void clear()
+		{
+			if (_in_tree)
+			{
+				tree().~map_type();
+				_in_tree = false;
+			}
+			else
+				destroy_elements(0, _size);
+			_size = 0;
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value)
+		{
+			if (_in_tree)
+			{
+				ft::pair<typename map_type::iterator, bool> result = tree().insert(value);
+				return ft::make_pair(iterator(result.first), result.second);
+			}
+			size_type i = lower_index(value.first);
+			if (found(i, value.first))
+				return ft::make_pair(iterator(elements() + i), false);
+			return ft::make_pair(insert_at(i, value), true);
+		}
+
+		/* the hint is only used by the tree */
+		iterator insert(iterator pos, const value_type& value)
+		{
+			if (_in_tree)
+				return iterator(tree().insert(pos.node(), value));
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last)
+		{
+			for(; first != last; ++first)
+				insert(*first);
+		}
+
+		/* returns the element that followed the erased one */
+		iterator erase(iterator pos)
+		{
+			if (_in_tree)
+			{
+				typename map_type::iterator next = pos.node();
+				++next;
+				tree().erase(pos.node());
+				return iterator(next);
+			}
+			size_type i = pos.element() - elements();
+			erase_at(i);
+			return iterator(elements() + i);
+		}
+
+		void erase(iterator first, iterator last)
+		{
+			if (_in_tree)
+				tree().erase(first.node(), last.node());
+			else
+			{
+				size_type from = first.element() - elements();
+				size_type count = last.element() - first.element();
+				for (; count > 0; --count)
+					erase_at(from);
+			}
+		}
+
+		size_type erase(const key_type& key)
+		{
+			if (_in_tree)
+				return tree().erase(key);
+			size_type i = lower_index(key);
+			if (!found(i, key))
+				return 0;
+			erase_at(i);
+			return 1;
+		}
+
+		/* O(1) between two trees; an inline side is copied */
+		void swap(small_map& other)
+		{
+			if (this == &other)
+				return;
+			if (_in_tree && other._in_tree)
+				tree().swap(other.tree());
+			else if (_in_tree)
+				other.swap(*this);
+			else if (other._in_tree)
+			{
+				/* the tree leaves other's storage before the elements enter it */
+				map_type moved(_comp, _alloc);
+				moved.swap(other.tree());
+				other.tree().~map_type();
+				other._in_tree = false;
+				other._size = 0;
+				try
+				{
+					other.copy_elements(*this);
+				}
+				catch (...)
+				{
+					new (other._storage.bytes) map_type(other._comp, other._alloc);
+					other._in_tree = true;
+					other.tree().swap(moved);
+					throw;
+				}
+				destroy_elements(0, _size);
+				_size = 0;
+				new (_storage.bytes) map_type(_comp, _alloc);
+				_in_tree = true;
+				tree().swap(moved);
+			}
+			else
+			{
+				small_map temp(*this);
+				clear();
+				copy_elements(other);
+				other.clear();
+				other.copy_elements(temp);
+			}
+			std::swap(_alloc, other._alloc);
+			std::swap(_comp, other._comp);
+		}
+
+	/*
+	* --------------- LOOK-UP --------------------------------------------------- *
+	*/
+		size_type count(const key_type& key) const
+		{
+			if (_in_tree)
+				return tree().count(key);
+			return found(lower_index(key), key);
+		}
+
+		iterator find(const key_type& key)
+		{
+			if (_in_tree)
+				return iterator(tree().find(key));
+			size_type i = lower_index(key);
+			return iterator(elements() + (found(i, key) ? i : _size));
+		}
+
+		const_iterator find(const key_type& key) const
+		{
+			if (_in_tree)
+				return const_iterator(tree().find(key));
+			size_type i = lower_index(key);
+			return const_iterator(elements() + (found(i, key) ? i : _size));
+		}
+
+		iterator lower_bound(const key_type& key)
+		{
+			if (_in_tree)
+				return iterator(tree().lower_bound(key));
+			return iterator(elements() + lower_index(key));
+		}
+
+		const_iterator lower_bound(const key_type& key) const
+		{
+			if (_in_tree)
+				return const_iterator(tree().lower_bound(key));
+			return const_iterator(elements() + lower_index(key));
+		}
+
+		iterator upper_bound(const key_type& key)
+		{
+			if (_in_tree)
+				return iterator(tree().upper_bound(key));
+			return iterator(elements() + upper_index(key));
+		}
+
+		const_iterator upper_bound(const key_type& key) const
+		{
+			if (_in_tree)
+				return const_iterator(tree().upper_bound(key));
+			return const_iterator(elements() + upper_index(key));
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key)
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			return ft::make_pair(lower_bound(key), upper_bound(key));
+		}
+
+	/*
+	* --------------- OBSERVERS -------------------------------------------------- *
+	*/
+		key_compare key_comp() const { return _comp; }
+
+		value_compare value_comp() const { return map_type(_comp, _alloc).value_comp(); }
+
+	/*
+	* --------------- INTROSPECTION ---------------------------------------------- *
+	*/
+		/* Bytes owned by the map: the object, inline array included, and the
+		* nodes of the tree. */
+		size_type memory_usage() const
+		{
+			if (_in_tree)
+				return sizeof(*this) + tree().memory_usage() - sizeof(map_type);
+			return sizeof(*this);
+		}
+
+	private:
+		/* raw storage for N elements or the tree, aligned for any scalar */
+		union max_align
+		{
+			long double	ld;
+			long long	ll;
+			double		d;
+			void*		p;
+			void		(*f)();
+		};
+
+		enum
+		{
+			inline_bytes = N * sizeof(value_type),
+			storage_bytes = inline_bytes > sizeof(map_type) ? inline_bytes : sizeof(map_type)
+		};
+
+		union storage
+		{
+			char		bytes[storage_bytes];
+			max_align	align[(storage_bytes + sizeof(max_align) - 1) / sizeof(max_align)];
+		};
+
+		/* merges the inline elements and a new one, in key order, for
+		* map::assign_sorted() */
+		struct merge_generator
+		{
+			const value_type*	elements;
+			size_type			position;
+			const value_type*	inserted;
+			size_type			next;
+
+			merge_generator(const value_type* e, size_type pos, const value_type& value):
+				elements(e), position(pos), inserted(&value), next(0) {}
+
+			const value_type& operator()()
+			{
+				size_type i = next++;
+				if (i == position)
+					return *inserted;
+				return elements[i < position ? i : i - 1];
+			}
+		};
+
+		storage			_storage;
+		size_type		_size;		// inline elements, unused in tree mode
+		bool			_in_tree;
+		allocator_type	_alloc;
+		key_compare		_comp;
+
+		value_type* elements() { return reinterpret_cast<value_type*>(_storage.bytes); }
+		const value_type* elements() const { return reinterpret_cast<const value_type*>(_storage.bytes); }
+
+		map_type& tree() { return *reinterpret_cast<map_type*>(_storage.bytes); }
+		const map_type& tree() const { return *reinterpret_cast<const map_type*>(_storage.bytes); }
+
+		/* the first inline element not less than key. The array is sorted:
+		* counting the smaller elements finds it without a data-dependent
+		* branch, and the loop vectorizes for scalar keys */
+		size_type lower_index(const key_type& key) const
+		{
+			const value_type* e = elements();
+			size_type i = 0;
+
+			for (size_type j = 0; j < _size; ++j)
+				i += _comp(e[j].first, key);
+			return i;
+		}
+
+		size_type upper_index(const key_type& key) const
+		{
+			const value_type* e = elements();
+			size_type i = 0;
+
+			for (size_type j = 0; j < _size; ++j)
+				i += !_comp(key, e[j].first);
+			return i;
+		}
+
+		bool found(size_type i, const key_type& key) const
+		{
+			return i < _size && !_comp(key, elements()[i].first);
+		}
+
+		void destroy_elements(size_type from, size_type to)
+		{
+			for (size_type i = from; i < to; ++i)
+				_alloc.destroy(elements() + i);
+		}
+
+		/* this is inline and empty, other inline */
+		void copy_elements(const small_map& other)
+		{
+			for (; _size < other._size; ++_size)
+				_alloc.construct(elements() + _size, other.elements()[_size]);
+		}
+
+		/* element i moves to i + 1, the slot i is left raw. If a copy throws,
+		* the elements already moved go back down: the map is unchanged */
+		void open_slot(size_type i)
+		{
+			value_type* e = elements();
+			size_type j = _size;
+
+			try
+			{
+				for (; j > i; --j)
+				{
+					_alloc.construct(e + j, e[j - 1]);
+					_alloc.destroy(e + j - 1);
+				}
+			}
+			catch (...)
+			{
+				/* the slot j is raw, the moved elements are j + 1 .. _size */
+				close_slot(j, _size + 1);
+				throw;
+			}
+		}
+
+		/* the elements i + 1 .. end - 1 move down to the raw slot i. If a copy
+		* throws, the elements past the new raw slot are destroyed and _size
+		* ends before it: no raw slot is left in the map */
+		void close_slot(size_type i, size_type end)
+		{
+			value_type* e = elements();
+			size_type j = i;
+
+			try
+			{
+				for (; j + 1 < end; ++j)
+				{
+					_alloc.construct(e + j, e[j + 1]);
+					_alloc.destroy(e + j + 1);
+				}
+			}
+			catch (...)
+			{
+				destroy_elements(j + 1, end);
+				_size = j;
+				throw;
+			}
+		}
+
+		/* value goes at the inline position i, or everything goes to a tree */
+		iterator insert_at(size_type i, const value_type& value)
+		{
+			if (_size == N)
+				return move_to_tree(i, value);
+
+			value_type copy(value);
+			open_slot(i);
+			try
+			{
+				_alloc.construct(elements() + i, copy);
+			}
+			catch (...)
+			{
+				close_slot(i, _size + 1);
+				throw;
+			}
+			++_size;
+			return iterator(elements() + i);
+		}
+
+		void erase_at(size_type i)
+		{
+			_alloc.destroy(elements() + i);
+			close_slot(i, _size);
+			--_size;
+		}
+
+		/* the tree is built aside: if a copy throws, the map is unchanged */
+		iterator move_to_tree(size_type i, const value_type& value)
+		{
+			map_type built(_comp, _alloc);
+			merge_generator next(elements(), i, value);
+
+			built.assign_sorted(_size + 1, next);
+			destroy_elements(0, _size);
+			_size = 0;
+			new (_storage.bytes) map_type(_comp, _alloc);
+			_in_tree = true;
+			tree().swap(built);
+			return iterator(tree().find(value.first));
+		}
+};
+
+/*----------------------------- NON-MEMBER FUNCTIONS ---------------------------------------*/
+template<class Key, class T, std::size_t N, class Compare, class Alloc>
+void swap(ft::small_map<Key, T, N, Compare, Alloc>& lhs, ft::small_map<Key, T, N, Compare, Alloc>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+template<class Key, class T, std::size_t N, class Compare, class Alloc>
+bool operator==(const ft::small_map<Key, T, N, Compare, Alloc>& x, const ft::small_map<Key, T, N, Compare, Alloc>& y)
+{
+	return (x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin()));
+}
+
+template<class Key, class T, std::size_t N, class Compare, class Alloc>
+bool operator!=(const ft::small_map<Key, T, N, Compare, Alloc>& x, const ft::small_map<Key, T, N, Compare, Alloc>& y)
+{
+	return !(x == y);
+}
+
+template<class Key, class T, std::size_t N, class Compare, class Alloc>
+bool operator<(const ft::small_map<Key, T, N, Compare, Alloc>& x, const ft::small_map<Key, T, N, Compare, Alloc>& y)
+{
+	return (ft::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+}
+
+template<class Key, class T, std::size_t N, class Compare, class Alloc>
+bool operator<=(const ft::small_map<Key, T, N, Compare, Alloc>& x, const ft::small_map<Key, T, N, Compare, Alloc>& y)
+{
+	return !(y < x);
+}
+
+template<class Key, class T, std::size_t N, class Compare, class Alloc>
+bool operator>(const ft::small_map<Key, T, N, Compare, Alloc>& x, const ft::small_map<Key, T, N, Compare, Alloc>& y)
+{
+	return (y < x);
+}
+
+template<class Key, class T, std::size_t N, class Compare, class Alloc>
+bool operator>=(const ft::small_map<Key, T, N, Compare, Alloc>& x, const ft::small_map<Key, T, N, Compare, Alloc>& y)
+{
+	return !(x < y);
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <memory>
+#include <cstddef>
+
+#include "type_traits.hpp"
+#include "vector.hpp"
+
+/*
+* ft::small_vector<T, N>: an ft::vector whose first N elements live inside
+* the object. Up to N elements, no allocation at all; past N, the elements
+* move to the heap as in any vector, and stay there until shrink_to_fit()
+* finds them back under N.
+*
+* It is an ft::vector with an allocator that hands out the inline buffer
+* first (small_vector_allocator): insert, erase, growth, the growth policy,
+* normal_iterator and the comparisons are the vector's own. Constructors
+* reserve N elements, so capacity() is at least N.
+*
+* Differences with ft::vector:
+*	- swap() copies the elements when one of the two is inline, and the
+*	  iterators of inline elements are invalidated. Through a reference to
+*	  the ft::vector base, it always copies: the allocators of two
+*	  small_vectors differ by their arena.
+*/
+
+namespace ft {
+
+/* the inline buffer, and whether the vector holds it */
+template <typename T, std::size_t N>
+struct small_vector_arena
+{
+	char	storage[N * sizeof(T)] __attribute__((aligned(__alignof__(T))));
+	bool	used;
+
+	small_vector_arena() : used(false) {}
+
+	T* buffer() { return reinterpret_cast<T*>(storage); }
+	bool owns(const T* p) const { return p == reinterpret_cast<const T*>(storage); }
+
+	private:
+		/* a copy would be a second owner of the same elements */
+		small_vector_arena(const small_vector_arena&);
+		small_vector_arena& operator=(const small_vector_arena&);
+};
+
+/*
+* Allocator of small_vector: the arena's buffer for a request of at most N
+* elements while it is free, Alloc otherwise. Default constructed (no arena),
+* it is Alloc.
+*/
+template <typename T, std::size_t N, typename Alloc = std::allocator<T> >
+class small_vector_allocator
+{
+	public:
+		typedef typename Alloc::value_type			value_type;
+		typedef typename Alloc::pointer				pointer;
+		typedef typename Alloc::const_pointer		const_pointer;
+		typedef typename Alloc::reference			reference;
+		typedef typename Alloc::const_reference		const_reference;
+		typedef typename Alloc::size_type			size_type;
+		typedef typename Alloc::difference_type		difference_type;
+		typedef small_vector_arena<T, N>			arena_type;
+
+		template <typename U>
+		struct rebind
+		{
+			typedef small_vector_allocator<U, N, typename Alloc::template rebind<U>::other>	other;
+		};
+
+	private:
+		arena_type*		_arena;
+		Alloc			_alloc;
+
+		template <typename U, std::size_t M, typename A>
+		friend class small_vector_allocator;
+
+	public:
+		small_vector_allocator() : _arena(NULL), _alloc() {}
+
+		explicit small_vector_allocator(arena_type* arena, const Alloc& alloc = Alloc()) :
+			_arena(arena), _alloc(alloc) {}
+
+		small_vector_allocator(const small_vector_allocator& other) :
+			_arena(other._arena), _alloc(other._alloc) {}
+
+		/* other arenas hold other element types: heap only */
+		template <typename U, typename A>
+		small_vector_allocator(const small_vector_allocator<U, N, A>& other) :
+			_arena(NULL), _alloc(other._alloc) {}
+
+		small_vector_allocator& operator=(const small_vector_allocator& other)
+		{
+			_arena = other._arena;
+			_alloc = other._alloc;
+			return *this;
+		}
+
+		pointer address(reference x) const { return _alloc.address(x); }
+		const_pointer address(const_reference x) const { return _alloc.address(x); }
+		size_type max_size() const { return _alloc.max_size(); }
+
+		pointer allocate(size_type n, const void* = 0)
+		{
+			if (_arena && !_arena->used && n <= N)
+			{
+				_arena->used = true;
+				return _arena->buffer();
+			}
+			return _alloc.allocate(n);
+		}
+
+		void deallocate(pointer p, size_type n)
+		{
+			if (_arena && _arena->owns(p))
+				_arena->used = false;
+			else
+				_alloc.deallocate(p, n);
+		}
+
+		void construct(pointer p, const_reference value) { _alloc.construct(p, value); }
+		void destroy(pointer p) { _alloc.destroy(p); }
+
+		/* the underlying allocator */
+		const Alloc& base() const { return _alloc; }
+
+		/* a vector copied from the one of this arena, through the ft::vector
+		* base, must not borrow the arena: it would outlive the small_vector
+		* (see allocator_propagation) */
+		small_vector_allocator select_on_container_copy_construction() const
+		{
+			return small_vector_allocator(NULL, _alloc);
+		}
+
+		bool operator==(const small_vector_allocator& other) const
+		{
+			return _arena == other._arena && _alloc == other._alloc;
+		}
+
+		bool operator!=(const small_vector_allocator& other) const { return !(*this == other); }
+};
+
+/* construct and destroy are those of Alloc */
+template <typename T, std::size_t N, typename Alloc>
+struct is_plain_allocator<small_vector_allocator<T, N, Alloc> > : public is_plain_allocator<Alloc> {};
+
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>, typename Growth = growth_double>
+class small_vector :
+	private small_vector_arena<T, N>,
+	public vector<T, small_vector_allocator<T, N, Allocator>, Growth>
+{
+	private:
+		typedef small_vector_arena<T, N>									arena_type;
+		typedef vector<T, small_vector_allocator<T, N, Allocator>, Growth>	vector_type;
+
+	public:
+		typedef typename vector_type::value_type			value_type;
+		typedef typename vector_type::allocator_type		allocator_type;
+		typedef typename vector_type::size_type				size_type;
+		typedef typename vector_type::difference_type		difference_type;
+		typedef typename vector_type::reference				reference;
+		typedef typename vector_type::const_reference		const_reference;
+		typedef typename vector_type::pointer				pointer;
+		typedef typename vector_type::const_pointer			const_pointer;
+		typedef typename vector_type::iterator				iterator;
+		typedef typename vector_type::const_iterator		const_iterator;
+		typedef typename vector_type::reverse_iterator		reverse_iterator;
+		typedef typename vector_type::const_reverse_iterator	const_reverse_iterator;
+
+		static const size_type		inline_capacity = N;
+
+		small_vector() : arena_type(), vector_type(allocator_type(static_cast<arena_type*>(this)))
+		{
+			this->reserve(N);
+		}
+
+		explicit small_vector(const Allocator& alloc) :
+			arena_type(), vector_type(allocator_type(static_cast<arena_type*>(this), alloc))
+		{
+			this->reserve(N);
+		}
+
+		explicit small_vector(size_type n, const T& value = T(), const Allocator& alloc = Allocator()) :
+			arena_type(), vector_type(allocator_type(static_cast<arena_type*>(this), alloc))
+		{
+			this->reserve(N);
+			this->assign(n, value);
+		}
+
+		template <typename InputIt>
+		small_vector(InputIt first, typename enable_if<!is_integral<InputIt>::value, InputIt>::type last,
+			const Allocator& alloc = Allocator()) :
+			arena_type(), vector_type(allocator_type(static_cast<arena_type*>(this), alloc))
+		{
+			this->reserve(N);
+			this->insert(this->end(), first, last);
+		}
+
+		small_vector(const small_vector& other) :
+			arena_type(), vector_type(allocator_type(static_cast<arena_type*>(this), other.get_allocator()))
+		{
+			this->reserve(N);
+			this->insert(this->end(), other.begin(), other.end());
+		}
+
+		/* the allocator stays the one of this object's arena */
+		small_vector& operator=(const small_vector& other)
+		{
+			vector_type::operator=(other);
+			return *this;
+		}
+
+		/* Alloc, without the arena */
+		Allocator get_allocator() const
+		{
+			return vector_type::get_allocator().base();
+		}
+
+		/* true while the elements are in the inline buffer */
+		bool is_inline() const
+		{
+			return arena_type::owns(this->data());
+		}
+
+		/* never below N: the inline buffer is there anyway, and a shrink that
+		* fits in it moves the elements back inside the object */
+		void shrink_to(size_type n)
+		{
+			vector_type::shrink_to(n < N ? N : n);
+		}
+
+		void shrink_to_fit()
+		{
+			shrink_to(0);
+		}
+
+		/* the buffers can only be exchanged when both are on the heap, from
+		* equal allocators */
+		void swap(small_vector& other)
+		{
+			if (!is_inline() && !other.is_inline() && get_allocator() == other.get_allocator())
+			{
+				this->swap_storage(other);
+				return;
+			}
+			small_vector tmp(*this);
+			*this = other;
+			other = tmp;
+		}
+};
+
+template <typename T, std::size_t N, typename Allocator, typename Growth>
+inline void swap(small_vector<T, N, Allocator, Growth>& x, small_vector<T, N, Allocator, Growth>& y)
+{
+	x.swap(y);
+}
+
+} //namespace
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
+
+#include "file_io.hpp"
+#include "map.hpp"
+
+/*
+* Streaming binary snapshot of an ft::map with any key and mapped types.
+*
+* Elements go through user-supplied codecs, so nothing is required from the
+* types but what the codecs do with them:
+*
+*	encoder(ft::file_writer& out, const value_type& value)
+*	decoder(ft::file_reader& in) -> value_type
+*
+* Layout:
+*
+*	[magic "FTSNAP\0\0"][u32 version][u32 reserved][u64 count]
+*	[count encoded elements, in key order]
+*	[u64 FNV-1a checksum of the encoded elements]
+*
+* save_snapshot() streams the map in order through a file_writer; load_snapshot()
+* streams the file through a file_reader straight into map::assign_sorted(), so
+* the restore is O(n) and needs nothing but the map and the reader's buffer.
+*/
+
+namespace ft {
+
+	namespace snapshot_detail {
+
+		static const char		magic[8] = { 'F', 'T', 'S', 'N', 'A', 'P', 0, 0 };
+		static const uint32_t	version = 1;
+
+		/* adapts reader + decoder to the generator expected by map::assign_sorted() */
+		template <typename Value, typename Decoder>
+		struct decode_next
+		{
+			file_reader&	in;
+			Decoder&		decode;
+
+			decode_next(file_reader& reader, Decoder& decoder) : in(reader), decode(decoder) {}
+
+			Value operator()() { return decode(in); }
+		};
+	}
+
+	/**
+	*  @brief  Writes the elements of @a m to @a out through @a encode.
+	*
+	*  Lower level than save_snapshot(): lets a caller embed a snapshot in a
+	*  file of its own. @a out's checksum is reset on entry.
+	*/
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Encoder>
+	void write_snapshot(file_writer& out, const ft::map<Key, T, Compare, Alloc, Balance>& m, Encoder encode)
+	{
+		typedef typename ft::map<Key, T, Compare, Alloc, Balance>::const_iterator	const_iterator;
+
+		out.write(snapshot_detail::magic, sizeof(snapshot_detail::magic));
+		out.write_value(snapshot_detail::version);
+		out.write_value(uint32_t(0));
+		out.write_value(uint64_t(m.size()));
+		out.reset_checksum();
+		for (const_iterator it = m.begin(); it != m.end(); ++it)
+			encode(out, *it);
+		out.write_value(out.checksum());
+	}
+
+	/**
+	*  @brief  Replaces the content of @a m with a snapshot read from @a in.
+	*  @throw  std::runtime_error  If the snapshot is truncated, corrupted or
+	*          was written with another format version; @a m is then empty.
+	*/
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Decoder>
+	void read_snapshot(file_reader& in, ft::map<Key, T, Compare, Alloc, Balance>& m, Decoder decode)
+	{
+		typedef typename ft::map<Key, T, Compare, Alloc, Balance>::value_type	value_type;
+
+		char magic[sizeof(snapshot_detail::magic)];
+		in.read(magic, sizeof(magic));
+		if (std::memcmp(magic, snapshot_detail::magic, sizeof(magic)) != 0
+			|| in.read_value<uint32_t>() != snapshot_detail::version)
+			throw std::runtime_error("ft::read_snapshot: not a snapshot or unsupported version");
+		in.read_value<uint32_t>();
+		uint64_t count = in.read_value<uint64_t>();
+
+		in.reset_checksum();
+		snapshot_detail::decode_next<value_type, Decoder> next(in, decode);
+		m.assign_sorted(count, next);
+		uint64_t expected = in.checksum();
+		if (in.read_value<uint64_t>() != expected)
+		{
+			m.clear();
+			throw std::runtime_error("ft::read_snapshot: checksum mismatch");
+		}
+	}
+
+	/**
+	*  @brief  Writes @a m to @a path, replacing the file atomically.
+	*  @param  encode  Called as encode(file_writer&, const value_type&) for
+	*                  each element, in key order.
+	*  @throw  std::runtime_error  On I/O error, @a path is then left untouched.
+	*
+	*  The snapshot is written to "<path>.tmp", synced, then renamed over @a path:
+	*  a crash never leaves a half written snapshot behind.
+	*/
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Encoder>
+	void save_snapshot(const ft::map<Key, T, Compare, Alloc, Balance>& m, const char* path, Encoder encode)
+	{
+		std::string tmp = std::string(path) + ".tmp";
+		try
+		{
+			file_writer out(tmp.c_str());
+			write_snapshot(out, m, encode);
+			out.sync();
+			out.close();
+		}
+		catch (...)
+		{
+			std::remove(tmp.c_str());
+			throw;
+		}
+		if (std::rename(tmp.c_str(), path) != 0)
+		{
+			std::remove(tmp.c_str());
+			throw std::runtime_error(std::string("ft::save_snapshot: cannot rename to ") + path);
+		}
+	}
+
+	/**
+	*  @brief  Replaces the content of @a m with the snapshot at @a path.
+	*  @param  decode  Called as decode(file_reader&) once per element, must
+	*                  return the value_type written by the encoder.
+	*  @throw  std::runtime_error  On I/O error or corrupted file.
+	*/
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Decoder>
+	void load_snapshot(ft::map<Key, T, Compare, Alloc, Balance>& m, const char* path, Decoder decode)
+	{
+		file_reader in(path);
+		read_snapshot(in, m, decode);
+	}
+
+	/* Codec for trivially copyable key and mapped types: raw object bytes.
+	* write_key()/read_key() are used by ft::durable_map for erase records. */
+	template <typename Key, typename T>
+	struct raw_codec
+	{
+		void write_key(file_writer& out, const Key& key) const
+		{
+			out.write_value(key);
+		}
+
+		Key read_key(file_reader& in) const
+		{
+			return in.read_value<Key>();
+		}
+
+		void operator()(file_writer& out, const ft::pair<const Key, T>& value) const
+		{
+			out.write_value(value.first);
+			out.write_value(value.second);
+		}
+
+		ft::pair<const Key, T> operator()(file_reader& in) const
+		{
+			Key key = in.read_value<Key>();
+			return ft::pair<const Key, T>(key, in.read_value<T>());
+		}
+	};
+
+} // namespace
+
+#endif
@@ -57,8 +57,8 @@ run_container()
 {
 	c="$cpp_dir"/"$(basename $container)".cpp
 	b=$(basename "${c%.cpp}")
-	clang++ "$c" -DNAMESPACE=ft -o "$output_dir/ft_$b.out" 2>> "$err"
-	clang++ "$c" -DNAMESPACE=std -o "$output_dir/std_$b.out" 2>> "$err"
+	clang++ -pthread "$c" -DNAMESPACE=ft -o "$output_dir/ft_$b.out" 2>> "$err"
+	clang++ -pthread "$c" -DNAMESPACE=std -o "$output_dir/std_$b.out" 2>> "$err"
 
 	./"$output_dir/ft_$b.out" > "$log_dir/ft_$b" 2>> "$err"
 	./"$output_dir/std_$b.out" > "$log_dir/std_$b" 2>> "$err"
@@ -78,9 +78,23 @@ if [ $# == 1 ]; then
 		run_container
 	elif [ $1 == "map" ]; then
 		run_container
+	elif [ $1 == "durable_map" ]; then
+		run_container
+	elif [ $1 == "compact_map" ]; then
+		run_container
+	elif [ $1 == "small_map" ]; then
+		run_container
+	elif [ $1 == "unordered_map" ]; then
+		run_container
+	elif [ $1 == "radix_map" ]; then
+		run_container
+	elif [ $1 == "concurrent_skiplist_map" ]; then
+		run_container
+	elif [ $1 == "small_vector" ]; then
+		run_container
 	else
 		echo -n "not a container"
 	fi
 else
-	echo -n "choose one container: vector, map, stack"
+	echo -n "choose one container: vector, map, stack, durable_map, compact_map, small_map, unordered_map, radix_map, concurrent_skiplist_map, small_vector"
 fi
\ No newline at end of file
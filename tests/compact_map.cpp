@@ -0,0 +1,139 @@
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "../compact_map.hpp"
+
+#ifndef NAMESPACE
+#define NAMESPACE ft
+#endif
+
+/* FT_ONLY is true when built against ft::. The std build has no compact map:
+* it runs the same code on std::map, so both outputs must match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+#if FT_ONLY
+typedef ft::compact_map<int, std::string>		map_type;
+typedef ft::compact_map<long, long>				churn_type;
+#else
+typedef std::map<int, std::string>				map_type;
+typedef std::map<long, long>					churn_type;
+#endif
+
+void _print(std::string str)
+{
+	std::cout << str << std::endl;
+}
+
+void print_map(const map_type& map)
+{
+	std::cout << " --> PRINT MAP  :" << std::endl;
+	for (map_type::const_iterator it = map.begin(); it != map.end(); ++it)
+		std::cout << "KEY = " << it->first << "  |  VALUE = " << it->second << std::endl;
+	std::cout << " --> MAP SIZE = " << map.size() << std::endl << std::endl;
+}
+
+int main()
+{
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
+	std::cout << "|| --------------------- COMPACT MAP -------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl
+		<< std::endl;
+
+	_print("|| ------------------ INSERT / OPERATOR[] ----------------- ||");
+	map_type map;
+	std::cout << "empty = " << map.empty() << " | begin == end = " << (map.begin() == map.end()) << std::endl;
+	for (int i = 0; i < 20; ++i)
+		map.insert(NAMESPACE::make_pair((i * 7) % 20, std::string(i % 4 + 1, 'a' + i)));
+	std::cout << "insert existing = " << map.insert(NAMESPACE::make_pair(7, std::string("no"))).second << std::endl;
+	map[25] = "twenty-five";
+	map[-3];
+	map.insert(map.end(), NAMESPACE::make_pair(30, std::string("hint")));
+	map.insert(map.begin(), NAMESPACE::make_pair(12, std::string("bad hint")));
+	print_map(map);
+
+	_print("|| ----------------------- LOOK-UP ----------------------- ||");
+	std::cout << "find 12 = " << map.find(12)->second << " | find 13 = " << (map.find(13) == map.end()) << std::endl;
+	std::cout << "count 25 = " << map.count(25) << " | count 26 = " << map.count(26) << std::endl;
+	std::cout << "lower_bound 21 = " << map.lower_bound(21)->first << " | upper_bound 25 = " << map.upper_bound(25)->first << std::endl;
+	std::cout << "equal_range 5 = " << map.equal_range(5).first->first << " " << map.equal_range(5).second->first << std::endl;
+	std::cout << "at 0 = " << map.at(0) << std::endl;
+	try
+	{
+		map.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		std::cout << "at 100 = out_of_range" << std::endl;
+	}
+
+	_print("|| ----------------------- ITERATORS --------------------- ||");
+	for (map_type::reverse_iterator it = map.rbegin(); it != map.rend(); ++it)
+		std::cout << it->first << " ";
+	std::cout << std::endl;
+	map_type::iterator it = map.end();
+	--it;
+	std::cout << "last = " << it->first << " | ";
+	it--;
+	std::cout << "before last = " << (*it).first << std::endl;
+	map_type::const_iterator cit = map.begin();
+	std::cout << "const begin = " << cit->first << " | == begin " << (cit == map.begin()) << std::endl;
+
+	_print("|| ------------------------ ERASE ------------------------ ||");
+	std::cout << "erase 7 = " << map.erase(7) << " | erase 7 = " << map.erase(7) << std::endl;
+	for (map_type::iterator e = map.begin(); e != map.end();)
+	{
+		if (e->first % 3 == 0)
+			map.erase(e++);
+		else
+			++e;
+	}
+	map.erase(map.find(25), map.end());
+	print_map(map);
+
+	_print("|| -------------------- COPY / SWAP ---------------------- ||");
+	map_type copy(map);
+	map_type assigned;
+	assigned = map;
+	copy[100] = "copy only";
+	std::cout << "== " << (assigned == map) << " | != " << (copy != map) << " | < " << (map < copy)
+		<< " | >= " << (copy >= map) << std::endl;
+	map_type other;
+	other[1] = "alone";
+	other.swap(copy);
+	std::cout << "swapped sizes = " << other.size() << " " << copy.size() << " | " << copy.begin()->second << std::endl;
+	map_type ranged(map.find(4), map.find(14));
+	print_map(ranged);
+	map.clear();
+	std::cout << "cleared = " << map.size() << " " << map.empty() << std::endl;
+	map[3] = "after clear";
+	print_map(map);
+
+	_print("|| ------------------------ CHURN ------------------------ ||");
+	churn_type churn;
+	unsigned long checksum = 0;
+	for (long round = 0; round < 20; ++round)
+	{
+		for (long i = 0; i < 1000; ++i)
+			churn[(i * 7919 + round * 31) % 3001] = i + round;
+		for (long i = 0; i < 1000; ++i)
+			churn.erase((i * 104729 + round) % 3001);
+	}
+	for (churn_type::const_iterator c = churn.begin(); c != churn.end(); ++c)
+		checksum = checksum * 31 + c->first * 7 + c->second;
+	std::cout << "size = " << churn.size() << " | checksum = " << checksum << std::endl;
+#if FT_ONLY
+	/* freed slots are reused: the array never outgrows the key range */
+	std::cout << "capacity bounded = " << (churn.capacity() <= 4096) << std::endl;
+	std::cout << "node bytes = " << (churn.memory_usage() - sizeof(churn)) / churn.capacity() << std::endl;
+#else
+	std::cout << "capacity bounded = " << true << std::endl;
+	std::cout << "node bytes = " << 3 * 4 + 4 + sizeof(std::pair<const long, long>) << std::endl;
+#endif
+	return 0;
+}
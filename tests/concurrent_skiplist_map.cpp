@@ -0,0 +1,173 @@
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <pthread.h>
+
+#include "../concurrent_skiplist_map.hpp"
+
+#ifndef NAMESPACE
+#define NAMESPACE ft
+#endif
+
+/* FT_ONLY is true when built against ft::. The std build runs the same
+* code on std::map, the threads one after the other: both outputs must
+* match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+#if FT_ONLY
+typedef ft::concurrent_skiplist_map<int, std::string>		map_type;
+typedef ft::concurrent_skiplist_map<long, long>				shared_type;
+#else
+typedef std::map<int, std::string>							map_type;
+typedef std::map<long, long>								shared_type;
+#endif
+
+void _print(std::string str)
+{
+	std::cout << str << std::endl;
+}
+
+void print_map(const map_type& map)
+{
+	std::cout << " --> PRINT MAP  :" << std::endl;
+	for (map_type::const_iterator it = map.begin(); it != map.end(); ++it)
+		std::cout << "KEY = " << it->first << "  |  VALUE = " << it->second << std::endl;
+	std::cout << " --> MAP SIZE = " << map.size() << std::endl << std::endl;
+}
+
+enum { writers = 4, per_writer = 3000 };
+
+struct writer_arg
+{
+	shared_type*	map;
+	long			id;
+};
+
+/* keys id, id + writers...: disjoint between the writers */
+void* write_keys(void* p)
+{
+	writer_arg* arg = static_cast<writer_arg*>(p);
+
+	for (long i = 0; i < per_writer; ++i)
+	{
+		long key = i * writers + arg->id;
+		arg->map->insert(NAMESPACE::make_pair(key, key * 3));
+		if (i % 4 == 1)
+			arg->map->erase(key);
+		if (i % 5 == 2)
+			arg->map->erase((i / 2) * writers + arg->id);
+	}
+	return NULL;
+}
+
+int main()
+{
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
+	std::cout << "|| --------------- CONCURRENT SKIPLIST MAP -------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl
+		<< std::endl;
+
+	_print("|| ------------------ INSERT / OPERATOR[] ----------------- ||");
+	map_type map;
+	std::cout << "empty = " << map.empty() << " | begin == end = " << (map.begin() == map.end()) << std::endl;
+	for (int i = 0; i < 40; ++i)
+		map.insert(NAMESPACE::make_pair((i * 7) % 40 - 20, std::string(i % 4 + 1, 'a' + i % 26)));
+	std::cout << "insert existing = " << map.insert(NAMESPACE::make_pair(7, std::string("no"))).second
+		<< " | new = " << map.insert(NAMESPACE::make_pair(-700, std::string("minus"))).second << std::endl;
+	map[4500] = "big";
+	map[-1];
+	map.insert(map.end(), NAMESPACE::make_pair(50, std::string("hint")));
+	print_map(map);
+
+	_print("|| ----------------------- LOOK-UP ----------------------- ||");
+	std::cout << "find 12 = " << map.find(12)->second << " | find 41 = " << (map.find(41) == map.end()) << std::endl;
+	std::cout << "count -20 = " << map.count(-20) << " | count 46 = " << map.count(46) << std::endl;
+	std::cout << "lower_bound 21 = " << map.lower_bound(21)->first << " | upper_bound 19 = " << map.upper_bound(19)->first
+		<< " | lower_bound -21 = " << map.lower_bound(-21)->first << std::endl;
+	std::cout << "upper_bound 4500 = end " << (map.upper_bound(4500) == map.end())
+		<< " | equal_range 5 = " << map.equal_range(5).first->second << std::endl;
+	std::cout << "at 0 = " << map.at(0) << std::endl;
+	try
+	{
+		map.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		std::cout << "at 100 = out_of_range" << std::endl;
+	}
+	const map_type& cmap = map;
+	std::cout << "const find -1 = [" << cmap.find(-1)->second << "] | const at 50 = " << cmap.at(50) << std::endl;
+
+	_print("|| ------------------------ ERASE ------------------------ ||");
+	std::cout << "erase 7 = " << map.erase(7) << " | erase 7 = " << map.erase(7) << std::endl;
+	for (map_type::iterator e = map.begin(); e != map.end();)
+	{
+		if (e->first % 3 == 0)
+			map.erase(e++);
+		else
+			++e;
+	}
+	map.erase(map.find(50));
+	std::cout << "insert after erase = " << map.insert(NAMESPACE::make_pair(9, std::string("again"))).second << std::endl;
+	print_map(map);
+
+	_print("|| -------------------- COPY / SWAP ---------------------- ||");
+	map_type copy(map);
+	map_type assigned;
+	assigned = map;
+	copy[100] = "copy only";
+	std::cout << "sizes = " << copy.size() << " " << assigned.size() << " | copy last = ";
+	for (map_type::const_iterator it = copy.begin(); it != copy.end(); ++it)
+		if (it->first == 100)
+			std::cout << it->second;
+	std::cout << std::endl;
+	map_type other;
+	other[1] = "alone";
+	other.swap(copy);
+	std::cout << "swapped sizes = " << other.size() << " " << copy.size() << " | " << copy.begin()->second << std::endl;
+	map_type ranged(map.begin(), map.end());
+	std::cout << "ranged size = " << ranged.size() << std::endl;
+	map.clear();
+	std::cout << "cleared = " << map.size() << " " << map.empty() << " " << (map.begin() == map.end()) << std::endl;
+	map[3] = "after clear";
+	print_map(map);
+
+	_print("|| ----------------------- THREADS ----------------------- ||");
+	shared_type shared;
+	writer_arg args[writers];
+#if FT_ONLY
+	pthread_t threads[writers];
+	for (long t = 0; t < writers; ++t)
+	{
+		args[t].map = &shared;
+		args[t].id = t;
+		pthread_create(&threads[t], NULL, write_keys, &args[t]);
+	}
+	for (long t = 0; t < writers; ++t)
+		pthread_join(threads[t], NULL);
+#else
+	for (long t = 0; t < writers; ++t)
+	{
+		args[t].map = &shared;
+		args[t].id = t;
+		write_keys(&args[t]);
+	}
+#endif
+	unsigned long checksum = 0;
+	long previous = -1;
+	bool ordered = true;
+	for (shared_type::const_iterator it = shared.begin(); it != shared.end(); ++it)
+	{
+		ordered = ordered && it->first > previous && it->second == it->first * 3;
+		previous = it->first;
+		checksum = checksum * 31 + it->first;
+	}
+	std::cout << "size = " << shared.size() << " | ordered = " << ordered << " | checksum = " << checksum << std::endl;
+	std::cout << "lower_bound 5001 = " << shared.lower_bound(5001)->first << " | count 4 = " << shared.count(4) << std::endl;
+	return 0;
+}
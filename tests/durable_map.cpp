@@ -0,0 +1,295 @@
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../map.hpp"
+
+#ifndef NAMESPACE
+#define NAMESPACE ft
+#endif
+
+/* FT_ONLY is true when built against ft::. The std build has no durable map:
+* it replays the same operations on a plain std::map, minus the ones a crash
+* is expected to lose, so both outputs must match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+#if FT_ONLY
+#include "../durable_map.hpp"
+
+struct codec
+{
+	void write_key(ft::file_writer& out, const int& key) const
+	{
+		out.write_value(key);
+	}
+
+	int read_key(ft::file_reader& in) const
+	{
+		return in.read_value<int>();
+	}
+
+	/* "poison" fails half-way through its record */
+	void operator()(ft::file_writer& out, const ft::pair<const int, std::string>& value) const
+	{
+		out.write_value(value.first);
+		if (value.second == "poison")
+			throw std::runtime_error("codec: poison");
+		out.write_value(static_cast<unsigned int>(value.second.size()));
+		out.write(value.second.data(), value.second.size());
+	}
+
+	ft::pair<const int, std::string> operator()(ft::file_reader& in) const
+	{
+		int key = in.read_value<int>();
+		std::string str(in.read_value<unsigned int>(), '\0');
+		if (!str.empty())
+			in.read(&str[0], str.size());
+		return ft::pair<const int, std::string>(key, str);
+	}
+};
+
+typedef ft::durable_map<int, std::string, codec>	store_type;
+
+static const std::string path = "/tmp/ft_containers_durable_map";
+#endif
+
+typedef NAMESPACE::map<int, std::string>			model_type;
+
+void _print(std::string str)
+{
+	std::cout << str << std::endl;
+}
+
+template <typename Store>
+void print_store(const Store& store)
+{
+	std::cout << " --> PRINT STORE  :" << std::endl;
+	for (typename Store::const_iterator it = store.begin(); it != store.end(); ++it)
+		std::cout << "KEY = " << it->first << "  |  VALUE = " << it->second << std::endl;
+	std::cout << " --> STORE SIZE = " << store.size() << std::endl << std::endl;
+}
+
+/* the same workload is applied to the durable store and to the std model */
+template <typename Store>
+void run_ops(Store& store, int first, int last)
+{
+	for (int i = first; i < last; ++i)
+	{
+		if (i % 5 == 0)
+			store.erase(i - 3);
+		else if (i % 3 == 0)
+			store.insert(NAMESPACE::make_pair(i % 17, std::string("inserted")));
+		else
+			store[i % 23] = std::string(i % 7 + 1, 'a' + i % 26);
+	}
+}
+
+#if FT_ONLY
+/* runs the workload in a child that dies without any cleanup: no destructor,
+* no flush of the log writer's buffer, like a kill -9 */
+void crash_after(const ft::durable_options& options, int first, int last, bool sync_before_crash)
+{
+	std::cout.flush();
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		store_type store(path, options);
+		run_ops(store, first, last);
+		if (sync_before_crash)
+			store.sync();
+		_exit(0);
+	}
+	int status;
+	waitpid(pid, &status, 0);
+}
+
+void remove_files()
+{
+	std::remove((path + ".wal").c_str());
+	std::remove((path + ".snap").c_str());
+}
+
+long file_size(const std::string& name)
+{
+	std::FILE* file = std::fopen(name.c_str(), "rb");
+	if (!file)
+		return -1;
+	std::fseek(file, 0, SEEK_END);
+	long size = std::ftell(file);
+	std::fclose(file);
+	return size;
+}
+#endif
+
+int main()
+{
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
+	std::cout << "|| --------------------- DURABLE MAP -------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl
+		<< std::endl;
+
+	model_type model;
+#if FT_ONLY
+	remove_files();
+#endif
+
+	_print("|| ------------- CRASH, EVERY RECORD SYNCED -------------- ||");
+	{
+#if FT_ONLY
+		crash_after(ft::durable_options(1, 0), 0, 60, false);
+		store_type store(path);
+		print_store(store);
+#else
+		run_ops(model, 0, 60);
+		print_store(model);
+#endif
+	}
+
+	_print("|| --------------- CRASH ACROSS CHECKPOINTS -------------- ||");
+	{
+#if FT_ONLY
+		crash_after(ft::durable_options(1, 16), 60, 150, false);
+		store_type store(path);
+		std::cout << "checkpointed : " << (store.log_records() < 16) << std::endl;
+		print_store(store);
+#else
+		run_ops(model, 60, 150);
+		std::cout << "checkpointed : " << 1 << std::endl;
+		print_store(model);
+#endif
+	}
+
+	_print("|| ------------ CRASH, GROUP COMMIT NOT SYNCED ----------- ||");
+	{
+#if FT_ONLY
+		crash_after(ft::durable_options(1000, 0), 150, 170, true);
+		crash_after(ft::durable_options(1000, 0), 170, 200, false);
+		store_type store(path);
+		print_store(store);
+#else
+		/* the second batch was still in the writer's buffer */
+		run_ops(model, 150, 170);
+		print_store(model);
+#endif
+	}
+
+	_print("|| ----------------------- TORN TAIL -------------------- ||");
+	{
+#if FT_ONLY
+		{
+			store_type store(path, ft::durable_options(1, 0));
+			store.put(1000, "lost in a torn write");
+			store.close();
+		}
+		/* the last record loses its trailer, as if the machine died mid-append */
+		long size = file_size(path + ".wal");
+		if (truncate((path + ".wal").c_str(), size - 5) != 0)
+			return 1;
+		store_type store(path);
+		print_store(store);
+		store[1001] = "appended after recovery";
+		store.close();
+		store_type reopened(path);
+		print_store(reopened);
+#else
+		print_store(model);
+		model[1001] = "appended after recovery";
+		print_store(model);
+#endif
+	}
+
+	_print("|| -------------------- FAILED RECORD -------------------- ||");
+	{
+		/* a record the codec leaves half-written: later ones would be cut
+		* off with it on reopen, so they are refused until a checkpoint */
+#if FT_ONLY
+		{
+			store_type store(path, ft::durable_options(1, 0));
+			store.clear();
+			store[1] = "one";
+			try
+			{
+				store.put(2, "poison");
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cout << "put : " << e.what() << std::endl;
+			}
+			try
+			{
+				store[3] = "three";
+				std::cout << "after the failure : accepted" << std::endl;
+			}
+			catch (const std::runtime_error&)
+			{
+				std::cout << "after the failure : refused" << std::endl;
+			}
+			store.close();
+		}
+		{
+			store_type store(path, ft::durable_options(1, 0));
+			print_store(store);
+			try
+			{
+				store.put(5, "poison");
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cout << "put : " << e.what() << std::endl;
+			}
+			store.checkpoint();
+			store[4] = "four";
+			store.close();
+		}
+		store_type store(path);
+		print_store(store);
+#else
+		model.clear();
+		model[1] = "one";
+		std::cout << "put : codec: poison" << std::endl;
+		std::cout << "after the failure : refused" << std::endl;
+		print_store(model);
+		std::cout << "put : codec: poison" << std::endl;
+		model[4] = "four";
+		print_store(model);
+#endif
+	}
+
+	_print("|| ------------------ EXPLICIT CHECKPOINT ---------------- ||");
+	{
+#if FT_ONLY
+		{
+			store_type store(path, ft::durable_options(0, 0));
+			store.clear();
+			store[7] = "seven";
+			store[3] = "three";
+			store.checkpoint();
+			std::cout << "log records after checkpoint : " << store.log_records() << std::endl;
+			store.erase(7);
+			store[3];
+			store[4];
+		}
+		store_type store(path);
+		print_store(store);
+#else
+		model.clear();
+		model[7] = "seven";
+		model[3] = "three";
+		std::cout << "log records after checkpoint : " << 0 << std::endl;
+		model.erase(7);
+		model[3];
+		model[4];
+		print_store(model);
+#endif
+	}
+#if FT_ONLY
+	remove_files();
+#endif
+}
@@ -4,13 +4,90 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <string>
 
 #include "../map.hpp"
+#include "../allocator.hpp"
+#include "../arena.hpp"
+#include "test_arena.hpp"
 
 #ifndef NAMESPACE
 #define NAMESPACE ft
 #endif
 
+/* FT_ONLY is true when built against ft::, for the extensions std:: lacks;
+* the std build runs the equivalent plain map code so that the outputs match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+#if FT_ONLY
+#include "../frozen_map.hpp"
+#include "../snapshot.hpp"
+
+struct string_codec
+{
+	void write_string(ft::file_writer& out, const std::string& str) const
+	{
+		out.write_value(static_cast<unsigned int>(str.size()));
+		out.write(str.data(), str.size());
+	}
+
+	std::string read_string(ft::file_reader& in) const
+	{
+		std::string str(in.read_value<unsigned int>(), '\0');
+		if (!str.empty())
+			in.read(&str[0], str.size());
+		return str;
+	}
+
+	void operator()(ft::file_writer& out, const ft::pair<const std::string, std::string>& value) const
+	{
+		write_string(out, value.first);
+		write_string(out, value.second);
+	}
+
+	ft::pair<const std::string, std::string> operator()(ft::file_reader& in) const
+	{
+		std::string key = read_string(in);
+		return ft::pair<const std::string, std::string>(key, read_string(in));
+	}
+};
+
+/* freezes map, overwrites one header field with value and opens the file */
+template <typename Map>
+bool open_corrupted(const Map& map, const char* path, std::size_t field, uint64_t value)
+{
+	ft::freeze(map, path);
+	std::FILE* file = std::fopen(path, "r+b");
+	if (!file)
+		return false;
+	std::fseek(file, static_cast<long>(field), SEEK_SET);
+	std::fwrite(&value, sizeof(value), 1, file);
+	std::fclose(file);
+	try
+	{
+		ft::frozen_map<typename Map::key_type, typename Map::mapped_type> frozen(path);
+		return false;
+	}
+	catch (const std::runtime_error&)
+	{
+		return true;
+	}
+}
+#endif
+
+/* neither key nor mapped type can be default constructed */
+struct no_default
+{
+	int	value;
+
+	explicit no_default(int v) : value(v) {}
+
+	bool operator<(const no_default& other) const { return value < other.value; }
+};
+
 template <typename Key, typename T>
 NAMESPACE::map<Key, T> build_map() {
 
@@ -58,6 +135,38 @@ void _print(std::string str)
 	std::cout << str << std::endl;
 }
 
+template<typename Map, typename Key>
+void print_lookups(const Map& map, Key key)
+{
+	typename Map::const_iterator it = map.find(key);
+	std::cout << "find " << key << " --> " << (it != map.end() ? "found" : "not found") << std::endl;
+	it = map.lower_bound(key);
+	if (it != map.end())
+		std::cout << "lower_bound " << key << " --> " << it->first << " | " << it->second << std::endl;
+	else
+		std::cout << "lower_bound " << key << " --> end" << std::endl;
+	it = map.upper_bound(key);
+	if (it != map.end())
+		std::cout << "upper_bound " << key << " --> " << it->first << " | " << it->second << std::endl;
+	else
+		std::cout << "upper_bound " << key << " --> end" << std::endl;
+}
+
+/* swap of two maps whose allocators differ and stay: ft:: copies the
+* elements, std:: leaves it undefined, so the std build copies by hand */
+template <typename Map>
+void swap_elements(Map& a, Map& b)
+{
+#if FT_ONLY
+	a.swap(b);
+#else
+	Map mine(b.begin(), b.end(), b.key_comp(), a.get_allocator());
+	Map theirs(a.begin(), a.end(), a.key_comp(), b.get_allocator());
+	a.swap(mine);
+	b.swap(theirs);
+#endif
+}
+
 int main()
 {
 	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
@@ -395,5 +504,472 @@ int main()
 
 		std::cout << std::endl;
 		comparisons(lhs, rhs);
-	}	
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ---------------------- FROZEN MAP --------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::map<long, double> map;
+		for (long i = 0; i < 1000; ++i)
+			map.insert(NAMESPACE::make_pair(i * 3, i * 0.5));
+#if FT_ONLY
+		const char* path = "/tmp/ft_containers_frozen_map.bin";
+		ft::freeze(map, path);
+		typedef ft::frozen_map<long, double> frozen_type;
+		frozen_type frozen(path);
+		NAMESPACE::map<long, double> thawed = frozen.thaw();
+#else
+		typedef NAMESPACE::map<long, double> frozen_type;
+		const frozen_type& frozen = map;
+		NAMESPACE::map<long, double> thawed(map);
+#endif
+		std::cout << "size = " << frozen.size() << std::endl;
+		long sum = 0;
+		double values = 0;
+		for (frozen_type::const_iterator it = frozen.begin(); it != frozen.end(); ++it)
+		{
+			sum += it->first;
+			values += it->second;
+		}
+		std::cout << "sum of keys = " << sum << " | sum of values = " << values << std::endl;
+		print_lookups(frozen, -1L);
+		print_lookups(frozen, 0L);
+		print_lookups(frozen, 191L);
+		print_lookups(frozen, 192L);
+		print_lookups(frozen, 2997L);
+		print_lookups(frozen, 5000L);
+		_print("--> thaw");
+		thawed[-3] = 1.5;
+		thawed.erase(3);
+		std::cout << "thawed size = " << thawed.size() << " | begin = " << thawed.begin()->first
+			<< " | next = " << (++thawed.begin())->first << std::endl;
+
+		/* arrays out of the file, sizes that wrap, misaligned offsets */
+		_print("--> corrupt headers");
+		const char* names[] = { "huge count", "entries past the end", "wrapping fences", "misaligned entries" };
+#if FT_ONLY
+		const std::size_t fields[] = { offsetof(ft::frozen_header, count), offsetof(ft::frozen_header, entries_offset),
+			offsetof(ft::frozen_header, fences_offset), offsetof(ft::frozen_header, entries_offset) };
+		const uint64_t corrupt[] = { 1ULL << 60, 16192, ~0ULL - 7, 68 };
+#endif
+		for (int i = 0; i < 4; ++i)
+		{
+			bool rejected = true;
+#if FT_ONLY
+			rejected = open_corrupted(map, path, fields[i], corrupt[i]);
+#endif
+			std::cout << names[i] << " : rejected = " << rejected << std::endl;
+		}
+
+		/* the entries are in the order of the comparator they were frozen with */
+		_print("--> comparators");
+		bool other_type = true, other_id = true, same = true;
+#if FT_ONLY
+		ft::freeze(map, path, 7);
+		try
+		{
+			ft::frozen_map<long, double, std::greater<long> > reversed(path, std::greater<long>(), 7);
+			other_type = false;
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+		try
+		{
+			frozen_type unlabelled(path);
+			other_id = false;
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+		frozen_type labelled(path, std::less<long>(), 7);
+		same = labelled.size() == map.size() && labelled.find(2997) != labelled.end();
+#endif
+		std::cout << "other comparator type : rejected = " << other_type << " | other id : rejected = " << other_id
+			<< " | same comparator and id : opened = " << same << std::endl;
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ----------------------- SNAPSHOT ---------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::map<std::string, std::string> map;
+		for (int i = 0; i < 777; ++i)
+		{
+			std::string key(1 + i % 7, 'a' + i % 26);
+			key += std::string(i / 26 + 1, 'z');
+			map[key] = std::string(i % 13, '*');
+		}
+		NAMESPACE::map<std::string, std::string> restored;
+		restored["stale"] = "content";
+#if FT_ONLY
+		const char* path = "/tmp/ft_containers_snapshot.bin";
+		ft::save_snapshot(map, path, string_codec());
+		ft::load_snapshot(restored, path, string_codec());
+#else
+		restored = map;
+#endif
+		std::cout << "size = " << restored.size() << " | equal = " << (restored == map) << std::endl;
+		restored.erase(restored.begin());
+		restored.erase(--restored.end());
+		restored["aaaa"] = "inserted";
+		restored.insert(NAMESPACE::make_pair(std::string("zz"), std::string("last")));
+		std::cout << "size = " << restored.size() << " | begin = " << restored.begin()->first
+			<< " | last = " << restored.rbegin()->first << std::endl;
+		NAMESPACE::map<std::string, std::string>::iterator it = restored.begin();
+		for (int i = 0; i < 10; ++i, ++it)
+			std::cout << it->first << " = " << it->second << std::endl;
+		restored.clear();
+		std::cout << "cleared size = " << restored.size() << std::endl;
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ------------------------ STATS ------------------------ ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::map<int, long> map;
+		for (int i = 0; i < 5000; ++i)
+			map[(i * 7919) % 5003] = i;
+		for (int i = 0; i < 1000; ++i)
+			map.erase(i * 3);
+#if FT_ONLY
+		ft::map_stats stats = map.stats();
+		std::size_t histogram_total = 0;
+		for (std::size_t d = 0; d < stats.depth_histogram.size(); ++d)
+			histogram_total += stats.depth_histogram[d];
+		/* AVL bound: height < 1.45 * log2(n + 2) */
+		std::size_t bound = 1;
+		for (std::size_t n = stats.node_count + 2; n > 1; n /= 2)
+			++bound;
+		std::cout << "node count = " << stats.node_count << " | histogram total = " << histogram_total << std::endl;
+		std::cout << "balanced = " << (stats.height > 0 && stats.height * 100 <= bound * 145) << std::endl;
+		std::cout << "one root = " << (stats.depth_histogram[0] == 1) << std::endl;
+		std::cout << "bytes consistent = " << (stats.bytes_allocated
+			== stats.node_count * stats.node_size + stats.sentinel_bytes) << std::endl;
+		std::cout << "overhead = " << (stats.per_node_overhead == stats.node_size - sizeof(ft::pair<const int, long>)) << std::endl;
+#else
+		std::cout << "node count = " << map.size() << " | histogram total = " << map.size() << std::endl;
+		std::cout << "balanced = " << true << std::endl;
+		std::cout << "one root = " << true << std::endl;
+		std::cout << "bytes consistent = " << true << std::endl;
+		std::cout << "overhead = " << true << std::endl;
+#endif
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ---------------------- SENTINEL ----------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::map<no_default, no_default> map;
+#if FT_ONLY
+		std::cout << "empty map heap bytes = " << map.stats().bytes_allocated << std::endl;
+#else
+		std::cout << "empty map heap bytes = " << 0 << std::endl;
+#endif
+		for (int i = 0; i < 40; ++i)
+			map.insert(map.end(), NAMESPACE::make_pair(no_default(i * 3), no_default(i)));
+		for (int i = 0; i < 40; ++i)
+			map.insert(map.begin(), NAMESPACE::make_pair(no_default(i * 3 + 1), no_default(-i)));
+		for (int i = 0; i < 60; i += 2)
+			map.erase(no_default(i));
+		for (NAMESPACE::map<no_default, no_default>::iterator it = map.begin(); it != map.end(); ++it)
+			std::cout << it->first.value << ":" << it->second.value << " ";
+		std::cout << std::endl << "size = " << map.size() << std::endl;
+
+		/* iterators follow their elements into the other map */
+		NAMESPACE::map<no_default, no_default> other;
+		other.insert(NAMESPACE::make_pair(no_default(1000), no_default(0)));
+		NAMESPACE::map<no_default, no_default>::iterator it = map.find(no_default(100));
+		map.swap(other);
+		int walked = 0;
+		for (; it != other.end(); ++it)
+			++walked;
+		std::cout << "walked = " << walked << " | swapped sizes = " << map.size() << " " << other.size() << std::endl;
+		for (--it; it != other.begin(); --it)
+			++walked;
+		std::cout << "walked back = " << walked << " | first = " << it->first.value << std::endl;
+		map.clear();
+		std::cout << "cleared empty = " << map.empty() << " | begin == end = " << (map.begin() == map.end()) << std::endl;
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| --------------------- RED-BLACK ----------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+#if FT_ONLY
+		typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::rb_balance>	rb_map;
+#else
+		typedef std::map<int, int>																			rb_map;
+#endif
+		rb_map map;
+		for (int i = 0; i < 20000; ++i)
+		{
+			int key = (i * 7919) % 4099;
+			if (i % 3 == 2)
+				map.erase(key);
+			else
+				map[key] = i;
+		}
+		long sum = 0;
+		for (rb_map::iterator it = map.begin(); it != map.end(); ++it)
+			sum += it->first * 3 + it->second;
+		std::cout << "size = " << map.size() << " | sum = " << sum << std::endl;
+		rb_map::reverse_iterator rit = map.rbegin();
+		for (int i = 0; i < 5; ++i, ++rit)
+			std::cout << rit->first << ":" << rit->second << " ";
+		std::cout << std::endl;
+#if FT_ONLY
+		/* red-black bound: height <= 2 * log2(n + 1) */
+		std::size_t bound = 0;
+		for (std::size_t n = map.size() + 1; n > 1; n /= 2)
+			++bound;
+		std::cout << "balanced = " << (map.stats().height <= 2 * (bound + 1)) << std::endl;
+#else
+		std::cout << "balanced = " << true << std::endl;
+#endif
+		rb_map copy(map);
+		copy.erase(copy.begin(), copy.find(2000));
+		std::cout << "copy size = " << copy.size() << " | first = " << copy.begin()->first << std::endl;
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ---------------- TRANSPARENT LOOK-UP ------------------ ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		/* ft::map compares the const char* directly, std::map of C++98 converts it */
+		typedef NAMESPACE::map<std::string, int, ft::transparent_less>	string_map;
+		string_map map;
+		const char* words[] = { "pear", "apple", "fig", "kiwi", "banana", "cherry", "lemon", "mango" };
+		for (int i = 0; i < 8; ++i)
+			map[words[i]] = i;
+		std::cout << "find kiwi = " << map.find("kiwi")->second << " | find plum = " << (map.find("plum") == map.end()) << std::endl;
+		std::cout << "count fig = " << map.count("fig") << " | count grape = " << map.count("grape") << std::endl;
+		std::cout << "lower_bound c = " << map.lower_bound("c")->first << " | upper_bound kiwi = " << map.upper_bound("kiwi")->first << std::endl;
+		NAMESPACE::pair<string_map::const_iterator, string_map::const_iterator> range = static_cast<const string_map&>(map).equal_range("lemon");
+		std::cout << "equal_range lemon = " << range.first->first << " .. " << range.second->first << std::endl;
+		std::cout << "erase banana = " << map.erase("banana") << " | erase banana = " << map.erase("banana") << std::endl;
+		map.erase(map.find("apple"));
+		for (string_map::iterator it = map.begin(); it != map.end(); ++it)
+			std::cout << it->first << " ";
+		std::cout << std::endl;
+
+		/* without is_transparent the key is still built from the argument */
+		NAMESPACE::map<std::string, int> plain;
+		plain["one"] = 1;
+		std::cout << "plain find = " << plain.find("one")->second << " | plain lower_bound = " << (plain.lower_bound("z") == plain.end()) << std::endl;
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| -------------------- KEY PREFIX ----------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+#if FT_ONLY
+		typedef ft::map<std::string, int, ft::prefix_less>	prefix_map;
+#else
+		typedef std::map<std::string, int>					prefix_map;
+#endif
+		/* shared 8 byte prefixes, keys shorter than a prefix, embedded '\0'
+		* and bytes above 0x7f must all sort like std::string */
+		const char* keys[] = { "customer/0042", "customer/0007", "customer", "custom", "", "a",
+			"customer/0042/orders", "\xff\xfe", "\x7f", "zz", "customes" };
+		prefix_map map;
+		for (int i = 0; i < 11; ++i)
+			map[keys[i]] = i;
+		map[std::string("ab\0c", 4)] = 11;
+		map[std::string("ab\0", 3)] = 12;
+		map[std::string("ab", 2)] = 13;
+		for (int i = 0; i < 500; ++i)
+		{
+			std::string key = "customer/" + std::string(1, 'a' + i % 26) + std::string(i % 13, 'x');
+			map[key] += i;
+		}
+		long sum = 0;
+		int position = 0;
+		for (prefix_map::iterator it = map.begin(); it != map.end(); ++it, ++position)
+			sum += position * (it->second + static_cast<long>(it->first.size()));
+		std::cout << "size = " << map.size() << " | ordered sum = " << sum << std::endl;
+		for (int i = 0; i < 11; ++i)
+			std::cout << map.find(keys[i])->second << " ";
+		std::cout << map.count(std::string("ab\0", 3)) << " " << map.count("customer/") << std::endl;
+		std::cout << "lower_bound customer/ = " << map.lower_bound("customer/")->first
+			<< " | upper_bound customer/0042 = " << map.upper_bound("customer/0042")->first << std::endl;
+		map.erase("customer");
+		map.erase(std::string("ab\0", 3));
+		std::cout << "after erase = " << map.size() << " | " << map.count("customer") << map.count("custom") << std::endl;
+	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ------------------- INTEGRAL KEYS --------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::map<int, int, std::greater<int> > desc;
+		NAMESPACE::map<unsigned long, int> asc;
+		for (int i = 0; i < 3000; ++i)
+		{
+			desc[(i * 37) % 2003 - 1000] = i;
+			asc[static_cast<unsigned long>(i) * 0x9E3779B97F4AUL] = i;
+		}
+		for (int i = 0; i < 500; ++i)
+		{
+			desc.erase(i * 3 - 700);
+			asc.erase(static_cast<unsigned long>(i * 2) * 0x9E3779B97F4AUL);
+		}
+		std::cout << "sizes = " << desc.size() << " " << asc.size() << std::endl;
+		for (int key = -1010; key <= 1010; key += 101)
+		{
+			std::cout << key << ": " << desc.count(key) << " " << (desc.find(key) == desc.end())
+				<< " " << desc.lower_bound(key)->first << " " << desc.upper_bound(key)->first << std::endl;
+		}
+		unsigned long probes[] = { 0, 1, 0x9E3779B97F4AUL, 0x9E3779B97F4AUL * 3, 0x9E3779B97F4AUL * 1001 + 5 };
+		for (int i = 0; i < 5; ++i)
+		{
+			std::cout << probes[i] << ": " << asc.count(probes[i]) << " " << asc.lower_bound(probes[i])->second
+				<< " " << asc.upper_bound(probes[i])->second << std::endl;
+		}
+		std::cout << "past the end = " << (asc.lower_bound(~0UL) == asc.end()) << (desc.upper_bound(-2000) == desc.end()) << std::endl;
+	}
+	std::cout << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ----------------------- COMPACT ----------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::map<int, std::string> map;
+		for (int round = 0; round < 10; ++round)
+		{
+			for (int i = 0; i < 300; ++i)
+				map[(i * 7919 + round * 31) % 1001] = std::string(i % 5 + 1, 'a' + round);
+			for (int i = 0; i < 200; ++i)
+				map.erase((i * 104729 + round) % 1001);
+		}
+		NAMESPACE::map<int, std::string> before(map);
+#if FT_ONLY
+		ft::map_stats churned = map.stats();
+		map.compact();
+#endif
+		std::cout << "same content = " << (map == before) << " | size = " << map.size() << std::endl;
+		std::cout << "first = " << map.begin()->first << " | last = " << map.rbegin()->first << std::endl;
+#if FT_ONLY
+		std::cout << "same shape = " << (map.stats().depth_histogram == churned.depth_histogram)
+			<< " | heap bytes = " << (map.stats().bytes_allocated == churned.bytes_allocated) << std::endl;
+		map.compact(true);
+		std::size_t optimal = 0;
+		while ((static_cast<std::size_t>(1) << optimal) <= map.size())
+			++optimal;
+		std::cout << "perfect balance = " << (map.stats().height == optimal) << std::endl;
+#else
+		std::cout << "same shape = " << true << " | heap bytes = " << true << std::endl;
+		std::cout << "perfect balance = " << true << std::endl;
+#endif
+		std::cout << "same content = " << (map == before) << std::endl;
+
+		/* the map keeps working on compacted nodes */
+		for (int i = 0; i < 1001; i += 3)
+			map.erase(i);
+		for (int i = 0; i < 50; ++i)
+			map[i * 20] = "new";
+		int walked = 0;
+		for (NAMESPACE::map<int, std::string>::reverse_iterator it = map.rbegin(); it != map.rend(); ++it)
+			++walked;
+		std::cout << "size = " << map.size() << " | walked = " << walked << " | find 40 = " << map.find(40)->second << std::endl;
+		NAMESPACE::map<int, std::string> other;
+		other.swap(map);
+		map = other;
+		other.clear();
+		std::cout << "after swap / clear = " << map.size() << " " << other.size() << " | lower_bound 500 = "
+			<< map.lower_bound(500)->first << std::endl;
+	}
+	{
+		/* nodes from ft::aligned_allocator, in both builds */
+		typedef ft::aligned_allocator<NAMESPACE::pair<const int, std::string>, 128, ft::alloc_prefault>	aligned;
+		typedef NAMESPACE::map<int, std::string, std::less<int>, aligned>									aligned_map;
+		aligned_map map((std::less<int>()), aligned());
+		for (int i = 0; i < 200; ++i)
+			map[(i * 37) % 200] = std::string(i % 7 + 1, 'k');
+		aligned_map copy(map);
+		copy.erase(copy.begin(), copy.find(150));
+		std::cout << "aligned map : size = " << map.size() << " " << copy.size() << " | first = " << copy.begin()->first
+			<< " | get_allocator = " << (map.get_allocator() == aligned()) << std::endl;
+	}
+	{
+		/* nodes from a stateful allocator: each map keeps its arena, or not */
+		typedef NAMESPACE::pair<const int, std::string>		value;
+		test_arena red("red"), blue("blue");
+		{
+			typedef test_arena_allocator<value>									kept;
+			typedef NAMESPACE::map<int, std::string, std::less<int>, kept>	kept_map;
+			kept_map a((std::less<int>()), kept(red));
+			kept_map b((std::less<int>()), kept(blue));
+			for (int i = 0; i < 60; ++i)
+				a[i] = std::string(i % 5 + 1, 'r');
+			for (int i = 0; i < 10; ++i)
+				b[i * 100] = "blue";
+			kept_map c(a);
+			std::cout << "stateful copy : " << c.get_allocator().name() << " " << c.size() << std::endl;
+			c = b;
+			std::cout << "stateful assign : " << c.get_allocator().name() << " " << c.size() << " " << c.rbegin()->first << std::endl;
+			swap_elements(a, b);
+			std::cout << "stateful swap : " << a.get_allocator().name() << " " << a.size() << " " << a.rbegin()->first
+				<< " | " << b.get_allocator().name() << " " << b.size() << std::endl;
+			a.insert(b.begin(), b.find(20));
+			a.erase(a.find(900));
+			c.swap(a);
+			std::cout << "equal swap : " << c.get_allocator().name() << " " << c.size() << " " << a.size() << std::endl;
+
+			typedef test_arena_allocator<value, true>								moving;
+			typedef NAMESPACE::map<int, std::string, std::less<int>, moving>	moving_map;
+			moving_map d((std::less<int>()), moving(red));
+			moving_map e((std::less<int>()), moving(blue));
+			for (int i = 0; i < 30; ++i)
+			{
+				d[i] = "d";
+				e[-i] = "e";
+			}
+			d = e;
+			std::cout << "propagated assign : " << d.get_allocator().name() << " " << d.size() << " " << d.begin()->first << std::endl;
+			moving_map f((std::less<int>()), moving(red));
+			f[1] = "f";
+			f.swap(d);
+			f.erase(f.begin());
+			d[2] = "d";
+			std::cout << "propagated swap : " << f.get_allocator().name() << " " << f.size()
+				<< " | " << d.get_allocator().name() << " " << d.size() << std::endl;
+		}
+		std::cout << "red : live " << red.live() << " foreign " << red.foreign()
+			<< " | blue : live " << blue.live() << " foreign " << blue.foreign() << std::endl;
+	}
+	{
+		/* request-scoped maps on ft::arena, in both builds */
+		typedef ft::arena_allocator<NAMESPACE::pair<const int, std::string> >				arena_alloc;
+		typedef NAMESPACE::map<int, std::string, std::less<int>, arena_alloc>				arena_map;
+		ft::arena arena(8192);
+		ft::arena::size_type reserved[2];
+		for (int request = 0; request < 2; ++request)
+		{
+			{
+				arena_map headers((std::less<int>()), arena_alloc(arena));
+				for (int i = 0; i < 300; ++i)
+					headers[(i * 53) % 300] = std::string(i % 6 + 1, 'h');
+				headers.erase(headers.find(100), headers.find(200));
+				arena_map copy(headers);
+				copy.erase(7);
+				std::cout << "arena request " << request << " : " << headers.size() << " " << copy.size() << " "
+					<< headers.lower_bound(100)->first << " " << copy[299] << " | same arena = "
+					<< (copy.get_allocator() == headers.get_allocator()) << std::endl;
+			}
+			reserved[request] = arena.bytes_reserved();
+			arena.reset();
+		}
+		std::cout << "arena reset : allocated = " << arena.bytes_allocated() << " | chunks reused = "
+			<< (reserved[1] == reserved[0]) << std::endl;
+	}
 }
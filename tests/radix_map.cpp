@@ -0,0 +1,198 @@
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "../radix_map.hpp"
+
+#ifndef NAMESPACE
+#define NAMESPACE ft
+#endif
+
+/* FT_ONLY is true when built against ft::. The std build runs the same
+* code on std::map: both are ordered, their outputs must match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+#if FT_ONLY
+typedef ft::radix_map<int, std::string>				map_type;
+typedef ft::radix_map<std::string, int>				string_map;
+typedef ft::radix_map<unsigned long, long>			churn_type;
+#else
+typedef std::map<int, std::string>					map_type;
+typedef std::map<std::string, int>					string_map;
+typedef std::map<unsigned long, long>				churn_type;
+#endif
+
+void _print(std::string str)
+{
+	std::cout << str << std::endl;
+}
+
+void print_map(const map_type& map)
+{
+	std::cout << " --> PRINT MAP  :" << std::endl;
+	for (map_type::const_iterator it = map.begin(); it != map.end(); ++it)
+		std::cout << "KEY = " << it->first << "  |  VALUE = " << it->second << std::endl;
+	std::cout << " --> MAP SIZE = " << map.size() << std::endl << std::endl;
+}
+
+/* the keys starting with prefix, through prefix_range() or a scan */
+void print_prefix(const string_map& words, const std::string& prefix)
+{
+#if FT_ONLY
+	ft::pair<string_map::const_iterator, string_map::const_iterator> range = words.prefix_range(prefix);
+#else
+	std::pair<string_map::const_iterator, string_map::const_iterator> range(words.lower_bound(prefix), words.lower_bound(prefix));
+	while (range.second != words.end() && range.second->first.compare(0, prefix.size(), prefix) == 0)
+		++range.second;
+#endif
+	std::cout << "prefix [" << prefix << "] :";
+	for (; range.first != range.second; ++range.first)
+		std::cout << " " << range.first->first;
+	std::cout << std::endl;
+}
+
+int main()
+{
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
+	std::cout << "|| ---------------------- RADIX MAP --------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl
+		<< std::endl;
+
+	_print("|| ------------------ INSERT / OPERATOR[] ----------------- ||");
+	map_type map;
+	std::cout << "empty = " << map.empty() << " | begin == end = " << (map.begin() == map.end()) << std::endl;
+	for (int i = 0; i < 40; ++i)
+		map.insert(NAMESPACE::make_pair((i * 7) % 40 - 20, std::string(i % 4 + 1, 'a' + i % 26)));
+	std::cout << "insert existing = " << map.insert(NAMESPACE::make_pair(7, std::string("no"))).second
+		<< " | new = " << map.insert(NAMESPACE::make_pair(-70000, std::string("minus"))).second << std::endl;
+	map[450000] = "big";
+	map[-1];
+	map.insert(map.end(), NAMESPACE::make_pair(50, std::string("hint")));
+	print_map(map);
+
+	_print("|| ----------------------- LOOK-UP ----------------------- ||");
+	std::cout << "find 12 = " << map.find(12)->second << " | find 41 = " << (map.find(41) == map.end()) << std::endl;
+	std::cout << "count -20 = " << map.count(-20) << " | count 46 = " << map.count(46) << std::endl;
+	std::cout << "lower_bound 21 = " << map.lower_bound(21)->first << " | upper_bound 19 = " << map.upper_bound(19)->first
+		<< " | lower_bound -21 = " << map.lower_bound(-21)->first << std::endl;
+	std::cout << "upper_bound 450000 = end " << (map.upper_bound(450000) == map.end())
+		<< " | equal_range 5 = " << map.equal_range(5).first->second << std::endl;
+	std::cout << "at 0 = " << map.at(0) << std::endl;
+	try
+	{
+		map.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		std::cout << "at 100 = out_of_range" << std::endl;
+	}
+	const map_type& cmap = map;
+	std::cout << "const find -1 = [" << cmap.find(-1)->second << "] | const at 50 = " << cmap.at(50) << std::endl;
+	std::cout << "reverse :";
+	for (map_type::const_reverse_iterator r = cmap.rbegin(); r != cmap.rend(); ++r)
+		std::cout << " " << r->first;
+	std::cout << std::endl;
+
+	_print("|| ------------------------ ERASE ------------------------ ||");
+	std::cout << "erase 7 = " << map.erase(7) << " | erase 7 = " << map.erase(7) << std::endl;
+	for (map_type::iterator e = map.begin(); e != map.end();)
+	{
+		if (e->first % 3 == 0)
+			map.erase(e++);
+		else
+			++e;
+	}
+	map.erase(map.find(50));
+	map.erase(map.lower_bound(10), map.lower_bound(16));
+	print_map(map);
+
+	_print("|| -------------------- COPY / SWAP ---------------------- ||");
+	map_type copy(map);
+	map_type assigned;
+	assigned = map;
+	copy[100] = "copy only";
+	std::cout << "== " << (assigned == map) << " | != " << (copy != map) << " | < " << (map < copy) << std::endl;
+	map_type other;
+	other[1] = "alone";
+	other.swap(copy);
+	std::cout << "swapped sizes = " << other.size() << " " << copy.size() << " | " << copy.begin()->second
+		<< " | last = " << (--other.end())->first << std::endl;
+	map_type empty;
+	empty.swap(copy);
+	std::cout << "swap with empty = " << copy.size() << " " << (copy.begin() == copy.end()) << " " << empty.size() << std::endl;
+	map_type ranged(map.begin(), map.end());
+	std::cout << "ranged == map = " << (ranged == map) << std::endl;
+	map.clear();
+	std::cout << "cleared = " << map.size() << " " << map.empty() << " " << (map.begin() == map.end()) << std::endl;
+	map[3] = "after clear";
+	print_map(map);
+
+	_print("|| --------------------- STRING KEYS --------------------- ||");
+	string_map words;
+	const char* text[] = { "the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog", "then",
+		"there", "th", "", "t", "internationalization", "internationalizations", "international", "inter", "in", "lazily" };
+	for (int i = 0; i < 20; ++i)
+		words[text[i]] += i;
+	for (string_map::const_iterator it = words.begin(); it != words.end(); ++it)
+		std::cout << "[" << it->first << "]=" << it->second << " ";
+	std::cout << std::endl << "size = " << words.size() << " | count fox = " << words.count("fox")
+		<< " | count internation = " << words.count("internation") << std::endl;
+	std::cout << "lower_bound internationalizationz = " << words.lower_bound("internationalizationz")->first
+		<< " | upper_bound th = " << words.upper_bound("th")->first
+		<< " | lower_bound thenx = " << words.lower_bound("thenx")->first << std::endl;
+	print_prefix(words, "th");
+	print_prefix(words, "inter");
+	print_prefix(words, "internationali");
+	print_prefix(words, "la");
+	print_prefix(words, "x");
+	print_prefix(words, "");
+	std::cout << "erase inter = " << words.erase("inter") << " | erase internationalization = " << words.erase("internationalization")
+		<< " | erase t = " << words.erase("t") << " | erase \"\" = " << words.erase("") << std::endl;
+	print_prefix(words, "in");
+	print_prefix(words, "t");
+
+	_print("|| ------------------------ CHURN ------------------------ ||");
+	churn_type churn;
+	unsigned long checksum = 0;
+	for (unsigned long round = 0; round < 20; ++round)
+	{
+		/* dense low keys, sparse high ones: every node size */
+		for (unsigned long i = 0; i < 2000; ++i)
+			churn[(i * 7919 + round * 31) % 6007 + (i % 5 == 0 ? (i << 40) : 0)] = i + round;
+		for (unsigned long i = 0; i < 1500; ++i)
+			churn.erase((i * 104729 + round) % 6007);
+		long walked = 0;
+		unsigned long previous = 0;
+		for (churn_type::const_iterator c = churn.begin(); c != churn.end(); ++c)
+		{
+			walked += churn.count(c->first) + (c->first >= previous);
+			previous = c->first;
+		}
+		checksum = checksum * 31 + walked;
+	}
+	for (churn_type::const_iterator c = churn.begin(); c != churn.end(); ++c)
+		checksum = checksum * 31 + c->first * 7 + c->second;
+	std::cout << "size = " << churn.size() << " | checksum = " << checksum << std::endl;
+	/* top 6 bytes 0: the keys below 2^16; top 3 bytes 0, 0, 0x0a: [10 << 40, 11 << 40) */
+#if FT_ONLY
+	ft::pair<churn_type::iterator, churn_type::iterator> low = churn.prefix_range(0x1234UL, 6);
+	ft::pair<churn_type::iterator, churn_type::iterator> high = churn.prefix_range(10UL << 40, 3);
+#else
+	std::pair<churn_type::iterator, churn_type::iterator> low(churn.begin(), churn.lower_bound(1UL << 16));
+	std::pair<churn_type::iterator, churn_type::iterator> high(churn.lower_bound(10UL << 40), churn.lower_bound(11UL << 40));
+#endif
+	long in_low = 0;
+	for (; low.first != low.second; ++low.first)
+		in_low += low.first->first < (1UL << 16);
+	std::cout << "prefix low = " << in_low << " | prefix high =";
+	for (; high.first != high.second; ++high.first)
+		std::cout << " " << high.first->first << "=" << high.first->second;
+	std::cout << std::endl;
+	std::cout << "size = " << churn.size() << " | count 42 = " << churn.count(42) << std::endl;
+	return 0;
+}
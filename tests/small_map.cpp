@@ -0,0 +1,232 @@
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "../small_map.hpp"
+
+#ifndef NAMESPACE
+#define NAMESPACE ft
+#endif
+
+/* FT_ONLY is true when built against ft::. The std build has no small map:
+* it runs the same code on std::map, so both outputs must match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+/* a value whose copy throws when copies_left runs out, 0 never */
+static int copies_left = 0;
+
+struct fragile
+{
+	std::string	text;
+
+	explicit fragile(const std::string& str) : text(str) {}
+
+	fragile(const fragile& other) : text(other.text)
+	{
+		if (copies_left > 0 && --copies_left == 0)
+			throw std::runtime_error("fragile copy");
+	}
+};
+
+#if FT_ONLY
+typedef ft::small_map<int, std::string, 4>		map_type;
+typedef ft::small_map<long, long, 8>			churn_type;
+typedef ft::small_map<int, fragile, 8>			fragile_map;
+#else
+typedef std::map<int, std::string>				map_type;
+typedef std::map<long, long>					churn_type;
+typedef std::map<int, fragile>					fragile_map;
+#endif
+
+void _print(std::string str)
+{
+	std::cout << str << std::endl;
+}
+
+void print_map(const map_type& map)
+{
+	std::cout << " --> PRINT MAP  :" << std::endl;
+	for (map_type::const_iterator it = map.begin(); it != map.end(); ++it)
+		std::cout << "KEY = " << it->first << "  |  VALUE = " << it->second << std::endl;
+	std::cout << " --> MAP SIZE = " << map.size() << std::endl << std::endl;
+}
+
+/* the elements left inline, or the tree */
+void print_mode(const map_type& map)
+{
+#if FT_ONLY
+	std::cout << "tree = " << map.is_tree() << std::endl;
+#else
+	std::cout << "tree = " << (map.size() > 4) << std::endl;
+#endif
+}
+
+/* erases the keys divisible by divisor through iterators; the next one is
+* looked up again: an inline erase shifts the elements that follow */
+void erase_multiples(map_type& map, int divisor)
+{
+	for (map_type::iterator e = map.begin(); e != map.end();)
+	{
+		if (e->first % divisor == 0)
+		{
+			int next_key = e->first;
+			map.erase(e);
+			e = map.upper_bound(next_key);
+		}
+		else
+			++e;
+	}
+}
+
+int main()
+{
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
+	std::cout << "|| ---------------------- SMALL MAP --------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl
+		<< std::endl;
+
+	_print("|| ------------------- INLINE ELEMENTS ------------------- ||");
+	map_type map;
+	std::cout << "empty = " << map.empty() << " | begin == end = " << (map.begin() == map.end()) << std::endl;
+	map[3] = "three";
+	map.insert(NAMESPACE::make_pair(1, std::string("one")));
+	map.insert(map.end(), NAMESPACE::make_pair(2, std::string("two")));
+	std::cout << "insert existing = " << map.insert(NAMESPACE::make_pair(3, std::string("no"))).second << std::endl;
+	map[0];
+	print_map(map);
+	print_mode(map);
+	std::cout << "find 2 = " << map.find(2)->second << " | find 5 = " << (map.find(5) == map.end()) << std::endl;
+	std::cout << "lower_bound 2 = " << map.lower_bound(2)->first << " | upper_bound 2 = " << map.upper_bound(2)->first
+		<< " | upper_bound 3 = " << (map.upper_bound(3) == map.end()) << std::endl;
+	std::cout << "at 1 = " << map.at(1) << " | count 0 = " << map.count(0) << " | count 4 = " << map.count(4) << std::endl;
+	try
+	{
+		map.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		std::cout << "at 100 = out_of_range" << std::endl;
+	}
+	for (map_type::reverse_iterator it = map.rbegin(); it != map.rend(); ++it)
+		std::cout << it->first << " ";
+	std::cout << std::endl;
+	std::cout << "erase 1 = " << map.erase(1) << " | erase 1 = " << map.erase(1) << std::endl;
+	map.erase(map.begin());
+	print_map(map);
+	map_type inline_copy(map);
+	inline_copy[9] = "nine";
+	inline_copy.erase(++inline_copy.begin(), --inline_copy.end());
+	print_map(inline_copy);
+
+	_print("|| ------------------- TO THE TREE ----------------------- ||");
+	for (int i = 0; i < 20; ++i)
+	{
+		map[(i * 7) % 20] = std::string(i % 4 + 1, 'a' + i);
+		if (i == 1 || i == 2 || i == 3)
+			print_mode(map);
+	}
+	print_map(map);
+	map_type::iterator it = map.end();
+	--it;
+	std::cout << "last = " << it->first << " | before last = " << (--it)->first << std::endl;
+	map_type::const_iterator cit = map.begin();
+	std::cout << "const begin = " << cit->first << " | == begin " << (cit == map.begin()) << std::endl;
+	const map_type& const_tree = map;
+	const std::string& at_tree = const_tree.at(19);
+	std::cout << "const at 19 = " << at_tree << " | const at 4 = " << const_tree.at(4) << std::endl;
+	try
+	{
+		const_tree.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		std::cout << "const at 100 = out_of_range" << std::endl;
+	}
+	erase_multiples(map, 3);
+	map.erase(map.find(15), map.end());
+	print_map(map);
+	print_mode(map);
+
+	_print("|| -------------------- COPY / SWAP ---------------------- ||");
+	map_type small;
+	small[7] = "seven";
+	small[8] = "eight";
+	map_type copy(map);
+	map_type assigned;
+	assigned = small;
+	copy[100] = "copy only";
+	std::cout << "== " << (assigned == small) << " | != " << (copy != map) << " | < " << (map < copy)
+		<< " | >= " << (copy >= map) << std::endl;
+	small.swap(copy);
+	std::cout << "swapped sizes = " << small.size() << " " << copy.size() << " | " << copy.begin()->second
+		<< " " << small.rbegin()->second << std::endl;
+	assigned.swap(copy);
+	std::cout << "inline swap = " << assigned.begin()->first << " " << copy.size() << std::endl;
+	map_type ranged(map.find(4), map.find(14));
+	print_map(ranged);
+	erase_multiples(ranged, 2);
+	ranged.erase(ranged.begin(), ranged.find(11));
+	print_map(ranged);
+	map.clear();
+	std::cout << "cleared = " << map.size() << " " << map.empty() << std::endl;
+	print_mode(map);
+	map[3] = "after clear";
+	print_map(map);
+
+	_print("|| ------------------- THROWING COPIES ------------------- ||");
+	{
+		/* the third copy of the insert throws while the inline elements
+		* shift: the map must come back as it was. std::map copies once and
+		* shifts nothing, the std build prints the outcome */
+		fragile_map fragiles;
+		for (int i = 0; i < 6; ++i)
+			fragiles.insert(fragile_map::value_type(i * 10, fragile(std::string(20 + i, 'a' + i))));
+		fragile_map::value_type value(5, fragile(std::string(30, 'z')));
+		bool threw = true;
+#if FT_ONLY
+		threw = false;
+		copies_left = 3;
+		try
+		{
+			fragiles.insert(value);
+		}
+		catch (const std::runtime_error&)
+		{
+			threw = true;
+		}
+		copies_left = 0;
+#endif
+		std::cout << "threw = " << threw << " | size = " << fragiles.size() << std::endl;
+		for (fragile_map::const_iterator it = fragiles.begin(); it != fragiles.end(); ++it)
+			std::cout << it->first << " " << it->second.text << std::endl;
+		fragiles.insert(value);
+		fragiles.erase(0);
+		std::cout << "after : size = " << fragiles.size() << " | first = " << fragiles.begin()->first << std::endl;
+	}
+
+	_print("|| ------------------------ CHURN ------------------------ ||");
+	unsigned long checksum = 0;
+	for (long size = 0; size < 40; size += 3)
+	{
+		churn_type churn;
+		for (long i = 0; i < size * 3; ++i)
+			churn[(i * 7919) % (size * 2 + 1)] = i;
+		for (long i = 0; i < size; ++i)
+			churn.erase((i * 104729) % (size * 2 + 1));
+		for (churn_type::const_iterator c = churn.begin(); c != churn.end(); ++c)
+			checksum = checksum * 31 + c->first * 7 + c->second;
+		checksum += churn.size();
+	}
+	std::cout << "checksum = " << checksum << std::endl;
+#if FT_ONLY
+	std::cout << "no heap while inline = " << (ft::small_map<int, int>().memory_usage() == sizeof(ft::small_map<int, int>)) << std::endl;
+#else
+	std::cout << "no heap while inline = " << true << std::endl;
+#endif
+	return 0;
+}
@@ -0,0 +1,190 @@
+#include <cstdlib>
+#include <iostream>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../small_vector.hpp"
+#include "../stack.hpp"
+
+#ifndef NAMESPACE
+#define NAMESPACE ft
+#endif
+
+/* FT_ONLY is true when built against ft::. The std build has no small
+* vector: it runs the same code on std::vector, so both outputs must match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+#if FT_ONLY
+typedef ft::small_vector<int, 8>				vector_type;
+typedef ft::small_vector<std::string, 4>		string_vector;
+typedef ft::stack<int, vector_type>				stack_type;
+typedef ft::vector<int, vector_type::allocator_type>	base_type;
+#else
+typedef std::vector<int>						vector_type;
+typedef std::vector<std::string>				string_vector;
+typedef std::stack<int, vector_type>			stack_type;
+typedef std::vector<int>						base_type;
+#endif
+
+void _print(std::string str)
+{
+	std::cout << str << std::endl;
+}
+
+template <typename Vector>
+void print_vector(const Vector& v)
+{
+	std::cout << " --> PRINT VECTOR :";
+	for (typename Vector::const_iterator it = v.begin(); it != v.end(); ++it)
+		std::cout << " " << *it;
+	std::cout << std::endl << " --> SIZE = " << v.size() << std::endl << std::endl;
+}
+
+/* the std build predicts it: inline until the size first passes N */
+template <typename Vector>
+void print_mode(const Vector& v, bool spilled)
+{
+#if FT_ONLY
+	std::cout << "inline = " << v.is_inline() << std::endl;
+	(void)spilled;
+#else
+	(void)v;
+	std::cout << "inline = " << !spilled << std::endl;
+#endif
+}
+
+int main()
+{
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
+	std::cout << "|| --------------------- SMALL VECTOR ------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl
+		<< std::endl;
+
+	_print("|| ---------------------- INLINE ------------------------- ||");
+	vector_type v;
+	std::cout << "empty = " << v.empty() << " | begin == end = " << (v.begin() == v.end()) << std::endl;
+	for (int i = 0; i < 6; ++i)
+		v.push_back(i * 3);
+	v.insert(v.begin() + 2, 100);
+	v.push_back(v[0]);
+	v.erase(v.begin() + 4);
+	v.insert(v.begin(), v.back());
+	print_vector(v);
+	print_mode(v, false);
+	std::cout << "front = " << v.front() << " | back = " << v.back() << " | at 3 = " << v.at(3) << std::endl;
+	try
+	{
+		v.at(40);
+	}
+	catch (const std::out_of_range&)
+	{
+		std::cout << "at 40 = out_of_range" << std::endl;
+	}
+
+	_print("|| ---------------------- SPILL -------------------------- ||");
+	v.insert(v.begin() + 1, 3, v[2]);
+	v.push_back(-1);
+	print_vector(v);
+	print_mode(v, true);
+	v.erase(v.begin() + 2, v.end() - 3);
+	v.resize(12, 7);
+	print_vector(v);
+	print_mode(v, true);
+	vector_type shrinking(20, 4);
+	shrinking.resize(5);
+	shrinking.shrink_to_fit();
+	shrinking.push_back(6);
+	print_vector(shrinking);
+	print_mode(shrinking, false);
+	vector_type back_inline(v.begin(), v.begin() + 5);
+	print_vector(back_inline);
+	print_mode(back_inline, false);
+
+	_print("|| ----------------- COPY / ASSIGN / SWAP ---------------- ||");
+	vector_type small(4, 9);
+	vector_type big(v);
+	vector_type copy(small);
+	copy.push_back(10);
+	print_vector(copy);
+	print_mode(copy, false);
+	big.swap(small);
+	print_vector(big);
+	print_vector(small);
+	print_mode(big, true);
+	vector_type other(20, 2);
+	other.swap(small);
+	print_vector(other);
+	swap(other, copy);
+	print_vector(other);
+	print_vector(copy);
+	copy = v;
+	v = back_inline;
+	print_vector(copy);
+	print_vector(v);
+	v.assign(30, 5);
+	v.assign(3, 6);
+	print_vector(v);
+	v.clear();
+	std::cout << "cleared = " << v.size() << " " << v.empty() << std::endl;
+
+	_print("|| ----------------- COPY THROUGH THE BASE --------------- ||");
+	{
+		/* the copy must not take the inline buffer of a small_vector that
+		* has spilled: it goes away with it */
+		base_type* outlives;
+		{
+			vector_type spilled(20, 3);
+			spilled.erase(spilled.begin() + 5, spilled.end());
+			const base_type& base = spilled;
+			outlives = new base_type(base);
+		}
+		vector_type reuse(8, 1);
+		print_vector(*outlives);
+		print_vector(reuse);
+		delete outlives;
+	}
+
+	_print("|| --------------------- COMPARISON ---------------------- ||");
+	vector_type a(3, 1);
+	vector_type b(a);
+	std::cout << "a == b " << (a == b) << " | a != b " << (a != b) << " | a < b " << (a < b) << std::endl;
+	b.push_back(0);
+	std::cout << "a < b " << (a < b) << " | a <= b " << (a <= b) << " | a > b " << (a > b)
+		<< " | a >= b " << (a >= b) << std::endl;
+	b[0] = 0;
+	std::cout << "a < b " << (a < b) << " | a > b " << (a > b) << std::endl;
+
+	_print("|| ------------------------ STRINGS ---------------------- ||");
+	string_vector words;
+	for (int i = 0; i < 10; ++i)
+	{
+		words.push_back(std::string(i % 3 + 1, 'a' + i));
+		if (i % 4 == 3)
+			words.insert(words.begin() + 1, words[i / 2]);
+	}
+	words.erase(words.begin() + 3);
+	print_vector(words);
+	string_vector few(words.begin(), words.begin() + 3);
+	few.swap(words);
+	print_vector(few);
+	print_vector(words);
+
+	_print("|| ------------------------- STACK ----------------------- ||");
+	stack_type s;
+	for (int i = 0; i < 12; ++i)
+		s.push(i * i);
+	stack_type t(s);
+	for (int i = 0; i < 6; ++i)
+		s.pop();
+	std::cout << "top = " << s.top() << " | size = " << s.size() << " | copy top = " << t.top()
+		<< " | s < t " << (s < t) << " | s == t " << (s == t) << std::endl;
+	while (!t.empty())
+		t.pop();
+	std::cout << "emptied = " << t.empty() << std::endl;
+	return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef TEST_ARENA_HPP
+#define TEST_ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+* A stateful allocator for the tests of allocator-aware containers, built
+* the same way for ft:: and std::.
+*
+* Each test_arena hands out memory from 64 KB chunks by bumping a pointer
+* and gives it all back when it is destroyed: deallocate() only counts. A
+* block given back to an arena that did not allocate it counts as foreign:
+* a container that mixed up its allocators. Both counters must end at 0.
+*/
+
+class test_arena
+{
+	public:
+		explicit test_arena(const char* name) : _name(name), _live(0), _foreign(0), _cursor(NULL), _left(0) {}
+
+		~test_arena()
+		{
+			for (std::size_t i = 0; i < _chunks.size(); ++i)
+				::operator delete(_chunks[i].first);
+		}
+
+		void* allocate(std::size_t bytes)
+		{
+			bytes = (bytes + 15) & ~static_cast<std::size_t>(15);
+			if (bytes > _left)
+			{
+				std::size_t size = bytes > chunk_size ? bytes : chunk_size;
+				_cursor = static_cast<char*>(::operator new(size));
+				_chunks.push_back(std::make_pair(_cursor, size));
+				_left = size;
+			}
+			void* p = _cursor;
+			_cursor += bytes;
+			_left -= bytes;
+			++_live;
+			return p;
+		}
+
+		void deallocate(void* p)
+		{
+			if (owns(p))
+				--_live;
+			else
+				++_foreign;
+		}
+
+		const char* name() const { return _name; }
+		long live() const { return _live; }
+		long foreign() const { return _foreign; }
+
+	private:
+		static const std::size_t					chunk_size = 64 * 1024;
+
+		const char*									_name;
+		long										_live;
+		long										_foreign;
+		char*										_cursor;
+		std::size_t									_left;
+		std::vector<std::pair<char*, std::size_t> >	_chunks;
+
+		bool owns(const void* p) const
+		{
+			const char* c = static_cast<const char*>(p);
+			for (std::size_t i = 0; i < _chunks.size(); ++i)
+				if (c >= _chunks[i].first && c < _chunks[i].first + _chunks[i].second)
+					return true;
+			return false;
+		}
+
+		test_arena(const test_arena&);
+		test_arena& operator=(const test_arena&);
+};
+
+/* Propagate: whether the allocator follows the elements on copy assignment and swap */
+template <typename T, bool Propagate = false>
+class test_arena_allocator
+{
+	public:
+		typedef T											value_type;
+		typedef T*											pointer;
+		typedef const T*									const_pointer;
+		typedef T&											reference;
+		typedef const T&									const_reference;
+		typedef std::size_t									size_type;
+		typedef std::ptrdiff_t								difference_type;
+		typedef std::integral_constant<bool, Propagate>		propagate_on_container_copy_assignment;
+		typedef std::integral_constant<bool, Propagate>		propagate_on_container_swap;
+		typedef std::integral_constant<bool, Propagate>		propagate_on_container_move_assignment;
+
+		template <typename U>
+		struct rebind { typedef test_arena_allocator<U, Propagate> other; };
+
+		test_arena*		arena;
+
+		test_arena_allocator() : arena(NULL) {}
+		explicit test_arena_allocator(test_arena& a) : arena(&a) {}
+		template <typename U>
+		test_arena_allocator(const test_arena_allocator<U, Propagate>& other) : arena(other.arena) {}
+
+		pointer allocate(size_type n, const void* = 0)
+		{
+			if (!arena)
+				throw std::bad_alloc();
+			return static_cast<pointer>(arena->allocate(n * sizeof(T)));
+		}
+
+		void deallocate(pointer p, size_type)
+		{
+			arena->deallocate(p);
+		}
+
+		size_type max_size() const { return (static_cast<size_type>(-1) / 2) / sizeof(T); }
+
+		void construct(pointer p, const T& value) { new (static_cast<void*>(p)) T(value); }
+		void destroy(pointer p) { p->~T(); }
+
+		const char* name() const { return arena ? arena->name() : "none"; }
+};
+
+template <typename T, typename U, bool P>
+inline bool operator==(const test_arena_allocator<T, P>& lhs, const test_arena_allocator<U, P>& rhs)
+{
+	return lhs.arena == rhs.arena;
+}
+
+template <typename T, typename U, bool P>
+inline bool operator!=(const test_arena_allocator<T, P>& lhs, const test_arena_allocator<U, P>& rhs)
+{
+	return lhs.arena != rhs.arena;
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "../unordered_map.hpp"
+
+#ifndef NAMESPACE
+#define NAMESPACE ft
+#endif
+
+/* FT_ONLY is true when built against ft::. The std build has no unordered
+* map in C++98: it runs the same code on std::map and both outputs are
+* printed in key order, so they must match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
+#if FT_ONLY
+typedef ft::unordered_map<int, std::string>			map_type;
+typedef ft::unordered_map<std::string, long>		string_map;
+typedef ft::unordered_map<long, long>				churn_type;
+#else
+typedef std::map<int, std::string>					map_type;
+typedef std::map<std::string, long>					string_map;
+typedef std::map<long, long>						churn_type;
+#endif
+
+void _print(std::string str)
+{
+	std::cout << str << std::endl;
+}
+
+/* in key order, whatever the order of the map */
+void print_map(const map_type& map)
+{
+	std::map<int, std::string> sorted;
+	for (map_type::const_iterator it = map.begin(); it != map.end(); ++it)
+		sorted[it->first] = it->second;
+	std::cout << " --> PRINT MAP  :" << std::endl;
+	for (std::map<int, std::string>::const_iterator it = sorted.begin(); it != sorted.end(); ++it)
+		std::cout << "KEY = " << it->first << "  |  VALUE = " << it->second << std::endl;
+	std::cout << " --> MAP SIZE = " << map.size() << " | walked = " << sorted.size() << std::endl << std::endl;
+}
+
+int main()
+{
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
+	std::cout << "|| -------------------- UNORDERED MAP ------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------ ||" << std::endl
+		<< std::endl;
+
+	_print("|| ------------------ INSERT / OPERATOR[] ----------------- ||");
+	map_type map;
+	std::cout << "empty = " << map.empty() << " | begin == end = " << (map.begin() == map.end()) << std::endl;
+	for (int i = 0; i < 40; ++i)
+		map.insert(NAMESPACE::make_pair((i * 7) % 40, std::string(i % 4 + 1, 'a' + i % 26)));
+	std::cout << "insert existing = " << map.insert(NAMESPACE::make_pair(7, std::string("no"))).second
+		<< " | new = " << map.insert(NAMESPACE::make_pair(-7, std::string("minus seven"))).second << std::endl;
+	map[45] = "forty-five";
+	map[-3];
+	map.insert(map.end(), NAMESPACE::make_pair(50, std::string("hint")));
+	print_map(map);
+
+	_print("|| ----------------------- LOOK-UP ----------------------- ||");
+	std::cout << "find 12 = " << map.find(12)->second << " | find 41 = " << (map.find(41) == map.end()) << std::endl;
+	std::cout << "count 45 = " << map.count(45) << " | count 46 = " << map.count(46) << std::endl;
+	std::cout << "equal_range 5 = " << map.equal_range(5).first->second << " "
+		<< (map.equal_range(41).first == map.equal_range(41).second) << std::endl;
+	std::cout << "at 0 = " << map.at(0) << std::endl;
+	try
+	{
+		map.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		std::cout << "at 100 = out_of_range" << std::endl;
+	}
+	const map_type& cmap = map;
+	std::cout << "const find -3 = [" << cmap.find(-3)->second << "] | const at 45 = " << cmap.at(45) << std::endl;
+
+	_print("|| ------------------------ ERASE ------------------------ ||");
+	std::cout << "erase 7 = " << map.erase(7) << " | erase 7 = " << map.erase(7) << std::endl;
+	for (map_type::iterator e = map.begin(); e != map.end();)
+	{
+		if (e->first % 3 == 0)
+			map.erase(e++);
+		else
+			++e;
+	}
+	map.erase(map.find(50));
+	print_map(map);
+
+	_print("|| -------------------- COPY / SWAP ---------------------- ||");
+	map_type copy(map);
+	map_type assigned;
+	assigned = map;
+	copy[100] = "copy only";
+	std::cout << "== " << (assigned == map) << " | != " << (copy != map) << std::endl;
+	map_type other;
+	other[1] = "alone";
+	other.swap(copy);
+	std::cout << "swapped sizes = " << other.size() << " " << copy.size() << " | " << copy.begin()->second << std::endl;
+	map_type ranged(map.begin(), map.end());
+	std::cout << "ranged == map = " << (ranged == map) << std::endl;
+	map.clear();
+	std::cout << "cleared = " << map.size() << " " << map.empty() << " " << (map.begin() == map.end()) << std::endl;
+	map[3] = "after clear";
+	print_map(map);
+
+	_print("|| --------------------- STRING KEYS --------------------- ||");
+	string_map words;
+	const char* text[] = { "the", "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog", "the", "end" };
+	for (int i = 0; i < 11; ++i)
+		words[text[i]] += i;
+	std::map<std::string, long> sorted_words;
+	for (string_map::const_iterator it = words.begin(); it != words.end(); ++it)
+		sorted_words[it->first] = it->second;
+	for (std::map<std::string, long>::const_iterator it = sorted_words.begin(); it != sorted_words.end(); ++it)
+		std::cout << it->first << "=" << it->second << " ";
+	std::cout << std::endl << "size = " << words.size() << " | count fox = " << words.count("fox") << std::endl;
+
+	_print("|| ------------------------ CHURN ------------------------ ||");
+	churn_type churn;
+	unsigned long checksum = 0;
+	for (long round = 0; round < 20; ++round)
+	{
+		for (long i = 0; i < 2000; ++i)
+			churn[(i * 7919 + round * 31) % 6007] = i + round;
+		for (long i = 0; i < 1500; ++i)
+			churn.erase((i * 104729 + round) % 6007);
+		/* every element is reachable, also while the table grows */
+		long walked = 0;
+		for (churn_type::const_iterator c = churn.begin(); c != churn.end(); ++c)
+			walked += churn.count(c->first);
+		checksum = checksum * 31 + walked;
+	}
+	std::map<long, long> sorted_churn;
+	for (churn_type::const_iterator c = churn.begin(); c != churn.end(); ++c)
+		sorted_churn[c->first] = c->second;
+	for (std::map<long, long>::const_iterator c = sorted_churn.begin(); c != sorted_churn.end(); ++c)
+		checksum = checksum * 31 + c->first * 7 + c->second;
+	std::cout << "size = " << churn.size() << " | checksum = " << checksum << std::endl;
+#if FT_ONLY
+	churn.rehash(0);
+	std::cout << "load after rehash(0) <= max = " << (churn.load_factor() <= churn.max_load_factor())
+		<< " | migrating = " << churn.is_migrating() << std::endl;
+	churn.reserve(20000);
+	std::cout << "reserved = " << (churn.bucket_count() >= 20000) << std::endl;
+#else
+	std::cout << "load after rehash(0) <= max = " << true << " | migrating = " << false << std::endl;
+	std::cout << "reserved = " << true << std::endl;
+#endif
+	std::cout << "size = " << churn.size() << " | count 42 = " << churn.count(42) << std::endl;
+	return 0;
+}
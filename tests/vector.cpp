@@ -1,18 +1,36 @@
 
+/* the stats section reads the optional counters as well */
+#define FT_VECTOR_COUNTERS
+
 #include "../vector.hpp"
+#include "../allocator.hpp"
+#include "../arena.hpp"
+#include "../vector_trim.hpp"
+#include "test_arena.hpp"
 
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <exception>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <list>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #ifndef NAMESPACE
 #define NAMESPACE ft
 #endif
 
+/* FT_ONLY is true when built against ft::, for the extensions std:: lacks;
+* the std build computes the same figures by other means so that the outputs match */
+#define FT_ONLY_ft 1
+#define FT_ONLY_CAT(a, b) a ## b
+#define FT_ONLY_XCAT(a, b) FT_ONLY_CAT(a, b)
+#define FT_ONLY FT_ONLY_XCAT(FT_ONLY_, NAMESPACE)
+
 template<typename T>
 void comparisons(NAMESPACE::vector<T>& lhs, NAMESPACE::vector<T>& rhs)
 {
@@ -65,11 +83,123 @@ NAMESPACE::vector<int> fill_vector()
 	return vec;
 }
 
+struct point
+{
+	int		x;
+	double	y;
+};
+
+point make_point(int i)
+{
+	point p;
+	std::memset(&p, 0, sizeof(p));
+	p.x = i;
+	p.y = i * 0.5;
+	return p;
+}
+
+/* a value whose copy throws when copies_left runs out, 0 never */
+static int copies_left = 0;
+
+struct fragile
+{
+	std::string	text;
+
+	explicit fragile(const std::string& str) : text(str) {}
+
+	fragile(const fragile& other) : text(other.text)
+	{
+		if (copies_left > 0 && --copies_left == 0)
+			throw std::runtime_error("fragile copy");
+	}
+};
+
 void _print(std::string str)
 {
 	std::cout << str << std::endl;
 }
 
+
+/* std::vector has no shrink_to: the std build copies into an exact reserve */
+template <typename Vector>
+void shrink_to(Vector& v, std::size_t n)
+{
+#if FT_ONLY
+	v.shrink_to(n);
+#else
+	std::size_t len = std::max(n, v.size());
+	if (len < v.capacity())
+	{
+		Vector tmp;
+		tmp.reserve(len);
+		tmp.assign(v.begin(), v.end());
+		tmp.swap(v);
+	}
+#endif
+}
+
+/* the std build value-initializes the new elements, overwritten right after */
+template <typename Vector>
+void resize_default_init(Vector& v, std::size_t n)
+{
+#if FT_ONLY
+	v.resize_default_init(n);
+#else
+	v.resize(n);
+#endif
+}
+
+/* swap of two vectors whose allocators differ and stay: ft:: copies the
+* elements, std:: leaves it undefined, so the std build copies by hand */
+template <typename Vector>
+void swap_elements(Vector& a, Vector& b)
+{
+#if FT_ONLY
+	a.swap(b);
+#else
+	Vector mine(b.begin(), b.end(), a.get_allocator());
+	Vector theirs(a.begin(), a.end(), b.get_allocator());
+	a.swap(mine);
+	b.swap(theirs);
+#endif
+}
+
+/* push_backs then a reserve under a growth policy; the std build replays
+* the policy's capacities to get the same figures */
+template <typename Growth>
+void growth_report(const char* name)
+{
+	std::size_t capacity = 0, reallocations = 0, copied = 0, peak = 0;
+#if FT_ONLY
+	ft::vector<double, std::allocator<double>, Growth> v;
+	for (int i = 0; i < 1000; ++i)
+		v.push_back(i);
+	v.reserve(5000);
+	ft::vector_stats stats = v.stats();
+	capacity = stats.capacity;
+	reallocations = stats.reallocations;
+	copied = stats.bytes_copied;
+	peak = stats.peak_capacity;
+#else
+	const std::size_t max = std::vector<double>().max_size();
+	for (std::size_t size = 0; size < 1000; ++size)
+	{
+		if (size == capacity)
+		{
+			copied += size * sizeof(double);
+			capacity = Growth::next_capacity(capacity, size + 1, max, sizeof(double));
+			++reallocations;
+		}
+	}
+	copied += 1000 * sizeof(double);
+	peak = 5000;
+	capacity = std::max(capacity, peak);
+	reallocations += 1;
+#endif
+	std::cout << name << " : capacity = " << capacity << " | reallocations = " << reallocations
+		<< " | bytes copied = " << copied << " | peak capacity = " << peak << std::endl;
+}
+
 int main()
 {
 	std::cout << "|| ------------------------------------------------------ ||" << std::endl;
@@ -418,4 +548,375 @@ int main()
 		comparisons(lhs, rhs);
 		std::cout << std::endl;
 	}
+
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ------------------------ STATS ------------------------ ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::vector<double> v;
+		std::size_t buffers = 0;
+		for (int i = 0; i < 1000; ++i)
+		{
+			const double* old = v.data();
+			v.push_back(i);
+			buffers += (v.data() != old);
+		}
+		v.resize(300);
+#if FT_ONLY
+		ft::vector_stats stats = v.stats();
+		std::cout << "size = " << stats.size << " | capacity = " << stats.capacity << std::endl;
+		std::cout << "bytes reserved = " << stats.bytes_reserved << " | used = " << stats.bytes_used
+			<< " | slack = " << stats.bytes_slack << std::endl;
+		std::cout << "reallocations = " << stats.reallocations << std::endl;
+		std::cout << "memory usage = " << v.memory_usage() - sizeof(v) << std::endl;
+#else
+		std::cout << "size = " << v.size() << " | capacity = " << v.capacity() << std::endl;
+		std::cout << "bytes reserved = " << v.capacity() * sizeof(double) << " | used = " << v.size() * sizeof(double)
+			<< " | slack = " << (v.capacity() - v.size()) * sizeof(double) << std::endl;
+		std::cout << "reallocations = " << buffers << std::endl;
+		std::cout << "memory usage = " << v.capacity() * sizeof(double) << std::endl;
+#endif
+	}
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ------------------------ SHRINK ----------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::vector<int> v;
+		for (int i = 0; i < 1000; ++i)
+			v.push_back(i);
+		v.resize(10);
+		v.shrink_to_fit();
+		std::cout << "shrink_to_fit : size = " << v.size() << " | capacity = " << v.capacity() << " | back = " << v.back() << std::endl;
+		v.reserve(500);
+		shrink_to(v, 100);
+		std::cout << "shrink_to 100 : capacity = " << v.capacity() << std::endl;
+		shrink_to(v, 400);
+		shrink_to(v, 3);
+		std::cout << "shrink_to 400, 3 : capacity = " << v.capacity() << " | v[4] = " << v[4] << std::endl;
+		v.clear();
+		v.shrink_to_fit();
+		std::cout << "empty : capacity = " << v.capacity() << std::endl;
+		v.push_back(8);
+		std::cout << "push_back after : " << v[0] << " " << v.capacity() << std::endl;
+
+		NAMESPACE::vector<std::string> words(40, "word");
+		words.erase(words.begin() + 3, words.end());
+		words[1] = "other";
+		words.shrink_to_fit();
+		std::cout << "strings : " << words[0] << " " << words[1] << " " << words[2] << " | capacity = " << words.capacity() << std::endl;
+
+#if FT_ONLY
+		typedef ft::vector<long, ft::realloc_allocator<long> >	remap_vector;
+#else
+		typedef std::vector<long>								remap_vector;
+#endif
+		remap_vector big;
+		for (long i = 0; i < 300000; ++i)
+			big.push_back(i * 7);
+		shrink_to(big, 200000);
+		std::cout << "remapped : capacity = " << big.capacity() << " | back = " << big.back();
+		big.resize(1000);
+		big.shrink_to_fit();
+		std::cout << " | shrunk = " << big.capacity() << " | back = " << big.back() << std::endl;
+	}
+	{
+		/* the same registry drives std::vector in the std build */
+		ft::trim_registry& registry = ft::trim_registry::instance();
+		{
+			NAMESPACE::vector<long> a(10000, 1);
+			NAMESPACE::vector<long> b;
+			NAMESPACE::vector<long> c(100, 3);
+			ft::trim_registration<NAMESPACE::vector<long> > ra(a), rb(b), rc(c);
+			for (long i = 0; i < 10000; ++i)
+				b.push_back(i);
+			a.clear();
+			a.push_back(1);
+			b.resize(5000);
+			c.clear();
+			std::size_t first = registry.trim(4096);
+			b.push_back(3);
+			std::size_t second = registry.trim(4096);
+			std::size_t third = registry.trim(4096);
+			std::cout << "trim : registered = " << registry.size() << " | released = " << first << " " << second << " " << third
+				<< " | capacities = " << a.capacity() << " " << b.capacity() << " " << c.capacity() << std::endl;
+		}
+		std::cout << "trim : registered after = " << registry.size() << std::endl;
+	}
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ----------------- UNINITIALIZED RESIZE ---------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		NAMESPACE::vector<char> buffer;
+		const char text[] = "filled in place";
+		resize_default_init(buffer, sizeof(text) - 1);
+		std::memcpy(&buffer[0], text, sizeof(text) - 1);
+		std::size_t old_size = buffer.size();
+		resize_default_init(buffer, old_size + 3000);
+		std::memset(&buffer[old_size], '.', 3000);
+		resize_default_init(buffer, old_size + 2);
+		std::cout << "buffer = " << std::string(buffer.begin(), buffer.end()) << " | size = " << buffer.size() << std::endl;
+
+		NAMESPACE::vector<point> points(3, make_point(2));
+		resize_default_init(points, 50);
+		for (std::size_t i = 3; i < points.size(); ++i)
+			points[i] = make_point(i);
+		points.push_back(make_point(-4));
+		std::cout << "points = " << points[0].x << " " << points[2].x << " " << points[3].x << " " << points[49].x
+			<< " " << points.back().x << " | size = " << points.size() << std::endl;
+	}
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ------------------- ALIGNED ALLOCATOR ----------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		/* ft::aligned_allocator serves both builds */
+		typedef ft::aligned_allocator<float, 64>												simd_allocator;
+		typedef ft::aligned_allocator<long, 64, ft::alloc_huge_pages | ft::alloc_prefault>		table_allocator;
+		NAMESPACE::vector<float, simd_allocator> lanes;
+		bool aligned = true;
+		for (int i = 0; i < 1000; ++i)
+		{
+			lanes.push_back(i * 0.5f);
+			aligned = aligned && reinterpret_cast<std::size_t>(lanes.data()) % 64 == 0;
+		}
+		NAMESPACE::vector<float, simd_allocator> copy(lanes.begin() + 10, lanes.end());
+		aligned = aligned && reinterpret_cast<std::size_t>(copy.data()) % 64 == 0;
+		std::cout << "lanes : " << lanes[999] << " " << copy[0] << " | aligned on 64 = " << aligned
+			<< " | get_allocator = " << (lanes.get_allocator() == simd_allocator()) << std::endl;
+
+		NAMESPACE::vector<long, table_allocator> table(1 << 19, 1);
+		table[12345] = 7;
+		std::cout << "table : " << table.size() << " " << table[12345] << " " << table.back()
+			<< " | aligned on 2 MB = " << (reinterpret_cast<std::size_t>(table.data()) % (2 << 20) == 0) << std::endl;
+	}
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ------------------ STATEFUL ALLOCATOR ----------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		test_arena red("red"), blue("blue");
+		{
+			/* the allocator stays with its vector */
+			typedef test_arena_allocator<int>					kept;
+			typedef NAMESPACE::vector<int, kept>			kept_vector;
+			kept_vector a((kept(red)));
+			kept_vector b((kept(blue)));
+			for (int i = 0; i < 100; ++i)
+				a.push_back(i);
+			b.assign(30, 7);
+			kept_vector c(a);
+			std::cout << "copy : " << c.get_allocator().name() << " " << c.size() << " " << c[99] << std::endl;
+			c = b;
+			std::cout << "assign : " << c.get_allocator().name() << " " << c.size() << " " << c[0] << std::endl;
+			swap_elements(a, b);
+			std::cout << "swap : " << a.get_allocator().name() << " " << a.size() << " " << a[0]
+				<< " | " << b.get_allocator().name() << " " << b.size() << " " << b[99] << std::endl;
+			a.insert(a.begin(), b.begin(), b.begin() + 50);
+			a.swap(c);
+			std::cout << "equal swap : " << a.get_allocator().name() << " " << a.size() << " " << c.size()
+				<< " | max_size = " << (a.max_size() == kept(red).max_size()) << std::endl;
+
+			/* the allocator follows the elements */
+			typedef test_arena_allocator<int, true>				moving;
+			typedef NAMESPACE::vector<int, moving>			moving_vector;
+			moving_vector d(10, 1, moving(red));
+			moving_vector e(20, 2, moving(blue));
+			d = e;
+			std::cout << "propagated assign : " << d.get_allocator().name() << " " << d.size() << std::endl;
+			moving_vector f(5, 3, moving(red));
+			f.swap(d);
+			std::cout << "propagated swap : " << f.get_allocator().name() << " " << f.size()
+				<< " | " << d.get_allocator().name() << " " << d.size() << std::endl;
+			d.push_back(4);
+			f.clear();
+		}
+		std::cout << "red : live " << red.live() << " foreign " << red.foreign()
+			<< " | blue : live " << blue.live() << " foreign " << blue.foreign() << std::endl;
+	}
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| ------------------------- ARENA ----------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		/* ft::arena serves both builds: two identical requests, the second
+		* one on the chunks of the first */
+		typedef ft::arena_allocator<int>						int_allocator;
+		typedef ft::arena_allocator<std::string>				string_allocator;
+		ft::arena arena(4096);
+		ft::arena::size_type reserved[2];
+		for (int request = 0; request < 2; ++request)
+		{
+			{
+				NAMESPACE::vector<int, int_allocator> ids((int_allocator(arena)));
+				NAMESPACE::vector<std::string, string_allocator> names((string_allocator(arena)));
+				for (int i = 0; i < 3000; ++i)
+					ids.push_back(i * 7);
+				for (int i = 0; i < 40; ++i)
+					names.push_back(std::string(i % 4 + 1, 'a' + i % 26));
+				ids.erase(ids.begin() + 10, ids.end() - 10);
+				NAMESPACE::vector<int, int_allocator> copy(ids);
+				copy.insert(copy.begin() + 5, 3, -1);
+				std::cout << "request " << request << " : " << ids.size() << " " << ids[12] << " " << copy[6]
+					<< " " << names[37] << " | same arena = " << (copy.get_allocator() == ids.get_allocator())
+					<< " " << (names.get_allocator().get_arena() == &arena) << std::endl;
+			}
+			reserved[request] = arena.bytes_reserved();
+			arena.reset();
+		}
+		std::cout << "reset : allocated = " << arena.bytes_allocated() << " | chunks reused = "
+			<< (reserved[1] == reserved[0]) << std::endl;
+		try
+		{
+			NAMESPACE::vector<int, int_allocator> detached;
+			detached.push_back(1);
+		}
+		catch (const std::bad_alloc&)
+		{
+			std::cout << "no arena : bad_alloc" << std::endl;
+		}
+		arena.release();
+		std::cout << "release : chunks = " << arena.chunks() << " | reserved = " << arena.bytes_reserved() << std::endl;
+	}
+	{
+		/* the bump pointer itself */
+		ft::arena arena(1024);
+		char* a = static_cast<char*>(arena.allocate(10, 1));
+		void* b = arena.allocate(8, 64);
+		void* big = arena.allocate(5000, 16);
+		void* c = arena.allocate(24);
+		std::cout << "aligned = " << (reinterpret_cast<std::size_t>(b) % 64 == 0)
+			<< " " << (reinterpret_cast<std::size_t>(big) % 16 == 0) << " " << (reinterpret_cast<std::size_t>(c) % 16 == 0)
+			<< " | chunks = " << arena.chunks() << " | allocated = " << arena.bytes_allocated() << std::endl;
+		bool grew = arena.extend(c, 24, 100);
+		bool moved = arena.extend(a, 10, 20);
+		arena.deallocate(c, 100);
+		std::cout << "extend last = " << grew << " | extend other = " << moved << " | allocated = "
+			<< arena.bytes_allocated() << " | same block = " << (arena.allocate(8) == c) << std::endl;
+		arena.reset();
+		std::cout << "reset : chunks = " << arena.chunks() << " | first block again = " << (arena.allocate(10, 1) == a)
+			<< std::endl;
+	}
+	{
+		/* a chunk of its own ends where its block ends: the padding of a
+		* stricter alignment after it must move to a new chunk */
+		ft::arena arena(1024);
+		char* odd = static_cast<char*>(arena.allocate(100001, 1));
+		char* strict = static_cast<char*>(arena.allocate(8, 64));
+		std::cout << "mixed alignment : aligned = " << (reinterpret_cast<std::size_t>(strict) % 64 == 0)
+			<< " | outside the first block = " << (strict >= odd + 100001 || strict + 8 <= odd)
+			<< " | chunks = " << arena.chunks() << std::endl;
+		arena.reset();
+
+		NAMESPACE::vector<char, ft::arena_allocator<char> > bytes((ft::arena_allocator<char>(arena)));
+		bytes.reserve(100001);
+		bytes.assign(100001, 'b');
+		NAMESPACE::vector<long double, ft::arena_allocator<long double> > wide((ft::arena_allocator<long double>(arena)));
+		for (int i = 0; i < 100; ++i)
+			wide.push_back(i * 0.25L);
+		std::cout << "mixed alignment : " << bytes.back() << " " << static_cast<double>(wide[99]) << " | aligned = "
+			<< (reinterpret_cast<std::size_t>(wide.data()) % __alignof__(long double) == 0) << std::endl;
+	}
+	growth_report<ft::growth_double>("double");
+	growth_report<ft::growth_golden>("golden");
+	growth_report<ft::growth_size_class>("size class");
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl;
+	std::cout << "|| --------------------- TRIVIAL TYPES ------------------- ||" << std::endl;
+	std::cout << "|| ------------------------------------------------------- ||" << std::endl
+		<< std::endl;
+	{
+		/* copied with memcpy / memmove by ft::vector */
+		NAMESPACE::vector<point> v;
+		for (int i = 0; i < 20; ++i)
+			v.push_back(make_point(i));
+		v.insert(v.begin() + 3, 4, make_point(100));
+		NAMESPACE::vector<point> other(v.begin() + 10, v.end());
+		v.insert(v.begin() + 1, other.begin(), other.end());
+		v.insert(v.begin() + 2, other.begin() + 2, other.begin() + 7);
+		v.erase(v.begin() + 5);
+		v.erase(v.begin() + 7, v.begin() + 12);
+		NAMESPACE::vector<point> copy(v);
+		copy.reserve(copy.capacity() * 3);
+		copy.resize(copy.size() + 3, make_point(-1));
+		std::cout << "points :";
+		for (std::size_t i = 0; i < copy.size(); ++i)
+			std::cout << " " << copy[i].x << "/" << copy[i].y;
+		std::cout << std::endl << "size = " << copy.size() << " | equal prefix = "
+			<< (std::memcmp(&copy[0], &v[0], v.size() * sizeof(point)) == 0) << std::endl;
+	}
+	{
+		/* grows with realloc, then mremap past a megabyte */
+#if FT_ONLY
+		typedef ft::vector<long, ft::realloc_allocator<long> >	remap_vector;
+#else
+		typedef std::vector<long>								remap_vector;
+#endif
+		remap_vector v;
+		for (long i = 0; i < 300000; ++i)
+		{
+			if (i > 0 && v.size() == v.capacity() && i % 3 == 0)
+				v.push_back(v[i / 2]);
+			else
+				v.push_back(i);
+		}
+		v.insert(v.begin() + 7, 200000, v[5]);
+		v.reserve(v.capacity() + 1);
+		remap_vector other(v.begin() + 1000, v.begin() + 5000);
+		v.insert(v.begin() + 3, other.begin(), other.end());
+		v.resize(v.capacity() + 10, -3);
+		unsigned long checksum = 0;
+		for (std::size_t i = 0; i < v.size(); ++i)
+			checksum = checksum * 31 + v[i];
+		std::cout << "remapped size = " << v.size() << " | checksum = " << checksum
+			<< " | back = " << v.back() << " | v[7] = " << v[7] << std::endl;
+	}
+	{
+		/* push_back of one of the elements, each time the vector is full */
+		NAMESPACE::vector<std::string> words(1, "first");
+		NAMESPACE::vector<point> points(1, make_point(1));
+		for (int i = 0; i < 40; ++i)
+		{
+			/* an lvalue on one branch: a ?: would pass a copy */
+			if (words.size() == words.capacity())
+				words.push_back(words[i / 2]);
+			else
+				words.push_back(std::string(i % 5 + 1, 'a' + i % 26));
+			if (points.size() == points.capacity())
+				points.push_back(points[i / 3]);
+			else
+				points.push_back(make_point(i));
+		}
+		std::cout << "aliased words :";
+		for (std::size_t i = 0; i < words.size(); ++i)
+			std::cout << " " << words[i];
+		std::cout << std::endl << "aliased points :";
+		for (std::size_t i = 0; i < points.size(); ++i)
+			std::cout << " " << points[i].x;
+		std::cout << std::endl;
+	}
+	{
+		/* a copy throws while a full vector moves to its new buffer: the
+		* push_back leaves it as it was */
+		NAMESPACE::vector<fragile> v;
+		for (int i = 0; i < 8; ++i)
+			v.push_back(fragile(std::string(20 + i, 'a' + i)));
+		std::size_t capacity = v.capacity();
+		bool threw = false;
+		copies_left = 4;
+		try
+		{
+			v.push_back(v[2]);
+		}
+		catch (const std::runtime_error&)
+		{
+			threw = true;
+		}
+		copies_left = 0;
+		std::cout << "throwing push_back : threw = " << threw << " | size = " << v.size()
+			<< " | same capacity = " << (v.capacity() == capacity) << " | back = " << v.back().text << std::endl;
+		v.push_back(v[2]);
+		std::cout << "then : size = " << v.size() << " | back = " << v.back().text << std::endl;
+	}
 }
\ No newline at end of file
@@ -1,6 +1,17 @@
 #ifndef TYPE_TRAITS_HPP
 #define TYPE_TRAITS_HPP
 
+#include <memory>
+
+/* FT_HAS_BUILTIN(x): whether the compiler knows the builtin x, 0 if it cannot
+* tell. clang 15 deprecates the __has_trivial_* builtins for the
+* __is_trivially_* ones, which older g++ lack. */
+#ifdef __has_builtin
+# define FT_HAS_BUILTIN(x) __has_builtin(x)
+#else
+# define FT_HAS_BUILTIN(x) 0
+#endif
+
 namespace ft{
 
 /* enable_if: If B is true, std::enable_if has a public member typedef type, 
@@ -92,8 +103,155 @@ struct is_integral<long> 						: public true_type{};
 template<> 
 struct is_integral<unsigned long> 				: public true_type{};
 
-template<> 
+template<>
 struct is_integral<bool> 						: public true_type{};
+
+/* is_trivially_copyable: true if T can be copied with memcpy (no user-provided
+* copy constructor, copy assignment or destructor). There is no way to detect it
+* in plain C++98, so we rely on the compiler intrinsic (gcc >= 5, clang).*/
+template <bool B>
+struct bool_constant : public false_type {};
+
+template <>
+struct bool_constant<true> : public true_type {};
+
+template <class T>
+struct is_trivially_copyable : public bool_constant<__is_trivially_copyable(T)> {};
+
+/* is_trivially_destructible: true if destroying a T does nothing, so that its
+* destructor calls can be skipped. Compiler intrinsic as well.*/
+#if FT_HAS_BUILTIN(__is_trivially_destructible)
+template <class T>
+struct is_trivially_destructible : public bool_constant<__is_trivially_destructible(T)> {};
+#else
+template <class T>
+struct is_trivially_destructible : public bool_constant<__has_trivial_destructor(T)> {};
+#endif
+
+/* is_trivially_default_constructible: true if a default-initialized T is
+* left as it is in memory, as int or a struct of them. Compiler intrinsic.*/
+#if FT_HAS_BUILTIN(__is_trivially_constructible)
+template <class T>
+struct is_trivially_default_constructible : public bool_constant<__is_trivially_constructible(T)> {};
+#else
+template <class T>
+struct is_trivially_default_constructible : public bool_constant<__has_trivial_constructor(T)> {};
+#endif
+
+/* is_plain_allocator: true if Alloc::construct and Alloc::destroy only call the
+* copy constructor and the destructor, as std::allocator does: a container may
+* then replace them with memcpy and nothing for trivial types. Specialize it for
+* other allocators that behave the same.*/
+template <class Alloc>
+struct is_plain_allocator : public false_type {};
+
+template <class T>
+struct is_plain_allocator<std::allocator<T> > : public true_type {};
+
+/* has_reallocate: true if Alloc has a member
+* pointer reallocate(pointer p, size_type old_n, size_type new_n) that tries to
+* resize the block of p, moving its bytes like realloc, and returns NULL (p
+* untouched) when it cannot. Containers use it for trivially copyable types.*/
+template <class Alloc>
+struct has_reallocate
+{
+	private:
+		typedef char	yes;
+		typedef char	(&no)[2];
+		typedef typename Alloc::pointer		pointer;
+		typedef typename Alloc::size_type	size_type;
+
+		template <class U, pointer (U::*)(pointer, size_type, size_type)>
+		struct check {};
+
+		template <class U>
+		static yes test(check<U, &U::reallocate>*);
+		template <class U>
+		static no test(...);
+
+	public:
+		static const bool value = sizeof(test<Alloc>(0)) == sizeof(yes);
+};
+
+/*
+* allocator_propagation<Alloc>: what a container does with its allocator on
+* copy and swap, read from Alloc as the C++11 allocator_traits do:
+*	- on_copy_assignment: Alloc::propagate_on_container_copy_assignment::value,
+*	  the container takes the allocator of the copied one;
+*	- on_swap: Alloc::propagate_on_container_swap::value, the allocators are
+*	  swapped with the elements;
+*	- select_on_copy(a): a.select_on_container_copy_construction(), the
+*	  allocator of a copy-constructed container.
+* Absent members give false, false and a copy of a: the allocator stays
+* with its container.
+*/
+template <class Alloc>
+struct allocator_propagation
+{
+	private:
+		typedef char	yes;
+		typedef char	(&no)[2];
+
+		template <class U>
+		static yes test_copy(typename U::propagate_on_container_copy_assignment*);
+		template <class U>
+		static no test_copy(...);
+
+		template <class U>
+		static yes test_swap(typename U::propagate_on_container_swap*);
+		template <class U>
+		static no test_swap(...);
+
+		template <class U, U (U::*)() const>
+		struct check {};
+
+		template <class U>
+		static yes test_select(check<U, &U::select_on_container_copy_construction>*);
+		template <class U>
+		static no test_select(...);
+
+		template <class U, bool Declared>
+		struct copy_value { static const bool value = false; };
+		template <class U>
+		struct copy_value<U, true> { static const bool value = U::propagate_on_container_copy_assignment::value; };
+
+		template <class U, bool Declared>
+		struct swap_value { static const bool value = false; };
+		template <class U>
+		struct swap_value<U, true> { static const bool value = U::propagate_on_container_swap::value; };
+
+		static const bool has_select = sizeof(test_select<Alloc>(0)) == sizeof(yes);
+
+		static Alloc select(const Alloc& a, true_type) { return a.select_on_container_copy_construction(); }
+		static Alloc select(const Alloc& a, false_type) { return a; }
+
+	public:
+		static const bool on_copy_assignment = copy_value<Alloc, sizeof(test_copy<Alloc>(0)) == sizeof(yes)>::value;
+		static const bool on_swap = swap_value<Alloc, sizeof(test_swap<Alloc>(0)) == sizeof(yes)>::value;
+
+		static Alloc select_on_copy(const Alloc& a)
+		{
+			return select(a, bool_constant<has_select>());
+		}
+};
+
+/* is_transparent: true if the comparator T declares a member type
+* is_transparent, which promises it can compare keys with other types.*/
+template <class T>
+struct is_transparent
+{
+	private:
+		typedef char	yes;
+		typedef char	(&no)[2];
+
+		template <class U>
+		static yes test(typename U::is_transparent*);
+		template <class U>
+		static no test(...);
+
+	public:
+		static const bool value = sizeof(test<T>(0)) == sizeof(yes);
+};
 } //namespace
 
 #endif
\ No newline at end of file
@@ -0,0 +1,790 @@
+#ifndef UNORDERED_MAP_HPP
+#define UNORDERED_MAP_HPP
+
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+#include "utility.hpp"
+#include "hash.hpp"
+
+/*
+* ft::unordered_map: an open-addressing hash map in the style of the Swiss
+* tables. The slots hold the elements themselves and are split in groups of
+* 16; every slot has a control byte:
+*
+*	0x80		empty
+*	0x00-0x7f	full, the 7 low bits of the hash of its key
+*
+* A look-up compares the 16 control bytes of a group with the 7 bits at
+* once (SSE2, or a portable loop without it) and only compares the keys of
+* the matching slots, about one key comparison per successful look-up.
+* Groups are probed in the order h, h + 1, h + 3, h + 6...
+*
+* Deletion leaves no tombstone: each group counts the elements that had to
+* probe past it because it was full. A look-up stops at the first group
+* whose count is zero, and an erase decrements the counts along the path
+* of its element, so an erased slot is simply empty again. A count that
+* reaches 255 stays there.
+*
+* Growth is incremental: when the table is 7/8 full, a table twice as large
+* takes the new elements and every insertion moves two groups of the old
+* one, until it is empty. No insertion pays for a full rehash; look-ups
+* search both tables meanwhile. rehash() and reserve() do the full move
+* at once.
+*
+* Differences with std::unordered_map, all coming from the slots:
+*	- insertions invalidate iterators, pointers and references (elements
+*	  move between tables), erase only those to the erased element;
+*	- iterators refer to their map: swap() invalidates them;
+*	- there are no buckets: bucket_count() is the number of slots.
+*/
+
+namespace ft {
+
+/* Value is the map's value_type or its const version */
+template <typename Map, typename Value>
+class unordered_map_iterator
+{
+	public:
+		typedef typename Map::value_type				value_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef std::forward_iterator_tag				iterator_category;
+		typedef Value*									pointer;
+		typedef Value&									reference;
+
+	private:
+		const Map*										_map;
+		int												_table;	// 0 the old table, 1 the current one
+		std::size_t										_index;	// end(): the size of the current table
+
+	public:
+		unordered_map_iterator() : _map(NULL), _table(1), _index(0) {}
+
+		unordered_map_iterator(const Map* map, int table, std::size_t index) : _map(map), _table(table), _index(index) {}
+
+		template <typename V>
+		unordered_map_iterator(const unordered_map_iterator<Map, V>& other):
+			_map(other.map()), _table(other.table()), _index(other.index()) {}
+
+		const Map* map() const { return _map; }
+		int table() const { return _table; }
+		std::size_t index() const { return _index; }
+
+		reference operator*() const { return _map->_tables[_table].slots[_index]; }
+		pointer operator->() const { return &_map->_tables[_table].slots[_index]; }
+
+		unordered_map_iterator& operator++()
+		{
+			_map->next_full(_table, ++_index);
+			return *this;
+		}
+
+		unordered_map_iterator operator++(int)
+		{
+			unordered_map_iterator tmp(*this);
+			++(*this);
+			return tmp;
+		}
+
+		template <typename V>
+		bool operator==(const unordered_map_iterator<Map, V>& x) const { return _index == x.index() && _table == x.table(); }
+
+		template <typename V>
+		bool operator!=(const unordered_map_iterator<Map, V>& x) const { return !(*this == x); }
+};
+
+/* the control bytes of one group */
+struct hash_group
+{
+	enum { width = 16 };
+	static const signed char	empty = -128;
+
+	signed char		ctrl[width];
+
+	/* bit i set when slot i holds tag */
+	unsigned match(signed char tag) const
+	{
+#if defined(__SSE2__)
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+		return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), bytes)));
+#else
+		unsigned mask = 0;
+		for (int i = 0; i < width; ++i)
+			mask |= static_cast<unsigned>(ctrl[i] == tag) << i;
+		return mask;
+#endif
+	}
+
+	/* bit i set when slot i is empty: the only control byte with its sign bit */
+	unsigned match_empty() const
+	{
+#if defined(__SSE2__)
+		return static_cast<unsigned>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#else
+		unsigned mask = 0;
+		for (int i = 0; i < width; ++i)
+			mask |= static_cast<unsigned>(ctrl[i] < 0) << i;
+		return mask;
+#endif
+	}
+
+	static int lowest_bit(unsigned mask)
+	{
+#if defined(__GNUC__)
+		return __builtin_ctz(mask);
+#else
+		int i = 0;
+		while (!(mask & 1u))
+		{
+			mask >>= 1;
+			++i;
+		}
+		return i;
+#endif
+	}
+};
+
+template<typename Key, typename T, typename Hash = ft::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+	typename Allocator = std::allocator<ft::pair<const Key, T> > >
+class unordered_map {
+
+	/*MEMBER TYPES*/
+	public:
+		typedef Key																key_type;
+		typedef T																mapped_type;
+		typedef Hash															hasher;
+		typedef KeyEqual														key_equal;
+		typedef Allocator 														allocator_type;
+
+		typedef ft::pair<const key_type, mapped_type>							value_type;
+		typedef std::ptrdiff_t 													difference_type;
+		typedef std::size_t 													size_type;
+
+		typedef value_type& 													reference;
+		typedef const value_type& 												const_reference;
+		typedef typename Allocator::pointer										pointer;
+		typedef typename Allocator::const_pointer								const_pointer;
+
+		typedef unordered_map_iterator<unordered_map, value_type>				iterator;
+		typedef unordered_map_iterator<unordered_map, const value_type>			const_iterator;
+
+	private:
+		typedef typename Allocator::template rebind<hash_group>::other			group_alloc;
+		typedef typename Allocator::template rebind<unsigned char>::other		count_alloc;
+
+		friend class unordered_map_iterator<unordered_map, value_type>;
+		friend class unordered_map_iterator<unordered_map, const value_type>;
+
+		/* groups, their overflow counts and the slots of one table */
+		struct table
+		{
+			hash_group*		groups;
+			unsigned char*	overflow;	// elements that probed past the group
+			value_type*		slots;
+			size_type		group_count;// 0 or a power of two
+			size_type		size;
+
+			size_type capacity() const { return group_count * hash_group::width; }
+			bool full(size_type i) const { return groups[i / hash_group::width].ctrl[i % hash_group::width] >= 0; }
+		};
+
+		enum { migrate_step = 2 }; // groups of the old table moved per insertion
+
+	public:
+		/* -- CONSTRUCTORS - DESTUCTORS -- */
+
+		/**
+		*  @brief  Creates an empty %unordered_map.
+		*  @param  bucket_count  Elements to make room for; 0 allocates nothing.
+		*/
+		explicit unordered_map(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+			const allocator_type& alloc = allocator_type()):
+			_migrated(0),
+			_alloc(alloc),
+			_hash(hash),
+			_equal(equal)
+		{
+			reset(_tables[0]);
+			reset(_tables[1]);
+			if (bucket_count)
+				reserve(bucket_count);
+		}
+
+		template<typename InputIt>
+		unordered_map(InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = hasher(),
+			const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type()):
+			_migrated(0),
+			_alloc(alloc),
+			_hash(hash),
+			_equal(equal)
+		{
+			reset(_tables[0]);
+			reset(_tables[1]);
+			if (bucket_count)
+				reserve(bucket_count);
+			insert(first, last);
+		}
+
+		unordered_map(const unordered_map& other):
+			_migrated(0),
+			_alloc(other._alloc),
+			_hash(other._hash),
+			_equal(other._equal)
+		{
+			reset(_tables[0]);
+			reset(_tables[1]);
+			reserve(other.size());
+			insert(other.begin(), other.end());
+		}
+
+		~unordered_map()
+		{
+			release(_tables[0]);
+			release(_tables[1]);
+		}
+
+		unordered_map& operator=(const unordered_map& other)
+		{
+			unordered_map temp(other);
+			swap(temp);
+			return *this;
+		}
+
+		allocator_type get_allocator() const { return _alloc; }
+
+	/* ---------- ITERATORS --------------------------------------------------------- */
+		iterator begin()
+		{
+			int t = 0;
+			size_type i = _migrated * hash_group::width;
+			next_full(t, i);
+			return iterator(this, t, i);
+		}
+
+		const_iterator begin() const
+		{
+			int t = 0;
+			size_type i = _migrated * hash_group::width;
+			next_full(t, i);
+			return const_iterator(this, t, i);
+		}
+
+		iterator end() { return iterator(this, 1, _tables[1].capacity()); }
+		const_iterator end() const { return const_iterator(this, 1, _tables[1].capacity()); }
+
+	/*
+	* ---------- CAPACITY --------------------------------------------------------- *
+	*/
+		bool empty() const { return size() == 0; }
+
+		size_type size() const { return _tables[0].size + _tables[1].size; }
+
+		size_type max_size() const
+		{
+			return std::min(static_cast<size_type>(_alloc.max_size()), static_cast<size_type>(group_alloc().max_size()));
+		}
+
+	/*
+	* ---------- HASH POLICY ------------------------------------------------------ *
+	*/
+		/* slots of the current table */
+		size_type bucket_count() const { return _tables[1].capacity(); }
+
+		float load_factor() const
+		{
+			return bucket_count() ? static_cast<float>(size()) / bucket_count() : 0.0f;
+		}
+
+		float max_load_factor() const { return 0.875f; }
+
+		/* true while the elements of a smaller table are being moved */
+		bool is_migrating() const { return _tables[0].group_count != 0; }
+
+		/**
+		*  @brief  Moves every element to a table of at least @a n slots, at once.
+		*
+		*  The table is never made too small for size(); rehash(0) fits the
+		*  table to the elements.
+		*/
+		void rehash(size_type n)
+		{
+			if (is_migrating())
+				migrate(_tables[0].group_count);
+			n = std::max(n, slots_for(size()));
+			size_type groups = 0;
+			while (groups * hash_group::width < n)
+				groups = groups ? groups * 2 : 1;
+			if (groups == _tables[1].group_count)
+				return;
+
+			/* a migration run to its end: if a copy throws, the map is
+			* left migrating, with every element in one of its tables */
+			table fresh;
+			allocate(fresh, groups);
+			_tables[0] = _tables[1];
+			_tables[1] = fresh;
+			_migrated = 0;
+			migrate(_tables[0].group_count);
+		}
+
+		/* makes room for @a n elements without growing */
+		void reserve(size_type n)
+		{
+			size_type needed = slots_for(n);
+			if (needed > bucket_count() || is_migrating())
+				rehash(std::max(needed, bucket_count()));
+		}
+
+	/*
+	* ---------- ELEMENT ACCESS ----------------------------------------------------- *
+	*/
+		mapped_type& at(const key_type& key)
+		{
+			iterator it = find(key);
+			if (it == end())
+				throw std::out_of_range("unordered_map::at:  key not found");
+			return it->second;
+		}
+
+		const mapped_type& at(const key_type& key) const
+		{
+			const_iterator it = find(key);
+			if (it == end())
+				throw std::out_of_range("unordered_map::at:  key not found");
+			return it->second;
+		}
+
+		mapped_type& operator[](const key_type& key)
+		{
+			size_type h = hash_of(key);
+			int t;
+			size_type i;
+
+			if (!locate(key, h, t, i))
+				place(value_type(key, mapped_type()), h, t, i);
+			return _tables[t].slots[i].second;
+		}
+
+	/*
+	* --------------- MODIFIERS ------------------------------------------------------ *
+	*/
+		/* destroys the elements, keeps the current table */
+		void clear()
+		{
+			release(_tables[0]);
+			_migrated = 0;
+			destroy_all(_tables[1]);
+		}
+
+		ft::pair<iterator, bool> insert(const value_type& value)
+		{
+			size_type h = hash_of(value.first);
+			int t;
+			size_type i;
+
+			if (locate(value.first, h, t, i))
+				return ft::make_pair(iterator(this, t, i), false);
+			place(value, h, t, i);
+			return ft::make_pair(iterator(this, t, i), true);
+		}
+
+		/* the hint is not used */
+		iterator insert(const_iterator, const value_type& value)
+		{
+			return insert(value).first;
+		}
+
+		template<class InputIt>
+		void insert(InputIt first, InputIt last)
+		{
+			for(; first != last; ++first)
+				insert(*first);
+		}
+
+		/* the other elements stay where they are */
+		void erase(const_iterator pos)
+		{
+			erase_slot(_tables[pos.table()], pos.index());
+		}
+
+		void erase(const_iterator first, const_iterator last)
+		{
+			while (first != last)
+				erase(first++);
+		}
+
+		size_type erase(const key_type& key)
+		{
+			int t;
+			size_type i;
+
+			if (!locate(key, hash_of(key), t, i))
+				return 0;
+			erase_slot(_tables[t], i);
+			return 1;
+		}
+
+		void swap(unordered_map& other)
+		{
+			std::swap(_tables[0], other._tables[0]);
+			std::swap(_tables[1], other._tables[1]);
+			std::swap(_migrated, other._migrated);
+			std::swap(_alloc, other._alloc);
+			std::swap(_hash, other._hash);
+			std::swap(_equal, other._equal);
+		}
+
+	/*
+	* --------------- LOOK-UP --------------------------------------------------- *
+	*/
+		size_type count(const key_type& key) const
+		{
+			int t;
+			size_type i;
+
+			return locate(key, hash_of(key), t, i);
+		}
+
+		iterator find(const key_type& key)
+		{
+			int t;
+			size_type i;
+
+			if (!locate(key, hash_of(key), t, i))
+				return end();
+			return iterator(this, t, i);
+		}
+
+		const_iterator find(const key_type& key) const
+		{
+			int t;
+			size_type i;
+
+			if (!locate(key, hash_of(key), t, i))
+				return end();
+			return const_iterator(this, t, i);
+		}
+
+		ft::pair<iterator, iterator> equal_range(const key_type& key)
+		{
+			iterator first = find(key);
+			iterator last = first;
+			if (first != end())
+				++last;
+			return ft::make_pair(first, last);
+		}
+
+		ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+		{
+			const_iterator first = find(key);
+			const_iterator last = first;
+			if (first != end())
+				++last;
+			return ft::make_pair(first, last);
+		}
+
+	/*
+	* --------------- OBSERVERS -------------------------------------------------- *
+	*/
+		hasher hash_function() const { return _hash; }
+
+		key_equal key_eq() const { return _equal; }
+
+	/*
+	* --------------- INTROSPECTION ---------------------------------------------- *
+	*/
+		/* Bytes owned by the map: the object itself and its tables. */
+		size_type memory_usage() const
+		{
+			return sizeof(*this) + table_bytes(_tables[0]) + table_bytes(_tables[1]);
+		}
+
+	private:
+		table			_tables[2];	// [0] being emptied into [1] while migrating
+		size_type		_migrated;	// groups of _tables[0] already emptied
+		allocator_type	_alloc;
+		hasher			_hash;
+		key_equal		_equal;
+
+		/* the hash is mixed so that a weak one (the identity of ft::hash for
+		* integers) still spreads its keys over the groups and the tags */
+		size_type hash_of(const key_type& key) const
+		{
+			uint64_t h = static_cast<uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ULL;
+			return static_cast<size_type>(h ^ (h >> 32));
+		}
+
+		static signed char tag_of(size_type h) { return static_cast<signed char>(h & 0x7f); }
+		static size_type home_of(const table& tab, size_type h) { return (h >> 7) & (tab.group_count - 1); }
+
+		/* slots needed for n elements at the maximal load */
+		static size_type slots_for(size_type n)
+		{
+			return n + (n + 6) / 7;
+		}
+
+		static size_type table_bytes(const table& tab)
+		{
+			return tab.group_count * (sizeof(hash_group) + 1) + tab.capacity() * sizeof(value_type);
+		}
+
+		static void reset(table& tab)
+		{
+			tab.groups = NULL;
+			tab.overflow = NULL;
+			tab.slots = NULL;
+			tab.group_count = 0;
+			tab.size = 0;
+		}
+
+		void allocate(table& tab, size_type group_count)
+		{
+			reset(tab);
+			if (group_count == 0)
+				return;
+			group_alloc groups(_alloc);
+			count_alloc counts(_alloc);
+			tab.groups = groups.allocate(group_count);
+			try
+			{
+				tab.overflow = counts.allocate(group_count);
+				tab.slots = _alloc.allocate(group_count * hash_group::width);
+			}
+			catch (...)
+			{
+				if (tab.overflow)
+					counts.deallocate(tab.overflow, group_count);
+				groups.deallocate(tab.groups, group_count);
+				reset(tab);
+				throw;
+			}
+			tab.group_count = group_count;
+			std::memset(tab.groups, hash_group::empty, group_count * sizeof(hash_group));
+			std::memset(tab.overflow, 0, group_count);
+		}
+
+		void destroy_all(table& tab)
+		{
+			for (size_type i = 0; tab.size && i < tab.capacity(); ++i)
+			{
+				if (tab.full(i))
+				{
+					_alloc.destroy(tab.slots + i);
+					tab.size--;
+				}
+			}
+			if (tab.group_count)
+			{
+				std::memset(tab.groups, hash_group::empty, tab.group_count * sizeof(hash_group));
+				std::memset(tab.overflow, 0, tab.group_count);
+			}
+		}
+
+		void release(table& tab)
+		{
+			destroy_all(tab);
+			if (tab.group_count)
+			{
+				group_alloc(_alloc).deallocate(tab.groups, tab.group_count);
+				count_alloc(_alloc).deallocate(tab.overflow, tab.group_count);
+				_alloc.deallocate(tab.slots, tab.capacity());
+			}
+			reset(tab);
+		}
+
+		/* the slot of key in tab, or false */
+		bool search(const table& tab, const key_type& key, size_type h, size_type& index) const
+		{
+			if (tab.group_count == 0)
+				return false;
+			signed char tag = tag_of(h);
+			size_type mask = tab.group_count - 1;
+			size_type g = home_of(tab, h);
+
+			for (size_type step = 1; ; ++step)
+			{
+				const hash_group& group = tab.groups[g];
+				for (unsigned match = group.match(tag); match; match &= match - 1)
+				{
+					size_type i = g * hash_group::width + hash_group::lowest_bit(match);
+					if (_equal(tab.slots[i].first, key))
+					{
+						index = i;
+						return true;
+					}
+				}
+				if (tab.overflow[g] == 0 || step > mask)
+					return false;
+				g = (g + step) & mask;
+			}
+		}
+
+		/* the current table is searched first: it is where the old elements go */
+		bool locate(const key_type& key, size_type h, int& t, size_type& index) const
+		{
+			t = 1;
+			if (search(_tables[1], key, h, index))
+				return true;
+			t = 0;
+			return is_migrating() && search(_tables[0], key, h, index);
+		}
+
+		/* the first empty slot of the probe sequence; the full groups passed
+		* count one more overflowing element */
+		static size_type free_slot(table& tab, size_type h)
+		{
+			size_type mask = tab.group_count - 1;
+			size_type g = home_of(tab, h);
+
+			for (size_type step = 1; ; ++step)
+			{
+				unsigned empty = tab.groups[g].match_empty();
+				if (empty)
+					return g * hash_group::width + hash_group::lowest_bit(empty);
+				if (tab.overflow[g] != 255)
+					tab.overflow[g]++;
+				g = (g + step) & mask;
+			}
+		}
+
+		/* constructs value in tab, the table has an empty slot */
+		size_type construct_in(table& tab, const value_type& value, size_type h)
+		{
+			size_type i = free_slot(tab, h);
+			_alloc.construct(tab.slots + i, value);
+			tab.groups[i / hash_group::width].ctrl[i % hash_group::width] = tag_of(h);
+			tab.size++;
+			return i;
+		}
+
+		/* inserts a value known to be absent, growing first if needed. value
+		* cannot be one of the elements that growing moves: its key would be
+		* present */
+		void place(const value_type& value, size_type h, int& t, size_type& index)
+		{
+			grow_for_one();
+			t = 1;
+			index = construct_in(_tables[1], value, h);
+		}
+
+		/* the current table keeps room for the elements still in the old one */
+		void grow_for_one()
+		{
+			table& current = _tables[1];
+
+			if (is_migrating())
+				migrate(migrate_step);
+			if (current.group_count == 0)
+			{
+				allocate(current, 1);
+				return;
+			}
+			if (slots_for(size() + 1) <= current.capacity())
+				return;
+			if (is_migrating())
+				migrate(_tables[0].group_count);
+			table larger;
+			allocate(larger, current.group_count * 2);
+			_tables[0] = current;
+			_tables[1] = larger;
+			_migrated = 0;
+		}
+
+		/* moves the elements of the next groups of the old table */
+		void migrate(size_type groups)
+		{
+			table& old = _tables[0];
+
+			for (; groups && _migrated < old.group_count; --groups, ++_migrated)
+			{
+				hash_group& group = old.groups[_migrated];
+				for (unsigned full = ~group.match_empty() & 0xffffu; full; full &= full - 1)
+				{
+					int bit = hash_group::lowest_bit(full);
+					size_type i = _migrated * hash_group::width + bit;
+					construct_in(_tables[1], old.slots[i], hash_of(old.slots[i].first));
+					_alloc.destroy(old.slots + i);
+					group.ctrl[bit] = hash_group::empty;
+					old.size--;
+				}
+			}
+			if (_migrated == old.group_count)
+			{
+				release(old);
+				_migrated = 0;
+			}
+		}
+
+		/* empties the slot and takes the element off the counts of the groups
+		* its insertion probed past */
+		void erase_slot(table& tab, size_type index)
+		{
+			size_type mask = tab.group_count - 1;
+			size_type target = index / hash_group::width;
+			size_type g = home_of(tab, hash_of(tab.slots[index].first));
+
+			for (size_type step = 1; g != target; ++step)
+			{
+				if (tab.overflow[g] != 255)
+					tab.overflow[g]--;
+				g = (g + step) & mask;
+			}
+			_alloc.destroy(tab.slots + index);
+			tab.groups[target].ctrl[index % hash_group::width] = hash_group::empty;
+			tab.size--;
+		}
+
+		/* moves (t, index) to the next full slot, or to end() */
+		void next_full(int& t, size_type& index) const
+		{
+			for (; t < 2; ++t, index = 0)
+			{
+				const table& tab = _tables[t];
+				for (; index < tab.capacity(); ++index)
+					if (tab.full(index))
+						return;
+			}
+			t = 1;
+			index = _tables[1].capacity();
+		}
+};
+
+/*----------------------------- NON-MEMBER FUNCTIONS ---------------------------------------*/
+template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+void swap(ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs, ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+/* same elements, in any order */
+template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& x, const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& y)
+{
+	if (x.size() != y.size())
+		return false;
+	for (typename ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>::const_iterator it = x.begin(); it != x.end(); ++it)
+	{
+		typename ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>::const_iterator found = y.find(it->first);
+		if (found == y.end() || !(found->second == it->second))
+			return false;
+	}
+	return true;
+}
+
+template<class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& x, const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& y)
+{
+	return !(x == y);
+}
+
+} // namespace
+
+#endif
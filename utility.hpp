@@ -115,6 +115,20 @@ namespace ft
         return true;
     }
 
+    /*transparent_less: a < b for any two comparable types, like std::less<void>.
+    As the comparator of a map, lets find() and friends take any type comparable
+    with the key (a const char* for std::string keys) without building a key.*/
+    struct transparent_less
+    {
+        typedef void is_transparent;
+
+        template <class T, class U>
+        bool operator()(const T& a, const U& b) const
+        {
+            return a < b;
+        }
+    };
+
 
 } // namespace
 
@@ -3,6 +3,8 @@
 
 #include <memory>
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <algorithm>
 #include <iostream>
@@ -11,22 +13,160 @@
 #include "normal_iterator.hpp"
 #include "type_traits.hpp"
 #include "utility.hpp"
+#include "growth_policy.hpp"
+
+/*
+* FT_NOINLINE keeps a rarely taken path out of line, FT_UNLIKELY tells the
+* compiler which way a branch usually goes (gcc, clang). Not the cold
+* attribute: it compiles the function for size, which costs the vectors that
+* grow often, as small ones do.
+*/
+#ifndef FT_NOINLINE
+# if defined(__GNUC__)
+#  define FT_NOINLINE __attribute__((noinline))
+# else
+#  define FT_NOINLINE
+# endif
+#endif
+
+#ifndef FT_UNLIKELY
+# if defined(__GNUC__)
+#  define FT_UNLIKELY(x) __builtin_expect(!!(x), 0)
+# else
+#  define FT_UNLIKELY(x) (x)
+# endif
+#endif
 
 namespace ft {
 
+	/*
+	* Memory report of a vector, see vector::stats(). Byte counts are what the
+	* vector asks from its allocator, the allocator's bookkeeping not included.
+	*/
+	struct vector_stats
+	{
+		std::size_t		size;
+		std::size_t		capacity;
+		std::size_t		element_size;		/* sizeof(value_type) */
+		std::size_t		bytes_reserved;		/* capacity * element_size */
+		std::size_t		bytes_used;			/* size * element_size */
+		std::size_t		bytes_slack;		/* bytes_reserved - bytes_used */
+		std::size_t		reallocations;		/* buffers allocated so far, the first one included */
+		std::size_t		bytes_copied;		/* elements copied into new buffers, in bytes (*) */
+		std::size_t		peak_capacity;		/* (*) */
+	};
+
+	/*
+	* The counters behind vector_stats. Those marked (*) above are only kept
+	* when FT_VECTOR_COUNTERS is defined, and read 0 otherwise: they cost two
+	* words per vector.
+	*/
+	struct vector_counters
+	{
+		std::size_t		reallocations;
+#ifdef FT_VECTOR_COUNTERS
+		std::size_t		bytes_copied;
+		std::size_t		peak_capacity;
+#endif
+
+		vector_counters() : reallocations(0)
+#ifdef FT_VECTOR_COUNTERS
+			, bytes_copied(0), peak_capacity(0)
+#endif
+		{}
+
+		/* a new buffer of capacity elements */
+		void allocated(std::size_t capacity)
+		{
+			++reallocations;
+#ifdef FT_VECTOR_COUNTERS
+			if (capacity > peak_capacity)
+				peak_capacity = capacity;
+#else
+			(void)capacity;
+#endif
+		}
+
+		void copied(std::size_t bytes)
+		{
+#ifdef FT_VECTOR_COUNTERS
+			bytes_copied += bytes;
+#else
+			(void)bytes;
+#endif
+		}
+
+		/* other counted the buffers of the same vector before this one */
+		void add(const vector_counters& other)
+		{
+			reallocations += other.reallocations;
+#ifdef FT_VECTOR_COUNTERS
+			bytes_copied += other.bytes_copied;
+			if (other.peak_capacity > peak_capacity)
+				peak_capacity = other.peak_capacity;
+#endif
+		}
+
+		void report(vector_stats& s) const
+		{
+			s.reallocations = reallocations;
+#ifdef FT_VECTOR_COUNTERS
+			s.bytes_copied = bytes_copied;
+			s.peak_capacity = peak_capacity;
+#else
+			s.bytes_copied = 0;
+			s.peak_capacity = 0;
+#endif
+		}
+	};
+
+	/*
+	* contiguous_source<Iter, T>: Iter walks T objects stored one after the
+	* other (a pointer or a vector iterator); address() is the object under it.
+	* The vector copies such ranges of trivially copyable T with memcpy.
+	*/
+	template <typename Iter, typename T>
+	struct contiguous_source : public false_type {};
+
+	template <typename T>
+	struct contiguous_source<T*, T> : public true_type
+	{
+		static const T* address(T* it) { return it; }
+	};
+
+	template <typename T>
+	struct contiguous_source<const T*, T> : public true_type
+	{
+		static const T* address(const T* it) { return it; }
+	};
+
+	template <typename T, typename Container>
+	struct contiguous_source<normal_iterator<T*, Container>, T> : public true_type
+	{
+		static const T* address(const normal_iterator<T*, Container>& it) { return it.base(); }
+	};
+
+	template <typename T, typename Container>
+	struct contiguous_source<normal_iterator<const T*, Container>, T> : public true_type
+	{
+		static const T* address(const normal_iterator<const T*, Container>& it) { return it.base(); }
+	};
+
 	/*
 	* Typename T -> type de donnés des éléments à stocker dans le vecteur
 	* Allocator -> type qui représente l'objet allocateur stocké qui
 	* contient des informations sur l'allocation et désallocation de
 	* mémoire du vecteur.
+	* Growth -> la capacité d'une réallocation, voir growth_policy.hpp.
 	*/
-    template <typename T, typename Allocator = std::allocator<T> >
+    template <typename T, typename Allocator = std::allocator<T>, typename Growth = growth_double>
     class vector 
     {
         /* ---------- MEMBER TYPE ---------- */
         public:
             typedef T                                                   value_type; /* Type représentant le type de données stockées dans un vecteur.*/
             typedef Allocator		                                  	allocator_type; /* Type qui représente la classe allocator pour l'objet vector.*/
+            typedef Growth		                                  		growth_policy; /* Type qui choisit la capacité des réallocations.*/
             typedef std::size_t                                         size_type; /* Type qui compte le nombre d'éléments dans un vecteur. */
             typedef std::ptrdiff_t                                      difference_type; /* Type qui fournit la différence entre les adresses de deux éléments dans un vecteur.*/
             typedef value_type&                                         reference; /* Type qui fournit une référence à un élément stocké dans un vecteur.*/
@@ -49,7 +189,8 @@ namespace ft {
 			_alloc(allocator_type()), 
 			_start(NULL), 
 			_finish(NULL), 
-			_end_storage(NULL)
+			_end_storage(NULL),
+			_counters()
 			{}
 
 		/*
@@ -60,7 +201,8 @@ namespace ft {
 			_alloc(alloc), 
 			_start(NULL), 
 			_finish(NULL), 
-			_end_storage(NULL)
+			_end_storage(NULL),
+			_counters()
 		{}
 
 		/*
@@ -75,13 +217,14 @@ namespace ft {
 			_alloc(alloc),
 			_start(NULL), 
 			_finish(NULL), 
-			_end_storage(NULL)
+			_end_storage(NULL),
+			_counters()
 		{
 			if (n == 0)
 				return;
 			if( n > max_size())
 				throw std::length_error("len error");
-			_start = _alloc.allocate(n);
+			_start = allocate_storage(n);
 			_finish = _start;
 			_end_storage = _start + n;
 			while(n--)
@@ -113,7 +256,8 @@ namespace ft {
 			_alloc(alloc),
 			_start(NULL), 
 			_finish(NULL), 
-			_end_storage(NULL)
+			_end_storage(NULL),
+			_counters()
 		{
 			typedef typename iterator_traits<InputIt>::iterator_category category;	
 			range_initialize(first, last, category());
@@ -124,14 +268,16 @@ namespace ft {
         *  @param  other  A %vector of identical element and allocator types.
         *
         *  The newly-created %vector uses a copy of the allocation
-        *  object used by other.  All the elements of other are copied,
+        *  object used by other, or what its
+        *  select_on_container_copy_construction() returns.  All the elements of other are copied,
         *  but any extra memory in other (for fast expansion) will not be copied.
 		*/
       	vector( const vector& other ) :
-			_alloc(other._alloc),
+			_alloc(allocator_propagation<Allocator>::select_on_copy(other._alloc)),
 			_start(NULL), 
 			_finish(NULL), 
-			_end_storage(NULL)
+			_end_storage(NULL),
+			_counters()
 		{
 			typedef typename iterator_traits<vector::iterator>::iterator_category category;	
 			range_initialize(other._start, other._finish, category());
@@ -148,11 +294,23 @@ namespace ft {
 	} 
 
 	/* ---------- COPY OPERATOR ----------- 
-	* Remplace les éléments du vecteur par une copie d'un autre vecteur.*/
+	* Remplace les éléments du vecteur par une copie d'un autre vecteur.
+	* The vector keeps its allocator, unless the allocator's
+	* propagate_on_container_copy_assignment says to take other's (see
+	* allocator_propagation): the old buffer is then released first.*/
 	vector& operator=( const vector& other ) 
 	{
 		if(this == &other)
 			return *this;
+		if (allocator_propagation<Allocator>::on_copy_assignment)
+		{
+			if (_alloc != other._alloc)
+			{
+				my_deallocate();
+				_start = _finish = _end_storage = NULL;
+			}
+			_alloc = other._alloc;
+		}
 		assign(other.begin(), other.end());
 		return *this;
 	} 
@@ -171,7 +329,8 @@ namespace ft {
 	{
 		if ( n > capacity())
 		{
-			vector tmp(n, value);
+			vector tmp(n, value, _alloc);
+			tmp._counters.add(_counters);
 			tmp.swap(*this);
 		}
 		else if (n  > size())
@@ -210,7 +369,7 @@ namespace ft {
 	/* Retourne une copie de l’objet allocateur utilisé pour construire le vecteur. */
 	allocator_type get_allocator() const 
 	{
-		return (allocator_type());
+		return (_alloc);
 	}
 
 	/*
@@ -371,7 +530,7 @@ namespace ft {
 	size_type max_size() const
 	{
 		const size_t diff_max = std::numeric_limits<difference_type>::max();
-		const size_t alloc_max = allocator_type().max_size();
+		const size_t alloc_max = _alloc.max_size();
 
 		return std::min(diff_max, alloc_max);
 	}
@@ -387,9 +546,10 @@ namespace ft {
 	{
 		if (new_cap > max_size())
 			throw std::length_error("allocator<T>::allocate(size_t n) 'n' exceeds maximum supported size");
-		if (capacity() < new_cap)
+		if (capacity() < new_cap && !reallocate_storage(new_cap))
 		{
-			pointer new_start = _alloc.allocate(new_cap);
+			pointer new_start = allocate_storage(new_cap);
+			_counters.copied(size() * sizeof(value_type));
 			pointer new_finish = construct_range(new_start, _start, _finish);
 			my_deallocate();
 
@@ -399,6 +559,44 @@ namespace ft {
 		}
 	}
 
+	/**
+	*  @brief  Gives back the capacity beyond max(n, size()).
+	*  @param  n  The capacity to keep at least.
+	*
+	*  Moves the elements to a buffer of that size when it is smaller than
+	*  capacity(), invalidating iterators, pointers and references; trivially
+	*  copyable elements go through the allocator's reallocate() when it has
+	*  one, or memcpy. An empty vector releases its buffer.
+	*/
+	void shrink_to(size_type n)
+	{
+		const size_type len = std::max(n, size());
+		if (len >= capacity())
+			return;
+		if (len == 0)
+		{
+			my_deallocate();
+			_start = _finish = _end_storage = NULL;
+			return;
+		}
+		if (reallocate_storage(len))
+			return;
+		pointer new_start = allocate_storage(len);
+		_counters.copied(size() * sizeof(value_type));
+		pointer new_finish = construct_range(new_start, _start, _finish);
+		my_deallocate();
+
+		_start = new_start;
+		_finish = new_finish;
+		_end_storage = _start + len;
+	}
+
+	/* Reduces capacity() to size(), see shrink_to(). */
+	void shrink_to_fit()
+	{
+		shrink_to(0);
+	}
+
 	/* Returns the total number of elements that the vector
 	* can hold before needing to allocate more memory.*/
 	size_type capacity() const
@@ -429,25 +627,37 @@ namespace ft {
 		{
             if (capacity() - size() >= n) // s'il reste de la place
             {
+                const value_type copy = value; // value may be one of the elements moved below
                 const size_type elems_after = end() - position;
                 pointer old_finish = _finish;
                 if (elems_after > n)
                 {
                     _finish = construct_range(_finish, _finish - n, _finish);
-                    std::copy_backward(position.base(), old_finish - n, old_finish);
-                    std::fill(position.base(), position.base() + n, value);
+                    assign_backward(position.base(), old_finish - n, old_finish);
+                    std::fill(position.base(), position.base() + n, copy);
                 }
                 else
                 {
-                    _finish = construct_range(_finish, _finish + (n - elems_after), value);
+                    _finish = construct_range(_finish, _finish + (n - elems_after), copy);
                     _finish = construct_range(_finish, position.base(), old_finish);
-                    std::fill(position.base(), old_finish, value);
+                    std::fill(position.base(), old_finish, copy);
                 }
             }
             else // plsude place
             {
                 const size_type len = check_len(n);
-                pointer new_start = _alloc.allocate(len);
+                if (trivial_relocate::value)
+                {
+                    const value_type copy = value; // value may be one of the elements
+                    const size_type offset = position - begin();
+                    if (reallocate_storage(len))
+                    {
+                        insert(begin() + offset, n, copy);
+                        return;
+                    }
+                }
+                pointer new_start = allocate_storage(len);
+                _counters.copied(size() * sizeof(value_type));
                 pointer new_end = construct_range(new_start, _start, position.base());
                 new_end = construct_range(new_end, new_end + n, value);
                 new_end = construct_range(new_end, position.base(), _finish);
@@ -510,7 +720,7 @@ namespace ft {
 		iterator first = position + 1;
 		if (first != end())
 		{
-			std::copy(first, end(), position);
+			assign_range(position.base(), first.base(), _finish);
 		}
 		--_finish;
 		_alloc.destroy(_finish);
@@ -532,7 +742,7 @@ iterator erase( iterator first, iterator last )
 	{
 		if(last != end())
 		{
-			std::copy(last, end(), first);
+			assign_range(first.base(), last.base(), _finish);
 		}
 		my_erase_at_end(first.base() + (end() - last));
 	}
@@ -547,13 +757,13 @@ iterator erase( iterator first, iterator last )
 	*/
 	void push_back( const value_type& value )
 	{
-		if ( _finish != _end_storage)
+		if (FT_UNLIKELY(_finish == _end_storage))
+			realloc_append(value);
+		else
 		{
 			_alloc.construct(_finish, value);
 			++_finish;
 		}
-		else
-			insert(end(), value);
 	}
 
 	/*
@@ -585,6 +795,36 @@ iterator erase( iterator first, iterator last )
 			my_erase_at_end(_start + new_size);
 	}
 
+	/**
+	*  @brief  Resizes the %vector without initializing the new elements.
+	*  @param  new_size  Number of elements the %vector should contain.
+	*
+	*  Only for trivially default-constructible T (a compile error otherwise):
+	*  the elements past the old size are left as the memory was, neither
+	*  written nor read, for a caller that fills them next (read(2), a
+	*  decoder). Allocator::construct is not called for them. The capacity
+	*  grows as for an insertion of new_size - size() elements.
+	*/
+	void resize_default_init(size_type new_size)
+	{
+		typedef char	only_for_trivially_default_constructible_types[
+			is_trivially_default_constructible<T>::value ? 1 : -1];
+		(void)sizeof(only_for_trivially_default_constructible_types);
+
+		if (new_size > capacity())
+			reserve(check_len(new_size - size()));
+		if (new_size > size())
+			_finish = _start + new_size;
+		else
+			my_erase_at_end(_start + new_size);
+	}
+
+	/* The name other libraries give to resize_default_init(). */
+	void resize_uninitialized(size_type new_size)
+	{
+		resize_default_init(new_size);
+	}
+
 	/**
     *  @brief  Swaps data with another %vector.
     *  @param  other  A %vector of the same element and allocator types.
@@ -593,19 +833,71 @@ iterator erase( iterator first, iterator last )
     *  (Three pointers, so it should be quite fast.)
     *  Note that the global std::swap() function is specialized such that
     *  std::swap(v1,v2) will feed to this function.
+    *
+    *  The allocators are swapped too when propagate_on_container_swap says
+    *  so. Otherwise each vector keeps its own, and two that differ cannot
+    *  exchange buffers: the elements are copied, in linear time.
     */
 	void swap(vector& other)
 	{
-		std::swap(_start, other._start);
-		std::swap(_finish, other._finish);
-		std::swap(_end_storage, other._end_storage);
+		if (allocator_propagation<Allocator>::on_swap)
+			std::swap(_alloc, other._alloc);
+		else if (_alloc != other._alloc)
+		{
+			vector mine(other.begin(), other.end(), _alloc);
+			vector theirs(begin(), end(), other._alloc);
+			swap_storage(mine);
+			other.swap_storage(theirs);
+			return;
+		}
+		swap_storage(other);
+	}
+
+	/*
+	* ---------- INTROSPECTION ---------- *
+	*/
+	/* Bytes owned by the vector: the object itself and its buffer. */
+	size_type memory_usage() const
+	{
+		return sizeof(*this) + capacity() * sizeof(value_type);
+	}
+
+	vector_stats stats() const
+	{
+		vector_stats s;
+		s.size = size();
+		s.capacity = capacity();
+		s.element_size = sizeof(value_type);
+		s.bytes_reserved = capacity() * sizeof(value_type);
+		s.bytes_used = size() * sizeof(value_type);
+		s.bytes_slack = s.bytes_reserved - s.bytes_used;
+		_counters.report(s);
+		return s;
 	}
 
+	protected:
+		/* exchanges the buffers, not the allocators: they must be equal */
+		void swap_storage(vector& other)
+		{
+			std::swap(_start, other._start);
+			std::swap(_finish, other._finish);
+			std::swap(_end_storage, other._end_storage);
+			std::swap(_counters, other._counters);
+		}
+
 	private:
 		allocator_type 	_alloc;
 		pointer			_start;
 		pointer			_finish;
 		pointer			_end_storage;
+		vector_counters	_counters;
+
+		/* every buffer of the vector comes from here, so that stats() can count them */
+		pointer allocate_storage(size_type n)
+		{
+			_counters.allocated(n);
+			return _alloc.allocate(n);
+		}
 
 		/* Safety check used only from at() */
 		inline void range_check(size_type n) const
@@ -614,7 +906,56 @@ iterator erase( iterator first, iterator last )
 				throw std::out_of_range("vector");
 		}
 
+		/*
+		* Trivial element types under a plain allocator: copies are memcpy or
+		* memmove, destruction does nothing. The other overloads are the
+		* element-wise loops.
+		*/
+		typedef bool_constant<is_trivially_copyable<T>::value
+			&& is_plain_allocator<Allocator>::value>					trivial_copy;
+		typedef bool_constant<is_trivially_destructible<T>::value
+			&& is_plain_allocator<Allocator>::value>					trivial_destroy;
+
+		/*
+		* Trivially copyable elements under an allocator with reallocate() (see
+		* has_reallocate) may change buffer as raw bytes: the allocator can then
+		* grow the block in place or remap it, without an allocate + copy.
+		*/
+		typedef bool_constant<is_trivially_copyable<T>::value
+			&& has_reallocate<Allocator>::value>							trivial_relocate;
+
+		/* resizes the buffer to len elements through the allocator; false if
+		* it cannot, and the caller copies into a new buffer */
+		bool reallocate_storage(size_type len)
+		{
+			return reallocate_storage(len, trivial_relocate());
+		}
+
+		bool reallocate_storage(size_type, false_type) { return false; }
+
+		bool reallocate_storage(size_type len, true_type)
+		{
+			if (!_start)
+				return false;
+			const size_type old_size = size();
+			pointer new_start = _alloc.reallocate(_start, capacity(), len);
+			if (!new_start)
+				return false;
+			_counters.allocated(len);
+			_start = new_start;
+			_finish = _start + old_size;
+			_end_storage = _start + len;
+			return true;
+		}
+
 		void my_destroy( pointer first, pointer last)
+		{
+			destroy_range(first, last, trivial_destroy());
+		}
+
+		void destroy_range(pointer, pointer, true_type) {}
+
+		void destroy_range(pointer first, pointer last, false_type)
 		{
 			for(; first != last; ++first)
 				_alloc.destroy(first);
@@ -646,15 +987,10 @@ iterator erase( iterator first, iterator last )
 		void range_initialize(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
 		{
 			size_type n = std::distance(first, last);
-			_start = _alloc.allocate(n);
+			_start = allocate_storage(n);
 			_end_storage = _start + n;
 			_finish = _start;
-			while(n)
-			{
-				_alloc.construct(_finish, *first++);
-				_finish++;
-				n--;
-			}
+			_finish = construct_range(_start, first, last);
 		}
 
 		template<typename InputIt>
@@ -665,13 +1001,79 @@ iterator erase( iterator first, iterator last )
 				push_back(*first);
 		}
 
+		/* dest is raw storage, never inside [start, finish) */
 		template <typename Iter>
 		pointer construct_range(pointer dest, Iter start, Iter finish)
 		{
-			for (; start != finish; ++dest, (void)++start) {
-				_alloc.construct(dest, *start);
+			return construct_range(dest, start, finish,
+				bool_constant<trivial_copy::value && contiguous_source<Iter, T>::value>());
+		}
+
+		template <typename Iter>
+		pointer construct_range(pointer dest, Iter start, Iter finish, true_type)
+		{
+			size_type n = finish - start;
+			if (n)
+				std::memcpy(static_cast<void*>(dest), contiguous_source<Iter, T>::address(start), n * sizeof(T));
+			return dest + n;
+		}
+
+		/* if a copy throws, the elements already built are destroyed */
+		template <typename Iter>
+		pointer construct_range(pointer dest, Iter start, Iter finish, false_type)
+		{
+			pointer cur = dest;
+			try
+			{
+				for (; start != finish; ++cur, (void)++start) {
+					_alloc.construct(cur, *start);
+				}
 			}
-			return dest;
+			catch (...)
+			{
+				my_destroy(dest, cur);
+				throw;
+			}
+			return cur;
+		}
+
+		/* std::copy onto live elements; the ranges may overlap if dest <= start */
+		template <typename Iter>
+		void assign_range(pointer dest, Iter start, Iter finish)
+		{
+			assign_range(dest, start, finish,
+				bool_constant<trivial_copy::value && contiguous_source<Iter, T>::value>());
+		}
+
+		template <typename Iter>
+		void assign_range(pointer dest, Iter start, Iter finish, true_type)
+		{
+			size_type n = finish - start;
+			if (n)
+				std::memmove(static_cast<void*>(dest), contiguous_source<Iter, T>::address(start), n * sizeof(T));
+		}
+
+		template <typename Iter>
+		void assign_range(pointer dest, Iter start, Iter finish, false_type)
+		{
+			std::copy(start, finish, dest);
+		}
+
+		/* std::copy_backward onto live elements */
+		void assign_backward(pointer start, pointer finish, pointer dest_end)
+		{
+			assign_backward(start, finish, dest_end, trivial_copy());
+		}
+
+		void assign_backward(pointer start, pointer finish, pointer dest_end, true_type)
+		{
+			if (finish != start)
+				std::memmove(static_cast<void*>(dest_end - (finish - start)), start, (finish - start) * sizeof(T));
+		}
+
+		void assign_backward(pointer start, pointer finish, pointer dest_end, false_type)
+		{
+			std::copy_backward(start, finish, dest_end);
 		}
 
 		pointer construct_range(pointer dest, const_pointer finish, const_reference value)
@@ -682,13 +1084,58 @@ iterator erase( iterator first, iterator last )
 			return dest;
 		}
 
+		/*
+		* push_back on a full vector. value may be one of the elements: it is
+		* copied into the new buffer before the old one goes away. If a copy
+		* throws, the new buffer is released and the vector is unchanged.
+		*/
+		FT_NOINLINE void realloc_append(const value_type& value)
+		{
+			const size_type len = check_len(1);
+			const size_type old_size = size();
+			if (trivial_relocate::value)
+			{
+				const value_type copy = value;
+				if (reallocate_storage(len))
+				{
+					_alloc.construct(_finish, copy);
+					++_finish;
+					return;
+				}
+			}
+			pointer new_start = allocate_storage(len);
+			try
+			{
+				_alloc.construct(new_start + old_size, value);
+			}
+			catch (...)
+			{
+				_alloc.deallocate(new_start, len);
+				throw;
+			}
+			try
+			{
+				construct_range(new_start, _start, _finish);
+			}
+			catch (...)
+			{
+				_alloc.destroy(new_start + old_size);
+				_alloc.deallocate(new_start, len);
+				throw;
+			}
+			_counters.copied(old_size * sizeof(value_type));
+
+			my_deallocate();
+			_start = new_start;
+			_finish = new_start + old_size + 1;
+			_end_storage = new_start + len;
+		}
+
 		size_type check_len(size_type n)
 		{
 			if (max_size() - capacity() < n)
 				throw std::length_error("insert error");
-			if (capacity() >= max_size() / 2)
-				return max_size();
-			return std::max(size() + n, capacity() * 2);
+			return growth_policy::next_capacity(capacity(), size() + n, max_size(), sizeof(value_type));
 		}
 
         template<typename InputIt>
@@ -715,8 +1162,8 @@ iterator erase( iterator first, iterator last )
                     if (elems_after > n)
                     {
                         _finish = construct_range(_finish, _finish - n, _finish);
-                        std::copy_backward(position.base(), old_finish - n, old_finish);
-                        std::copy(first, last, position);
+                        assign_backward(position.base(), old_finish - n, old_finish);
+                        assign_range(position.base(), first, last);
                     }
                     else
                     {
@@ -724,15 +1171,20 @@ iterator erase( iterator first, iterator last )
 						std::advance(mid, elems_after);
 						_finish = construct_range(_finish, mid, last);
 						_finish = construct_range(_finish, position.base(), old_finish);
-						std::copy(first, mid, position);
+						assign_range(position.base(), first, mid);
                     }
                 }
                 else
                 {
-					const size_type old_size = size();
-					size_type len = old_size + std::max(old_size, n);
-					check_len(len);
-					pointer new_start = _alloc.allocate(len);
+					const size_type len = check_len(n);
+					const size_type offset = position - begin();
+					if (reallocate_storage(len))
+					{
+						range_insert(begin() + offset, first, last, std::forward_iterator_tag());
+						return;
+					}
+					pointer new_start = allocate_storage(len);
+					_counters.copied(size() * sizeof(value_type));
 					pointer new_finish = new_start;
 					new_finish = construct_range(new_start, _start, position.base());
 					new_finish = construct_range(new_finish, first, last);
@@ -749,44 +1201,44 @@ iterator erase( iterator first, iterator last )
 
 	/* NON MEMBER FUNCTIONS*/
 
-	template <typename T, typename Alloc>
-	inline bool operator==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return (lhs.size() == rhs.size()) && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 	}
 
-	template <typename T, typename Alloc>
-	inline bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template <typename T, typename Alloc>
-	inline bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return !(lhs == rhs);
 	}
 	
-	template <typename T, typename Alloc>
-	inline bool operator>(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return rhs < lhs;
 	}
 
-	template <typename T, typename Alloc>
-	inline bool operator<=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return !(rhs < lhs);
 	}
 
-	template <typename T, typename Alloc>
-	inline bool operator>=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <typename T, typename Alloc, typename Growth>
+	inline bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return !(lhs < rhs);
 	}
 
-	template <typename T, typename Alloc>
-	inline void swap(vector<T, Alloc>& x, vector<T, Alloc>& y)
+	template <typename T, typename Alloc, typename Growth>
+	inline void swap(vector<T, Alloc, Growth>& x, vector<T, Alloc, Growth>& y)
 	{
 		x.swap(y);
 	}
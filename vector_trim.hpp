@@ -0,0 +1,175 @@
+#ifndef VECTOR_TRIM_HPP
+#define VECTOR_TRIM_HPP
+
+#include <cstddef>
+#include <pthread.h>
+
+#include "vector.hpp"
+
+/*
+* Process-wide trimming of idle vectors, opt-in.
+*
+* A long-running worker keeps the peak capacity of its vectors: clear() and
+* a few elements after a burst leave the whole buffer reserved. A vector
+* opts in with a trim_registration that lives next to it; then
+* trim_registry::instance().trim(threshold), called from time to time,
+* shrinks to fit the registered vectors whose unused capacity is at least
+* threshold bytes and that did not change (same size, same capacity) since
+* the previous call: a vector in use keeps its capacity.
+*
+* Works with any type that has size(), capacity(), shrink_to_fit() and
+* value_type: ft::vector, ft::small_vector, std::vector. The registry is
+* locked, the vectors are not: trim() must not run while another thread
+* uses one of them, as for any access to a vector.
+*/
+
+namespace ft {
+
+class trim_registry
+{
+	public:
+		typedef std::size_t		size_type;
+
+		/* the process-wide registry */
+		static trim_registry& instance()
+		{
+			static trim_registry registry;
+			return registry;
+		}
+
+		/*
+		* @brief -> shrinks the idle vectors with at least slack_threshold bytes
+		* of unused capacity.
+		* @return -> the bytes released.
+		*/
+		size_type trim(size_type slack_threshold)
+		{
+			size_type released = 0;
+
+			pthread_mutex_lock(&_mutex);
+			for (size_type i = 0; i < _entries.size(); ++i)
+			{
+				entry& e = _entries[i];
+				size_type size = e.size(e.object);
+				size_type capacity = e.capacity(e.object);
+				bool idle = size == e.last_size && capacity == e.last_capacity;
+				if (idle && (capacity - size) * e.element_size >= slack_threshold)
+				{
+					e.shrink(e.object);
+					released += (capacity - e.capacity(e.object)) * e.element_size;
+					capacity = e.capacity(e.object);
+				}
+				e.last_size = size;
+				e.last_capacity = capacity;
+			}
+			pthread_mutex_unlock(&_mutex);
+			return released;
+		}
+
+		/* vectors registered */
+		size_type size() const
+		{
+			pthread_mutex_lock(&_mutex);
+			size_type n = _entries.size();
+			pthread_mutex_unlock(&_mutex);
+			return n;
+		}
+
+		template <typename Vector>
+		void add(Vector* v)
+		{
+			entry e;
+			e.object = v;
+			e.size = &size_of<Vector>;
+			e.capacity = &capacity_of<Vector>;
+			e.shrink = &shrink<Vector>;
+			e.element_size = sizeof(typename Vector::value_type);
+			e.last_size = v->size();
+			e.last_capacity = v->capacity();
+			pthread_mutex_lock(&_mutex);
+			_entries.push_back(e);
+			pthread_mutex_unlock(&_mutex);
+		}
+
+		void remove(const void* v)
+		{
+			pthread_mutex_lock(&_mutex);
+			for (size_type i = 0; i < _entries.size(); ++i)
+			{
+				if (_entries[i].object == v)
+				{
+					_entries[i] = _entries.back();
+					_entries.pop_back();
+					break;
+				}
+			}
+			pthread_mutex_unlock(&_mutex);
+		}
+
+	private:
+		/* one registered vector, its type erased */
+		struct entry
+		{
+			void*		object;
+			size_type	(*size)(const void*);
+			size_type	(*capacity)(const void*);
+			void		(*shrink)(void*);
+			size_type	element_size;
+			size_type	last_size;			/* at the previous trim() */
+			size_type	last_capacity;
+		};
+
+		ft::vector<entry>		_entries;
+		mutable pthread_mutex_t	_mutex;
+
+		trim_registry() : _entries()
+		{
+			pthread_mutex_init(&_mutex, NULL);
+		}
+
+		~trim_registry()
+		{
+			pthread_mutex_destroy(&_mutex);
+		}
+
+		trim_registry(const trim_registry&);
+		trim_registry& operator=(const trim_registry&);
+
+		template <typename Vector>
+		static size_type size_of(const void* v) { return static_cast<const Vector*>(v)->size(); }
+
+		template <typename Vector>
+		static size_type capacity_of(const void* v) { return static_cast<const Vector*>(v)->capacity(); }
+
+		template <typename Vector>
+		static void shrink(void* v) { static_cast<Vector*>(v)->shrink_to_fit(); }
+};
+
+/*
+* Keeps a vector in trim_registry::instance() for its own lifetime: declare
+* it after the vector, so that it goes first.
+*/
+template <typename Vector>
+class trim_registration
+{
+	private:
+		Vector*		_vector;
+
+		trim_registration(const trim_registration&);
+		trim_registration& operator=(const trim_registration&);
+
+	public:
+		explicit trim_registration(Vector& v) : _vector(&v)
+		{
+			trim_registry::instance().add(_vector);
+		}
+
+		~trim_registration()
+		{
+			trim_registry::instance().remove(_vector);
+		}
+};
+
+} //namespace
+
+#endif